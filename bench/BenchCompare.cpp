@@ -0,0 +1,238 @@
+#include "BenchStatistics.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/**
+ * Compares two Google Benchmark JSON outputs (baseline and candidate) and flags significant slowdowns.
+ *
+ * Both runs should be made with --benchmark_repetitions so that every benchmark has several samples.
+ * For each benchmark the CPU times of the repetitions are compared with Welch's t-test, and the
+ * 1 - alpha confidence interval of the relative change is printed. A benchmark regresses when the candidate is
+ * slower by more than the threshold and the difference is significant. The exit code is 1 if any
+ * benchmark regressed, so the tool can gate a build.
+ *
+ * Usage: bench_compare <baseline.json> <candidate.json> [threshold=0.05] [alpha=0.05]
+ */
+
+namespace {
+
+// Minimal JSON reader, enough for the objects, arrays, strings and numbers Google Benchmark writes
+    class JsonReader {
+    private:
+        const std::string &_text;
+        std::size_t _pos = 0;
+
+        void skipSpace() {
+            while (_pos < _text.size() && std::isspace(static_cast<unsigned char>(_text[_pos]))) _pos++;
+        }
+
+        void expect(char c) {
+            skipSpace();
+            if (_pos >= _text.size() || _text[_pos] != c) {
+                throw std::runtime_error(std::string("Error: Expected '") + c + "' at offset " + std::to_string(_pos) + ".");
+            }
+            _pos++;
+        }
+
+        bool consume(char c) {
+            skipSpace();
+            if (_pos < _text.size() && _text[_pos] == c) {
+                _pos++;
+                return true;
+            }
+            return false;
+        }
+
+    public:
+        struct Value {
+            enum class Kind { Null, Bool, Number, String, Array, Object } kind = Kind::Null;
+            double number = 0.0;
+            std::string text;
+            std::vector<Value> items;
+            std::vector<std::pair<std::string, Value>> members;
+
+            [[nodiscard]] const Value *find(const std::string &key) const {
+                for (const auto &member : members) {
+                    if (member.first == key) return &member.second;
+                }
+                return nullptr;
+            }
+        };
+
+        explicit JsonReader(const std::string &text) : _text(text) {}
+
+        std::string readString() {
+            expect('"');
+            std::string out;
+            while (_pos < _text.size() && _text[_pos] != '"') {
+                char c = _text[_pos++];
+                if (c == '\\' && _pos < _text.size()) {
+                    char escaped = _text[_pos++];
+                    switch (escaped) {
+                        case 'n': out += '\n'; break;
+                        case 't': out += '\t'; break;
+                        case 'u': _pos += 4; out += '?'; break;
+                        default: out += escaped; break;
+                    }
+                } else {
+                    out += c;
+                }
+            }
+            expect('"');
+            return out;
+        }
+
+        Value read() {
+            Value value;
+            skipSpace();
+            if (_pos >= _text.size()) {
+                throw std::runtime_error("Error: Unexpected end of JSON.");
+            }
+            char c = _text[_pos];
+            if (c == '{') {
+                value.kind = Value::Kind::Object;
+                _pos++;
+                if (!consume('}')) {
+                    do {
+                        std::string key = readString();
+                        expect(':');
+                        value.members.emplace_back(key, read());
+                    } while (consume(','));
+                    expect('}');
+                }
+            } else if (c == '[') {
+                value.kind = Value::Kind::Array;
+                _pos++;
+                if (!consume(']')) {
+                    do {
+                        value.items.push_back(read());
+                    } while (consume(','));
+                    expect(']');
+                }
+            } else if (c == '"') {
+                value.kind = Value::Kind::String;
+                value.text = readString();
+            } else if (_text.compare(_pos, 4, "true") == 0 || _text.compare(_pos, 5, "false") == 0) {
+                value.kind = Value::Kind::Bool;
+                value.number = _text[_pos] == 't';
+                _pos += _text[_pos] == 't' ? 4 : 5;
+            } else if (_text.compare(_pos, 4, "null") == 0) {
+                _pos += 4;
+            } else {
+                value.kind = Value::Kind::Number;
+                char *end = nullptr;
+                value.number = std::strtod(_text.c_str() + _pos, &end);
+                if (end == _text.c_str() + _pos) {
+                    throw std::runtime_error("Error: Invalid JSON value at offset " + std::to_string(_pos) + ".");
+                }
+                _pos = static_cast<std::size_t>(end - _text.c_str());
+            }
+            return value;
+        }
+    };
+
+// Nanoseconds per unit of a benchmark's time_unit field
+    double toNanoseconds(const std::string &unit) {
+        if (unit == "us") return 1e3;
+        if (unit == "ms") return 1e6;
+        if (unit == "s") return 1e9;
+        return 1.0;
+    }
+
+// Collect the CPU time of every repetition, in nanoseconds, by benchmark name
+    std::map<std::string, std::vector<double>> loadSamples(const std::string &path) {
+        std::ifstream file(path);
+        if (!file) {
+            throw std::runtime_error("Error: Cannot open " + path + ".");
+        }
+        std::stringstream buffer;
+        buffer << file.rdbuf();
+        std::string text = buffer.str();
+        JsonReader::Value root = JsonReader(text).read();
+        const JsonReader::Value *benchmarks = root.find("benchmarks");
+        if (!benchmarks) {
+            throw std::runtime_error("Error: " + path + " is not a Google Benchmark JSON output.");
+        }
+
+        std::map<std::string, std::vector<double>> samples;
+        for (const JsonReader::Value &entry : benchmarks->items) {
+            const JsonReader::Value *runType = entry.find("run_type");
+            if (runType && runType->text != "iteration") {
+                continue; // mean/median/stddev rows are recomputed from the repetitions
+            }
+            const JsonReader::Value *name = entry.find("run_name");
+            if (!name) name = entry.find("name");
+            const JsonReader::Value *cpu = entry.find("cpu_time");
+            const JsonReader::Value *unit = entry.find("time_unit");
+            if (name && cpu) {
+                samples[name->text].push_back(cpu->number * toNanoseconds(unit ? unit->text : "ns"));
+            }
+        }
+        return samples;
+    }
+
+} // namespace
+
+using namespace strategy;
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::cerr << "Usage: " << argv[0] << " <baseline.json> <candidate.json> [threshold=0.05] [alpha=0.05]" << std::endl;
+        return 2;
+    }
+    const double threshold = argc > 3 ? std::atof(argv[3]) : 0.05;
+    const double alpha = argc > 4 ? std::atof(argv[4]) : 0.05;
+
+    std::map<std::string, std::vector<double>> baseline, candidate;
+    try {
+        baseline = loadSamples(argv[1]);
+        candidate = loadSamples(argv[2]);
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 2;
+    }
+
+    int regressions = 0;
+    std::ostringstream level;
+    level << std::defaultfloat << 100.0 * (1.0 - alpha) << "% CI";
+    std::cout << std::left << std::setw(36) << "Benchmark" << std::right << std::setw(14) << "Baseline ns"
+              << std::setw(14) << "Candidate ns" << std::setw(10) << "Change" << std::setw(24) << level.str() << std::setw(10)
+              << "p" << "  Verdict" << std::endl;
+    std::cout << std::fixed;
+
+    for (const auto &entry : baseline) {
+        auto match = candidate.find(entry.first);
+        if (match == candidate.end()) {
+            continue;
+        }
+        const BenchComparison comparison = compareBenchmarks(entry.second, match->second, threshold, alpha);
+        const char *verdict = "same";
+        switch (comparison.verdict) {
+            case BenchVerdict::Slower: verdict = "SLOWER"; regressions++; break;
+            case BenchVerdict::Faster: verdict = "faster"; break;
+            case BenchVerdict::NeedRepetitions: verdict = "need repetitions"; break;
+            case BenchVerdict::Same: break;
+        }
+
+        std::ostringstream interval;
+        interval << std::fixed << std::setprecision(1) << "[" << 100.0 * comparison.low << "%, "
+                 << 100.0 * comparison.high << "%]";
+        std::cout << std::left << std::setw(36) << entry.first << std::right << std::setprecision(1) << std::setw(14)
+                  << comparison.baselineMean << std::setw(14) << comparison.candidateMean << std::setw(9)
+                  << 100.0 * comparison.change << "%" << std::setw(24) << interval.str() << std::setprecision(4)
+                  << std::setw(10) << comparison.p << "  " << verdict << std::endl;
+    }
+
+    std::cout << (regressions ? std::to_string(regressions) + " benchmark(s) regressed." : "No regressions.") << std::endl;
+    return regressions ? 1 : 0;
+}
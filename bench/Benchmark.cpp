@@ -0,0 +1,342 @@
+#include <benchmark/benchmark.h>
+#include <memory>
+#include "GameBoard.hpp"
+#include "GameLog.hpp"
+#include "GameOperator.hpp"
+#include "GameSimulator.hpp"
+#include "GameSnapshot.hpp"
+#include "PlacementSolver.hpp"
+#include "Player.hpp"
+#include "ProductionBatch.hpp"
+#include "SpectatorWall.hpp"
+#include "StateDelta.hpp"
+#include <random>
+
+using namespace game;
+using namespace strategy;
+
+// Micro-benchmarks for the engine's hot paths.
+// Run with --benchmark_format=json (the Makfile's bench target does) to track regressions.
+
+// Building the 54 nodes, 72 pathways and 19 terrains of a board
+static void BM_GameBoardConstruction(benchmark::State &state) {
+    for (auto _ : state) {
+        GameBoard board;
+        benchmark::DoNotOptimize(&board);
+    }
+}
+BENCHMARK(BM_GameBoardConstruction);
+
+// Resource production of a roll on a board where every player has two settlements
+static void BM_RollProduction(benchmark::State &state) {
+    GameSimulator simulator(1);
+    simulator.playSetup();
+    int die = 0;
+    for (auto _ : state) {
+        for (int seat = 0; seat < 3; ++seat) {
+            Player &player = simulator.getPlayer(seat);
+            if (player.isTurnActive()) {
+                // Cycle through every roll except the 7, which would discard instead of produce
+                int die1 = die % 6 + 1, die2 = (die / 6) % 6 + 1;
+                die++;
+                if (die1 + die2 == 7) {
+                    die2 = die2 % 6 + 1;
+                }
+                benchmark::DoNotOptimize(player.rollDiceAndMove(die1, die2));
+                break;
+            }
+        }
+
+        // Return the production every few rolls so the bank never runs dry; pausing the timer on
+        // every roll would cost more than the roll itself, so the refund is timed but amortized
+        if (die % 12 == 0) {
+            for (int seat = 0; seat < 3; ++seat) {
+                Player &player = simulator.getPlayer(seat);
+                if (player.countResourceCards() > 20) {
+                    player.discardHalf();
+                }
+            }
+        }
+    }
+}
+BENCHMARK(BM_RollProduction);
+
+// Ranking the opening placements of the first pick, by number of search threads
+static void BM_PlacementSearch(benchmark::State &state) {
+    GameBoard board;
+    PlacementOptions options;
+    options.threadCount = static_cast<unsigned>(state.range(0));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(PlacementSolver(board, 3, options).rank(0));
+    }
+}
+BENCHMARK(BM_PlacementSearch)->Arg(1)->Arg(4)->UseRealTime();
+
+// Random rolls and a board with four settlements and two cities per player, for the production kernels
+static std::vector<std::uint8_t> randomRolls(std::size_t games) {
+    std::mt19937 rng(38);
+    std::vector<std::uint8_t> rolls(games);
+    for (auto &roll : rolls) {
+        roll = static_cast<std::uint8_t>(rng() % 6 + rng() % 6 + 2);
+    }
+    return rolls;
+}
+
+static void fillBuildings(ProductionBatch &batch, std::vector<ProductionTable> *tables) {
+    std::mt19937 rng(37);
+    for (std::size_t g = 0; g < batch.games(); ++g) {
+        for (int i = 0; i < 18; ++i) {
+            std::size_t node = rng() % BoardGraph::MAX_NODES;
+            int seat = i % 3, yield = i % 6 < 4 ? 1 : 2;
+            batch.setBuilding(g, node, seat, yield);
+            if (tables) {
+                (*tables)[g].setBuilding(node, seat, yield);
+            }
+        }
+    }
+}
+
+// Production of one roll in each of many games, one production table at a time
+static void BM_PerGameProduction(benchmark::State &state) {
+    GameBoard board;
+    auto games = static_cast<std::size_t>(state.range(0));
+    ProductionBatch batch(board, games, 3);
+    std::vector<ProductionTable> tables(games, board.getProduction());
+    fillBuildings(batch, &tables);
+    std::vector<std::uint8_t> rolls = randomRolls(games);
+    std::array<ResourceCounts, 3> gains{};
+    for (auto _ : state) {
+        for (std::size_t g = 0; g < games; ++g) {
+            tables[g].produce(rolls[g], gains);
+            benchmark::DoNotOptimize(gains);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t) games);
+}
+BENCHMARK(BM_PerGameProduction)->Arg(4096);
+
+// The same rolls through the batched kernel; arg 1 is 0 for scalar and 1 for AVX2
+static void BM_BatchedProduction(benchmark::State &state) {
+    GameBoard board;
+    auto games = static_cast<std::size_t>(state.range(0));
+    ProductionBatch batch(board, games, 3);
+    fillBuildings(batch, nullptr);
+    std::vector<std::uint8_t> rolls = randomRolls(games);
+    std::vector<std::uint8_t> deltas(batch.deltaSize());
+    ProductionKernel kernel = state.range(1) ? ProductionKernel::Avx2 : ProductionKernel::Scalar;
+    for (auto _ : state) {
+        batch.produce(rolls, deltas, kernel);
+        benchmark::DoNotOptimize(deltas.data());
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t) games);
+}
+BENCHMARK(BM_BatchedProduction)->Args({4096, 0})->Args({4096, 1});
+
+// A spectator wall frame in which every board moved its robber, the worst case of refresh()
+static void BM_SpectatorWallRefresh(benchmark::State &state) {
+    auto boards = static_cast<std::size_t>(state.range(0));
+    std::vector<std::unique_ptr<GameBoard>> games;
+    std::vector<std::unique_ptr<BoardFeed>> feeds;
+    std::vector<BoardFeed *> wallFeeds;
+    for (std::size_t g = 0; g < boards; ++g) {
+        games.push_back(std::make_unique<GameBoard>());
+        feeds.push_back(std::make_unique<BoardFeed>(*games.back()));
+        wallFeeds.push_back(feeds.back().get());
+    }
+    SpectatorWall wall(games[0]->getGraph(), wallFeeds);
+    int robber = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        robber = (robber + 1) % 19;
+        for (auto &game : games) {
+            game->moveRobber(robber);
+        }
+        state.ResumeTiming();
+        benchmark::DoNotOptimize(wall.refresh().size());
+    }
+    state.SetItemsProcessed(state.iterations() * (int64_t) boards);
+}
+BENCHMARK(BM_SpectatorWallRefresh)->Arg(64)->Arg(256);
+
+// Legality checks of every settlement and road spot, as a bot scanning its options does
+static void BM_LegalityChecks(benchmark::State &state) {
+    GameSimulator simulator(1);
+    simulator.playSetup();
+    Player &player = simulator.getPlayer(0);
+    BrickCard brick;
+    GrainCard grain;
+    LumberCard lumber;
+    WoolCard wool;
+    for (int i = 0; i < 5; ++i) {
+        player.receiveTwoResourceCards(&brick);
+        player.receiveTwoResourceCards(&grain);
+        player.receiveTwoResourceCards(&lumber);
+        player.receiveTwoResourceCards(&wool);
+    }
+    for (auto _ : state) {
+        int legal = 0;
+        for (int node = 1; node <= 54; ++node) {
+            legal += player.canBuildSettlement(node);
+        }
+        for (int pathway = 1; pathway <= 72; ++pathway) {
+            legal += player.canBuildPathway(pathway);
+        }
+        benchmark::DoNotOptimize(legal);
+    }
+    state.SetItemsProcessed(state.iterations() * (54 + 72));
+}
+BENCHMARK(BM_LegalityChecks);
+
+// Drawing a random card from the development card deck
+static void BM_DrawRandomDevCard(benchmark::State &state) {
+    auto board = std::make_unique<GameBoard>();
+    board->seedRandom(1);
+    for (auto _ : state) {
+        DevelopmentCard *card = board->drawRandomDevCard();
+        if (!card) {
+            state.PauseTiming();
+            board = std::make_unique<GameBoard>();
+            board->seedRandom(1);
+            state.ResumeTiming();
+            continue;
+        }
+        benchmark::DoNotOptimize(card);
+        delete card;
+    }
+}
+BENCHMARK(BM_DrawRandomDevCard);
+
+// A one-for-one trade between two players, swapped back and forth
+static void BM_ConductTrade(benchmark::State &state) {
+    GameBoard board;
+    Player player1("Amit"), player2("Omer"), player3("Nir");
+    player1.assignGameBoard(&board);
+    player2.assignGameBoard(&board);
+    player3.assignGameBoard(&board);
+    GameOperator gameOperator;
+    gameOperator.setPlayers(&player1, &player2, &player3);
+    gameOperator.initiateGame();
+    BrickCard brick;
+    OreCard ore;
+    player1.obtainResourceCard(&brick);
+    player2.obtainResourceCard(&ore);
+
+    for (auto _ : state) {
+        player1.conductTrade(&player2, "Brick", "Ore", 1, 1);
+        player1.conductTrade(&player2, "Ore", "Brick", 1, 1);
+    }
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_ConductTrade);
+
+// A complete game between the greedy bots of the simulator
+static void BM_FullGameSimulation(benchmark::State &state) {
+    std::uint64_t seed = 0;
+    std::int64_t turns = 0;
+    for (auto _ : state) {
+        GameSimulator simulator(++seed);
+        turns += simulator.play(static_cast<int>(state.range(0))).turns;
+    }
+    state.counters["turns_per_game"] = benchmark::Counter(static_cast<double>(turns) / static_cast<double>(state.iterations()));
+    state.SetItemsProcessed(turns);
+}
+BENCHMARK(BM_FullGameSimulation)->Arg(500)->Unit(benchmark::kMillisecond);
+
+// The state after every action of a simulated game, as a client following its deltas sees it
+static std::vector<GameState> gameStates() {
+    GameSimulator simulator(9);
+    DeltaStream stream(simulator.getBoard());
+    simulator.play(500);
+    std::vector<GameState> states{stream.initial()};
+    const std::uint8_t *pos = stream.bytes().data();
+    const std::uint8_t *end = pos + stream.bytes().size();
+    for (GameState state = stream.initial(); applyDelta(pos, end, state);) {
+        states.push_back(state);
+    }
+    return states;
+}
+
+// Encoding the delta record of every action of a game; bytes are the records written
+static void BM_EncodeDeltas(benchmark::State &state) {
+    const std::vector<GameState> states = gameStates();
+    std::vector<std::uint8_t> bytes;
+    bytes.reserve(states.size() * 16);
+    std::int64_t written = 0;
+    for (auto _ : state) {
+        bytes.clear();
+        for (std::size_t i = 1; i < states.size(); ++i) {
+            encodeDelta(states[i - 1], states[i], bytes);
+        }
+        benchmark::DoNotOptimize(bytes.data());
+        written += static_cast<std::int64_t>(bytes.size());
+    }
+    state.SetBytesProcessed(written);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(states.size() - 1));
+}
+BENCHMARK(BM_EncodeDeltas);
+
+// Applying the delta records of a game to the state it started from
+static void BM_ApplyDeltas(benchmark::State &state) {
+    const std::vector<GameState> states = gameStates();
+    std::vector<std::uint8_t> bytes;
+    for (std::size_t i = 1; i < states.size(); ++i) {
+        encodeDelta(states[i - 1], states[i], bytes);
+    }
+    std::int64_t records = 0;
+    for (auto _ : state) {
+        GameState current = states.front();
+        const std::uint8_t *pos = bytes.data();
+        while (applyDelta(pos, bytes.data() + bytes.size(), current)) {
+            records++;
+        }
+        benchmark::DoNotOptimize(current);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(bytes.size()));
+    state.SetItemsProcessed(records);
+}
+BENCHMARK(BM_ApplyDeltas);
+
+// Capturing and sealing a snapshot of a game in progress
+static void BM_CheckpointGame(benchmark::State &state) {
+    GameSimulator simulator(9);
+    simulator.play(40);
+    GameSnapshot snapshot;
+    for (auto _ : state) {
+        simulator.checkpoint(snapshot);
+        benchmark::DoNotOptimize(snapshot);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(sizeof(GameSnapshot)));
+}
+BENCHMARK(BM_CheckpointGame);
+
+// Checking a snapshot image and restoring it on a fresh simulator; building the simulator is not timed
+static void BM_RestoreSnapshot(benchmark::State &state) {
+    GameSimulator simulator(9);
+    simulator.play(40);
+    GameSnapshot snapshot;
+    simulator.checkpoint(snapshot);
+    const auto *bytes = reinterpret_cast<const std::uint8_t *>(&snapshot);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto fresh = std::make_unique<GameSimulator>(9);
+        state.ResumeTiming();
+        fresh->restore(viewSnapshot({bytes, sizeof(GameSnapshot)}));
+        benchmark::DoNotOptimize(fresh.get());
+        state.PauseTiming();
+        fresh.reset();
+        state.ResumeTiming();
+    }
+}
+BENCHMARK(BM_RestoreSnapshot);
+
+int main(int argc, char **argv) {
+    // The play-by-play messages would dominate every measurement
+    setGameLogEnabled(false);
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,82 @@
+#ifndef BANK_HPP
+#define BANK_HPP
+
+#include "ResourceType.hpp"
+
+namespace strategy {
+
+/**
+ * @class Bank
+ * @brief Holds the finite supply of resource cards that are not in any player's hand.
+ *
+ * Production draws cards from the bank and spent cards are returned to it. When the
+ * bank runs out of a resource, no more cards of that resource can be handed out until
+ * some are returned.
+ */
+    class Bank {
+    private:
+        ResourceCounts _supply; ///< Cards of each resource currently held by the bank.
+
+    public:
+        static constexpr int CARDS_PER_RESOURCE = 19; ///< Size of the supply of each resource in a standard game.
+        static constexpr int BANK_TRADE_RATIO = 4;    ///< Cards given per card received without a harbor.
+        static constexpr int GENERIC_HARBOR_RATIO = 3; ///< Cards given per card received at a generic harbor.
+        static constexpr int RESOURCE_HARBOR_RATIO = 2; ///< Cards given per card received at a resource harbor.
+
+        /**
+         * @brief Constructor filling the bank with the standard supply of every resource.
+         */
+        Bank();
+
+        /**
+         * @brief Get the number of cards of a resource left in the bank.
+         * @param type The resource type.
+         * @return The remaining supply.
+         */
+        [[nodiscard]] int supply(ResourceType type) const;
+
+        /**
+         * @brief Get the supply of every resource.
+         * @return The remaining supply, indexed by resource type.
+         */
+        [[nodiscard]] const ResourceCounts &getSupply() const;
+
+        /**
+         * @brief Check whether the bank can hand out the given cards.
+         * @param cards The cards requested.
+         * @return True if the supply covers the request.
+         */
+        [[nodiscard]] bool canWithdraw(const ResourceCounts &cards) const;
+
+        /**
+         * @brief Take cards out of the bank.
+         * @param type The resource type.
+         * @param amount The number of cards requested.
+         * @return The number of cards actually handed out, limited by the supply.
+         */
+        int withdraw(ResourceType type, int amount);
+
+        /**
+         * @brief Take a set of cards out of the bank, all or nothing.
+         * @param cards The cards requested.
+         * @return True if the cards were handed out, false if the supply was insufficient.
+         */
+        bool withdraw(const ResourceCounts &cards);
+
+        /**
+         * @brief Return cards to the bank.
+         * @param cards The cards returned.
+         */
+        void deposit(const ResourceCounts &cards);
+
+        /**
+         * @brief Return cards of a single resource to the bank.
+         * @param type The resource type.
+         * @param amount The number of cards returned.
+         */
+        void deposit(ResourceType type, int amount);
+    };
+
+} // namespace strategy
+
+#endif // BANK_HPP
@@ -0,0 +1,65 @@
+#ifndef BENCH_STATISTICS_HPP
+#define BENCH_STATISTICS_HPP
+
+#include <cstdint>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @enum BenchVerdict
+ * @brief How a candidate benchmark run compares to its baseline.
+ */
+    enum class BenchVerdict : std::uint8_t {
+        Same,           ///< No significant change beyond the threshold.
+        Slower,         ///< Significantly slower by more than the threshold.
+        Faster,         ///< Significantly faster by more than the threshold.
+        NeedRepetitions ///< Fewer than two samples on a side; nothing can be concluded.
+    };
+
+/**
+ * @struct BenchComparison
+ * @brief The comparison of the repetitions of one benchmark in two runs.
+ */
+    struct BenchComparison {
+        double baselineMean = 0.0;  ///< Mean time of the baseline.
+        double candidateMean = 0.0; ///< Mean time of the candidate.
+        double change = 0.0;        ///< Relative change of the mean, positive when slower.
+        double low = 0.0;           ///< Lower bound of the confidence interval of the change, relative.
+        double high = 0.0;          ///< Upper bound of the confidence interval of the change, relative.
+        double p = 1.0;             ///< Two-sided p-value of Welch's t-test.
+        BenchVerdict verdict = BenchVerdict::NeedRepetitions; ///< The conclusion.
+    };
+
+/**
+ * @brief Get the two-sided p-value of a t statistic.
+ * @param t The statistic.
+ * @param degreesOfFreedom The degrees of freedom of Student's t distribution.
+ */
+    double twoSidedPValue(double t, double degreesOfFreedom);
+
+/**
+ * @brief Get the critical value of Student's t distribution for a two-sided test.
+ * @param alpha The significance level; the confidence interval covers 1 - alpha.
+ * @param degreesOfFreedom The degrees of freedom.
+ */
+    double criticalValue(double alpha, double degreesOfFreedom);
+
+/**
+ * @brief Compare two sets of benchmark times with Welch's t-test.
+ *
+ * The change is significant when p < alpha, and the confidence interval is the 1 - alpha one,
+ * so both follow the same level.
+ *
+ * @param baseline Times of the baseline repetitions.
+ * @param candidate Times of the candidate repetitions.
+ * @param threshold Smallest relative change that counts as slower or faster.
+ * @param alpha Significance level.
+ * @return The comparison.
+ */
+    BenchComparison compareBenchmarks(const std::vector<double> &baseline, const std::vector<double> &candidate,
+                                      double threshold, double alpha);
+
+} // namespace strategy
+
+#endif // BENCH_STATISTICS_HPP
@@ -0,0 +1,160 @@
+#ifndef BOARD_GRAPH_HPP
+#define BOARD_GRAPH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace strategy {
+
+    class Node;
+    class Pathway;
+    class Terrain;
+
+/**
+ * @class IndexRange
+ * @brief A read-only view of consecutive 8-bit board indices.
+ */
+    class IndexRange {
+    private:
+        const std::uint8_t *_first = nullptr;
+        const std::uint8_t *_last = nullptr;
+
+    public:
+        IndexRange() = default;
+        IndexRange(const std::uint8_t *first, const std::uint8_t *last) : _first(first), _last(last) {}
+
+        [[nodiscard]] const std::uint8_t *begin() const { return _first; }
+        [[nodiscard]] const std::uint8_t *end() const { return _last; }
+        [[nodiscard]] std::size_t size() const { return static_cast<std::size_t>(_last - _first); }
+        [[nodiscard]] bool empty() const { return _first == _last; }
+        std::uint8_t operator[](std::size_t i) const { return _first[i]; }
+    };
+
+/**
+ * @class GraphRange
+ * @brief A read-only view of board objects, stored as 8-bit indices into an object table.
+ *
+ * Iterating yields T* without copying anything; the view stays valid as long as the board.
+ *
+ * @tparam T Node, Pathway or Terrain.
+ */
+    template<typename T>
+    class GraphRange {
+    private:
+        IndexRange _indices;
+        T *const *_table = nullptr;
+
+    public:
+        class iterator {
+        private:
+            const std::uint8_t *_pos;
+            T *const *_table;
+
+        public:
+            iterator(const std::uint8_t *pos, T *const *table) : _pos(pos), _table(table) {}
+            T *operator*() const { return _table[*_pos]; }
+            iterator &operator++() {
+                ++_pos;
+                return *this;
+            }
+            bool operator==(const iterator &other) const { return _pos == other._pos; }
+            bool operator!=(const iterator &other) const { return _pos != other._pos; }
+        };
+
+        GraphRange() = default;
+        GraphRange(IndexRange indices, T *const *table) : _indices(indices), _table(table) {}
+
+        [[nodiscard]] iterator begin() const { return {_indices.begin(), _table}; }
+        [[nodiscard]] iterator end() const { return {_indices.end(), _table}; }
+        [[nodiscard]] std::size_t size() const { return _indices.size(); }
+        [[nodiscard]] bool empty() const { return _indices.empty(); }
+        T *operator[](std::size_t i) const { return _table[_indices[i]]; }
+    };
+
+/**
+ * @class BoardGraph
+ * @brief The adjacency of the board in compressed-sparse-row form, with 8-bit indices.
+ *
+ * Nodes, pathways and terrains are indexed by their position on the board (node and pathway
+ * ids minus one). Each relation (node to pathways, node to neighbor nodes, node to terrains,
+ * terrain to nodes) is an offsets array and a flat index array, under a kilobyte in total,
+ * so traversals stay in cache. Node, Pathway and Terrain read their adjacency from here.
+ */
+    class BoardGraph {
+    public:
+        static constexpr std::size_t MAX_NODES = 54;     ///< Nodes on the board.
+        static constexpr std::size_t MAX_PATHWAYS = 72;  ///< Pathways on the board.
+        static constexpr std::size_t MAX_TERRAINS = 19;  ///< Terrains on the board.
+        static constexpr std::size_t NODE_DEGREE = 3;    ///< Most pathways, neighbors or terrains of a node.
+        static constexpr std::size_t TERRAIN_DEGREE = 6; ///< Most nodes of a terrain.
+
+    private:
+        template<std::size_t Rows, std::size_t Capacity>
+        struct Csr {
+            std::array<std::uint8_t, Rows + 1> offsets{};
+            std::array<std::uint8_t, Capacity> indices{};
+
+            [[nodiscard]] IndexRange row(std::size_t r) const {
+                return {indices.data() + offsets[r], indices.data() + offsets[r + 1]};
+            }
+        };
+
+        Csr<MAX_NODES, MAX_NODES * NODE_DEGREE> _nodePathways;        ///< Node to incident pathways.
+        Csr<MAX_NODES, MAX_NODES * NODE_DEGREE> _nodeNeighbors;       ///< Node to adjacent nodes.
+        Csr<MAX_NODES, MAX_NODES * NODE_DEGREE> _nodeTerrains;        ///< Node to surrounding terrains.
+        Csr<MAX_TERRAINS, MAX_TERRAINS * TERRAIN_DEGREE> _terrainNodes; ///< Terrain to its corner nodes.
+        std::array<std::array<std::uint8_t, 2>, MAX_PATHWAYS> _pathwayNodes{}; ///< Pathway to its two end nodes.
+        Node *const *_nodeTable = nullptr;       ///< Node objects by index.
+        Pathway *const *_pathwayTable = nullptr; ///< Pathway objects by index.
+        Terrain *const *_terrainTable = nullptr; ///< Terrain objects by index.
+        std::size_t _nodeCount = 0, _pathwayCount = 0, _terrainCount = 0;
+
+    public:
+        /**
+         * @brief Index table {0, 1, ..., 255}, used to view a plain pointer array as a GraphRange.
+         */
+        static const std::array<std::uint8_t, 256> IDENTITY;
+
+        /**
+         * @brief Compile the adjacency recorded on the board objects and bind the objects to the graph.
+         *
+         * Afterwards the objects answer adjacency queries from the graph and drop their own lists.
+         * The vectors must not be resized while the graph is in use.
+         *
+         * @param nodes The nodes, in id order.
+         * @param pathways The pathways, in id order.
+         * @param terrains The terrains, in board order.
+         * @throws std::logic_error if the board is larger than the graph supports or refers to unknown objects.
+         */
+        void build(const std::vector<Node *> &nodes, const std::vector<Pathway *> &pathways, const std::vector<Terrain *> &terrains);
+
+        [[nodiscard]] std::size_t nodeCount() const { return _nodeCount; }
+        [[nodiscard]] std::size_t pathwayCount() const { return _pathwayCount; }
+        [[nodiscard]] std::size_t terrainCount() const { return _terrainCount; }
+
+        /// Indices of the pathways incident to a node.
+        [[nodiscard]] IndexRange nodePathwayIndices(std::size_t node) const { return _nodePathways.row(node); }
+        /// Indices of the nodes adjacent to a node.
+        [[nodiscard]] IndexRange nodeNeighborIndices(std::size_t node) const { return _nodeNeighbors.row(node); }
+        /// Indices of the terrains around a node.
+        [[nodiscard]] IndexRange nodeTerrainIndices(std::size_t node) const { return _nodeTerrains.row(node); }
+        /// Indices of the nodes on the corners of a terrain.
+        [[nodiscard]] IndexRange terrainNodeIndices(std::size_t terrain) const { return _terrainNodes.row(terrain); }
+        /// Indices of the two end nodes of a pathway.
+        [[nodiscard]] const std::array<std::uint8_t, 2> &pathwayNodeIndices(std::size_t pathway) const { return _pathwayNodes[pathway]; }
+
+        /// The pathways incident to a node.
+        [[nodiscard]] GraphRange<Pathway> nodePathways(std::size_t node) const { return {nodePathwayIndices(node), _pathwayTable}; }
+        /// The nodes adjacent to a node.
+        [[nodiscard]] GraphRange<Node> nodeNeighbors(std::size_t node) const { return {nodeNeighborIndices(node), _nodeTable}; }
+        /// The terrains around a node.
+        [[nodiscard]] GraphRange<Terrain> nodeTerrains(std::size_t node) const { return {nodeTerrainIndices(node), _terrainTable}; }
+        /// The nodes on the corners of a terrain.
+        [[nodiscard]] GraphRange<Node> terrainNodes(std::size_t terrain) const { return {terrainNodeIndices(terrain), _nodeTable}; }
+    };
+
+} // namespace strategy
+
+#endif // BOARD_GRAPH_HPP
@@ -0,0 +1,148 @@
+#ifndef BOARD_LAYOUT_HPP
+#define BOARD_LAYOUT_HPP
+
+#include "BoardGraph.hpp"
+#include "ResourceType.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @struct Point
+ * @brief A position in pixels, y pointing down.
+ */
+    struct Point {
+        float x = 0.0f;
+        float y = 0.0f;
+    };
+
+/**
+ * @struct Rgba
+ * @brief An 8-bit color with alpha.
+ */
+    struct Rgba {
+        std::uint8_t r = 0;
+        std::uint8_t g = 0;
+        std::uint8_t b = 0;
+        std::uint8_t a = 255;
+
+        bool operator==(const Rgba &other) const = default;
+    };
+
+/**
+ * @brief Get the fill color of a terrain.
+ * @param type The resource of the terrain; None is the desert.
+ */
+    const Rgba &resourceColor(ResourceType type);
+
+/**
+ * @brief Get the color of a player's pieces.
+ * @param seat The seat of the player; seats past the eighth reuse the colors.
+ */
+    const Rgba &playerColor(int seat);
+
+/**
+ * @class BoardLayout
+ * @brief Where the terrains of the board are drawn in an image of a given size.
+ *
+ * The 19 terrains are hexagons with a corner on top, in rows of 3, 4, 5, 4 and 3 taken in
+ * board order, and the board is scaled to fit and centered in the image. Both the window
+ * and the headless renderer draw from the same layout.
+ *
+ * Given the board graph, the layout also places every node on a corner of its terrains and
+ * every pathway between its two nodes, once, so pieces are drawn from a table. A node goes
+ * on the corner shared by the most of its terrains; ties between corners (on the coast) go
+ * to the corner one edge away from the most neighbors already placed. A node of which no
+ * corner is free is left at the center of the board.
+ */
+    class BoardLayout {
+    private:
+        float _radius;                              ///< Distance from the center of a hexagon to its corners.
+        Point _origin;                              ///< Center of the middle terrain.
+        std::vector<Point> _nodes;                  ///< Position of every node, by index.
+        std::vector<std::array<Point, 2>> _pathways; ///< Ends of every pathway, by index.
+
+        void placeNodes(const BoardGraph &graph);
+
+    public:
+        static constexpr std::array<int, 5> ROW_LENGTHS = {3, 4, 5, 4, 3}; ///< Terrains per row.
+        static constexpr std::size_t HEX_COUNT = 19;                       ///< Terrains on the board.
+
+        /**
+         * @brief Constructor fitting the board in an image.
+         * @param width Width of the image in pixels.
+         * @param height Height of the image in pixels.
+         */
+        BoardLayout(float width, float height);
+
+        /**
+         * @brief Constructor fitting the board in an image and placing its nodes and pathways.
+         * @param width Width of the image in pixels.
+         * @param height Height of the image in pixels.
+         * @param graph The adjacency of the board.
+         */
+        BoardLayout(float width, float height, const BoardGraph &graph);
+
+        /**
+         * @brief Get the distance from the center of a hexagon to its corners.
+         */
+        [[nodiscard]] float radius() const;
+
+        /**
+         * @brief Get the center of a terrain.
+         * @param index The position of the terrain, from 0.
+         * @throws std::out_of_range if the position is off the board.
+         */
+        [[nodiscard]] Point hexCenter(int index) const;
+
+        /**
+         * @brief Get a corner of a hexagon.
+         * @param center The center of the hexagon.
+         * @param radius The distance from the center to the corner.
+         * @param corner The corner, 0 on top and counting clockwise.
+         */
+        static Point hexCorner(Point center, float radius, int corner);
+
+        /**
+         * @brief Get the number of nodes placed; 0 if the layout was made without a graph.
+         */
+        [[nodiscard]] std::size_t nodeCount() const;
+
+        /**
+         * @brief Get the position of a node.
+         * @param index The index of the node (id minus one).
+         * @throws std::out_of_range if the node was not placed.
+         */
+        [[nodiscard]] Point nodePosition(std::size_t index) const;
+
+        /**
+         * @brief Get the positions of the two nodes of a pathway.
+         * @param index The index of the pathway (id minus one).
+         * @throws std::out_of_range if the pathway was not placed.
+         */
+        [[nodiscard]] const std::array<Point, 2> &pathwayEnds(std::size_t index) const;
+
+        /**
+         * @brief Get the corners of a road, a bar along a pathway stopping short of its nodes.
+         * @param index The index of the pathway.
+         * @param margin Distance added on every side, to draw an outline behind the road.
+         * @throws std::out_of_range if the pathway was not placed.
+         */
+        [[nodiscard]] std::array<Point, 4> roadShape(std::size_t index, float margin = 0.0f) const;
+
+        /**
+         * @brief Get the corners of a settlement or city, a house centered on a node.
+         * @param index The index of the node.
+         * @param city True for a city, which is drawn larger.
+         * @param margin Distance added on every side, to draw an outline behind the building.
+         * @throws std::out_of_range if the node was not placed.
+         */
+        [[nodiscard]] std::array<Point, 5> buildingShape(std::size_t index, bool city, float margin = 0.0f) const;
+    };
+
+} // namespace strategy
+
+#endif // BOARD_LAYOUT_HPP
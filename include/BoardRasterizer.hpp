@@ -0,0 +1,133 @@
+#ifndef BOARD_RASTERIZER_HPP
+#define BOARD_RASTERIZER_HPP
+
+#include "BoardLayout.hpp"
+#include "BoardView.hpp"
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @class RasterImage
+ * @brief An RGBA image in memory, with the few shapes the board renderer needs.
+ */
+    class RasterImage {
+    private:
+        int _width;                ///< Width in pixels.
+        int _height;               ///< Height in pixels.
+        std::vector<Rgba> _pixels; ///< Pixels, row by row from the top.
+
+    public:
+        /**
+         * @brief Constructor creating a transparent image.
+         * @param width Width in pixels.
+         * @param height Height in pixels.
+         * @throws std::invalid_argument if a dimension is not positive.
+         */
+        RasterImage(int width, int height);
+
+        [[nodiscard]] int width() const { return _width; }
+        [[nodiscard]] int height() const { return _height; }
+
+        /**
+         * @brief Get a pixel.
+         * @throws std::out_of_range if the pixel is outside the image.
+         */
+        [[nodiscard]] Rgba pixel(int x, int y) const;
+
+        /**
+         * @brief Paint the whole image.
+         */
+        void fill(Rgba color);
+
+        /**
+         * @brief Paint the pixels whose centers lie in a convex polygon.
+         * @param corners The corners, in order around the polygon.
+         * @param color The color.
+         */
+        void fillPolygon(std::span<const Point> corners, Rgba color);
+
+        /**
+         * @brief Paint the pixels whose centers lie in a circle.
+         */
+        void fillCircle(Point center, float radius, Rgba color);
+
+        /**
+         * @brief Encode the image as a PNG file.
+         * @return The bytes of the file.
+         */
+        [[nodiscard]] std::vector<std::uint8_t> encodePng() const;
+
+        /**
+         * @brief Write the image to a PNG file.
+         * @param path The path of the file, replaced if it exists.
+         * @throws std::runtime_error if the file cannot be written.
+         */
+        void savePng(const std::string &path) const;
+    };
+
+/**
+ * @struct RasterOptions
+ * @brief Settings of the headless board renderer.
+ */
+    struct RasterOptions {
+        int width = 800;          ///< Width of the images in pixels.
+        int height = 600;         ///< Height of the images in pixels.
+        unsigned threadCount = 0; ///< Worker threads of renderToFiles, or 0 for one per core.
+    };
+
+/**
+ * @class BoardRasterizer
+ * @brief Renders boards to images in software, without a window or a graphics context.
+ *
+ * Meant for batch reports, where thousands of final boards are written as PNG files on
+ * machines without a display. The terrains are drawn with the layout and colors of the
+ * BoardVisualizer, with the number tokens in a built-in bitmap font and the robber as a
+ * dark disc, then the roads and buildings in the colors of their owners. A rasterizer
+ * holds no mutable state, so one can render on several threads, each into its own image.
+ */
+    class BoardRasterizer {
+    private:
+        RasterOptions _options; ///< Settings.
+
+        void drawNumber(RasterImage &image, Point center, int number, float scale, Rgba color) const;
+
+    public:
+        /**
+         * @brief Constructor taking the settings.
+         * @param options Settings.
+         * @throws std::invalid_argument if the image size is not positive.
+         */
+        explicit BoardRasterizer(RasterOptions options = {});
+
+        /**
+         * @brief Draw a board over an image of the configured size.
+         * @param board The board.
+         * @param image The image to draw on.
+         * @throws std::invalid_argument if the image does not have the configured size.
+         */
+        void render(BoardView board, RasterImage &image) const;
+
+        /**
+         * @brief Draw a board into a new image.
+         * @param board The board.
+         * @return The image.
+         */
+        [[nodiscard]] RasterImage render(BoardView board) const;
+
+        /**
+         * @brief Render boards to PNG files on threadCount workers, each reusing one image.
+         * @param boards The boards; none may change while they are rendered.
+         * @param paths The file of every board.
+         * @throws std::invalid_argument if there are not as many paths as boards.
+         * @throws std::runtime_error if a file cannot be written.
+         */
+        void renderToFiles(std::span<const GameBoard *const> boards, std::span<const std::string> paths) const;
+    };
+
+} // namespace strategy
+
+#endif // BOARD_RASTERIZER_HPP
@@ -0,0 +1,109 @@
+#ifndef BOARD_SNAPSHOT_HPP
+#define BOARD_SNAPSHOT_HPP
+
+#include "BoardView.hpp"
+#include "GameAction.hpp"
+#include "TripleBuffer.hpp"
+#include <array>
+#include <cstdint>
+
+namespace strategy {
+
+/**
+ * @struct BoardSnapshot
+ * @brief A fixed-size copy of everything drawn on a board, safe to hand to another thread.
+ */
+    struct BoardSnapshot {
+        static constexpr std::uint8_t CITY = 0x80; ///< Flag of a building entry holding a city.
+
+        std::uint64_t version = 0;                                  ///< Number of changes published before this one.
+        std::int8_t robber = -1;                                    ///< Terrain holding the robber.
+        std::array<std::uint8_t, BoardGraph::MAX_TERRAINS> resources{}; ///< ResourceType of every terrain.
+        std::array<std::uint8_t, BoardGraph::MAX_TERRAINS> numbers{};   ///< Number token of every terrain.
+        std::array<std::uint8_t, BoardGraph::MAX_NODES> buildings{};    ///< Owner's seat + 1 of every node, ored with CITY, or 0.
+        std::array<std::uint8_t, BoardGraph::MAX_PATHWAYS> roads{};     ///< Owner's seat + 1 of every pathway, or 0.
+
+        /**
+         * @brief Get the seat owning the building on a node, or -1.
+         */
+        [[nodiscard]] int buildingSeat(std::size_t node) const { return (buildings[node] & ~CITY) - 1; }
+
+        /**
+         * @brief Check whether the building on a node is a city.
+         */
+        [[nodiscard]] bool isCity(std::size_t node) const { return (buildings[node] & CITY) != 0; }
+
+        /**
+         * @brief Get the seat owning the road on a pathway, or -1.
+         */
+        [[nodiscard]] int roadSeat(std::size_t pathway) const { return roads[pathway] - 1; }
+
+        bool operator==(const BoardSnapshot &other) const = default;
+    };
+
+/**
+ * @brief Copy the terrains, robber, buildings and roads of a board.
+ * @param board The board.
+ * @param snapshot Output; everything but the version is overwritten.
+ */
+    void captureSnapshot(BoardView board, BoardSnapshot &snapshot);
+
+/**
+ * @class BoardFeed
+ * @brief Publishes snapshots of a board being played on one thread to a reader on another.
+ *
+ * The feed observes the board: every settlement, city, road and robber move is applied to a
+ * working snapshot on the game's thread and published through a TripleBuffer. A reader such
+ * as the spectator wall polls the feed from its own thread and never blocks the game.
+ * Create and destroy the feed while the game is not running, since both touch the board's
+ * observers.
+ */
+    class BoardFeed : public GameObserver {
+    private:
+        GameBoard &_board;                    ///< The board being published.
+        BoardSnapshot _working;               ///< State of the board on the game's thread.
+        TripleBuffer<BoardSnapshot> _buffer;  ///< Hands snapshots to the reader.
+
+        void publishWorking();
+
+    public:
+        /**
+         * @brief Constructor publishing the current state of a board and following it from now on.
+         * @param board The board; must outlive the feed.
+         */
+        explicit BoardFeed(GameBoard &board);
+
+        /**
+         * @brief Destructor unregistering from the board.
+         */
+        ~BoardFeed() override;
+
+        BoardFeed(const BoardFeed &) = delete;
+        BoardFeed &operator=(const BoardFeed &) = delete;
+
+        /**
+         * @brief Take the latest snapshot, if the board changed since the last poll; reader only.
+         * @return True if latest() changed.
+         */
+        bool poll();
+
+        /**
+         * @brief Get the snapshot taken by the last poll; reader only.
+         */
+        [[nodiscard]] const BoardSnapshot &latest() const;
+
+        /**
+         * @brief Get the adjacency of the board, which never changes once the board is built; safe from any thread.
+         */
+        [[nodiscard]] const BoardGraph &graph() const;
+
+        /**
+         * @brief Apply a change of the board to the snapshot and publish it; called on the game's thread.
+         * @param action The action that took place.
+         */
+        void onAction(const GameAction &action) override;
+    };
+
+} // namespace strategy
+
+#endif // BOARD_SNAPSHOT_HPP
@@ -0,0 +1,94 @@
+#ifndef BOARD_VIEW_HPP
+#define BOARD_VIEW_HPP
+
+#include "GameBoard.hpp"
+#include <span>
+
+namespace strategy {
+
+/**
+ * @class BoardView
+ * @brief A read-only view of a game board, for renderers and bots.
+ *
+ * The view is two words wide and meant to be passed by value. It hands out the board's
+ * nodes, pathways, terrains and players as pointers to const, straight from the board's
+ * own tables, so reading a board through it never allocates or copies.
+ */
+    class BoardView {
+    private:
+        const GameBoard *_board; ///< The board being viewed.
+
+    public:
+        /**
+         * @brief Constructor viewing a board.
+         * @param board The board; must outlive the view.
+         */
+        explicit BoardView(const GameBoard &board);
+
+        /**
+         * @brief Get all the nodes, in id order.
+         */
+        [[nodiscard]] std::span<const Node *const> nodes() const;
+
+        /**
+         * @brief Get all the pathways, in id order.
+         */
+        [[nodiscard]] std::span<const Pathway *const> pathways() const;
+
+        /**
+         * @brief Get all the terrains, in board order.
+         */
+        [[nodiscard]] std::span<const Terrain *const> terrains() const;
+
+        /**
+         * @brief Get the node with an id.
+         * @param id The id of the node, from 1.
+         * @return The node, or nullptr if there is none with this id.
+         */
+        [[nodiscard]] const Node *node(int id) const;
+
+        /**
+         * @brief Get the pathway with an id.
+         * @param id The id of the pathway, from 1.
+         * @return The pathway, or nullptr if there is none with this id.
+         */
+        [[nodiscard]] const Pathway *pathway(int id) const;
+
+        /**
+         * @brief Get the terrain at a position on the board.
+         * @param index The position of the terrain, from 0.
+         * @return The terrain, or nullptr if the position is off the board.
+         */
+        [[nodiscard]] const Terrain *terrain(int index) const;
+
+        /**
+         * @brief Get the adjacency graph of the board.
+         */
+        [[nodiscard]] const BoardGraph &graph() const;
+
+        /**
+         * @brief Get the position of the terrain holding the robber.
+         */
+        [[nodiscard]] int robber() const;
+
+        /**
+         * @brief Get the number of players registered with the board.
+         */
+        [[nodiscard]] int playerCount() const;
+
+        /**
+         * @brief Get the player sitting at a seat.
+         * @param seat The seat of the player.
+         * @return The player, or nullptr if the seat is empty.
+         */
+        [[nodiscard]] const game::Player *player(int seat) const;
+
+        /**
+         * @brief Get the number of development cards left in the deck.
+         */
+        [[nodiscard]] int deckCards() const;
+    };
+
+} // namespace strategy
+
+#endif // BOARD_VIEW_HPP
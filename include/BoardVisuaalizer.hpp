@@ -2,25 +2,126 @@
 #define BOARD_VISUALIZER_HPP
 
 #include <SFML/Graphics.hpp>
-#include "GameBoard.hpp"
+#include "BoardLayout.hpp"
+#include "BoardSnapshot.hpp"
+#include "BoardView.hpp"
+#include "SpectatorWall.hpp"
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
 #include <SFML/System.hpp>
+#include <array>
+#include <atomic>
+#include <optional>
 
 
-class BoardVisualizer {
+/**
+ * @class BoardVisualizer
+ * @brief Draws a game board in an SFML window, in retained mode.
+ *
+ * The static part of the board (hexes, outlines, number tokens and resource names) never
+ * changes during a game, so it is built once into a vertex array, rendered together with
+ * its labels into a texture, and drawn each frame as a single sprite. The texture is only
+ * rebuilt when a different board is drawn or the window is resized. The terrains are placed
+ * by strategy::BoardLayout, like the images of the headless strategy::BoardRasterizer.
+ *
+ * Roads, settlements and cities are drawn on top from the node and pathway positions of the
+ * layout, batched into one vertex array per player for roads and one for buildings, so a
+ * full board costs two draw calls per player however many pieces it holds.
+ *
+ * Everything is drawn from a strategy::BoardSnapshot of the board. runLive() takes the snapshots
+ * from a strategy::BoardFeed, so the game can be played on its own thread: the game publishes
+ * each change without waiting for a frame, and a frame draws the latest snapshot without
+ * waiting for the game.
+ *
+ * runWall() turns the window into a spectator wall showing many live games at once, see
+ * strategy::SpectatorWall.
+ *
+ * A visualizer watching a board is told about every settlement, city, road and robber move,
+ * and only redraws a frame after one of them (or a window event) changed what is shown; while
+ * nothing changes, run() sleeps instead of drawing, and frames are capped at FRAME_RATE.
+ */
+class BoardVisualizer : public strategy::GameObserver {
 public:
+    static constexpr unsigned FRAME_RATE = 60;   ///< Most frames drawn per second.
+    static constexpr int IDLE_SLEEP_MS = 16;     ///< Sleep between polls while nothing changes.
+
     BoardVisualizer(int windowWidth, int windowHeight);
-    void drawBoard( strategy::GameBoard& gameBoard);
-    void run();
+    ~BoardVisualizer() override;
+
+    BoardVisualizer(const BoardVisualizer &) = delete;
+    BoardVisualizer &operator=(const BoardVisualizer &) = delete;
+
+    void drawBoard(strategy::BoardView board);
+
+    /**
+     * @brief Redraw only on changes to a board, until the window is closed.
+     * @param board The board to show.
+     */
+    void run(strategy::BoardView board);
+
+    /**
+     * @brief Show a board played on another thread until the window is closed, redrawing when it publishes a change.
+     * @param feed The feed of the board, published by the game's thread.
+     */
+    void runLive(strategy::BoardFeed &feed);
+
+    /**
+     * @brief Show a wall of live boards until the window is closed, recoloring only the boards that changed.
+     * @param wall The wall, whose feeds are published by the games' threads.
+     */
+    void runWall(strategy::SpectatorWall &wall);
+
+    /**
+     * @brief Follow the changes of a board; the visualizer unregisters when destroyed.
+     * @param board The board, which must outlive the visualizer.
+     */
+    void watch(strategy::GameBoard &board);
+
+    /**
+     * @brief Draw and display a frame if anything changed since the last one.
+     * @param board The board to show.
+     * @return True if a frame was drawn.
+     */
+    bool renderFrame(strategy::BoardView board);
+
+    /**
+     * @brief Request a redraw on the next frame.
+     */
+    void markDirty();
+
+    /**
+     * @brief Mark the window dirty when a piece or the robber moved; may be called from the game's thread.
+     * @param action The action that took place.
+     */
+    void onAction(const strategy::GameAction &action) override;
 
     sf::RenderWindow window;
 private:
-    std::vector<int> rowLengths;
-    void drawHexagon(float x, float y, const sf::Color &color);
-    void drawText(float x, float y, const std::string& text, const sf::Font& font, unsigned int fontSize, const sf::Color& color);
+    strategy::GameBoard *watchedBoard = nullptr; ///< Board this visualizer observes.
+    std::atomic<bool> dirty{true};               ///< Whether the shown board changed since the last frame.
+    strategy::BoardSnapshot shown;               ///< Board drawn by drawBoard(), captured from its view.
 
     sf::Font font;
+
+    sf::VertexArray hexGeometry;       ///< Hex fills and outlines, as triangles.
+    sf::RenderTexture staticLayer;     ///< The hexes with their labels, rendered once.
+    sf::Sprite staticSprite;           ///< Draws the static layer in one call.
+    const strategy::BoardGraph *cachedBoard = nullptr; ///< Board the static layer shows.
+    std::array<std::uint8_t, strategy::BoardGraph::MAX_TERRAINS> cachedResources{}; ///< Terrains the static layer shows.
+    std::array<std::uint8_t, strategy::BoardGraph::MAX_TERRAINS> cachedNumbers{};   ///< Number tokens the static layer shows.
+    sf::Vector2u cachedSize;           ///< Window size the static layer was rendered at.
+    std::optional<strategy::BoardLayout> layout; ///< Terrain, node and pathway positions at the cached size.
+
+    std::array<sf::VertexArray, strategy::ProductionTable::MAX_SEATS> roadLayers;     ///< Roads of every seat, as triangles.
+    std::array<sf::VertexArray, strategy::ProductionTable::MAX_SEATS> buildingLayers; ///< Settlements and cities of every seat.
+    sf::CircleShape robberMarker;      ///< Drawn on the terrain holding the robber.
+
+    void appendHexagon(strategy::Point center, float radius, const sf::Color &color);
+    void rebuildStaticLayer(const strategy::BoardGraph &graph, const strategy::BoardSnapshot &snapshot);
+    void rebuildPieceLayers(const strategy::BoardGraph &graph, const strategy::BoardSnapshot &snapshot);
+    void drawSnapshot(const strategy::BoardGraph &graph, const strategy::BoardSnapshot &snapshot);
+    void pollEvents();
+    void drawText(sf::RenderTarget &target, float x, float y, const std::string& text, unsigned int fontSize, const sf::Color& color);
 };
 
 #endif // BOARD_VISUALIZER_HPP
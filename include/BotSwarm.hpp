@@ -0,0 +1,69 @@
+#ifndef BOT_SWARM_HPP
+#define BOT_SWARM_HPP
+
+#include "MatchProtocol.hpp"
+#include <cstddef>
+#include <cstdint>
+
+namespace strategy {
+
+/**
+ * @struct SwarmOptions
+ * @brief Settings of a bot swarm.
+ */
+    struct SwarmOptions {
+        Endpoint endpoint;            ///< Address of the match server.
+        std::size_t connections = 3;  ///< Bots, each on its own connection; the server seats three per match.
+        int buildsPerTurn = 2;        ///< Random build requests a bot sends after each roll.
+        std::uint64_t seed = 1;       ///< Seed of the bots' choices.
+        int idleTimeoutMs = 10000;    ///< Give up when the server sends nothing for this long.
+    };
+
+/**
+ * @struct SwarmStats
+ * @brief What the bots of a swarm saw.
+ */
+    struct SwarmStats {
+        std::size_t connected = 0; ///< Bots that connected.
+        std::size_t finished = 0;  ///< Bots told their match is over.
+        std::size_t dropped = 0;   ///< Bots the server disconnected before the end of their match.
+        std::size_t wins = 0;      ///< Bots that won their match.
+        std::size_t turns = 0;     ///< Turns the bots were given.
+        std::size_t rejected = 0;  ///< Requests the server refused.
+        std::size_t actions = 0;   ///< Actions received in diffs.
+        std::size_t bytesSent = 0;     ///< Bytes written to the server.
+        std::size_t bytesReceived = 0; ///< Bytes read from the server.
+        double seconds = 0.0;      ///< Time from the first connection until the last bot was done.
+    };
+
+/**
+ * @class BotSwarm
+ * @brief Load generator playing many matches against a MatchServer from one thread.
+ *
+ * Every bot opens its own connection and joins; on its turn it pipelines a roll, a few random
+ * builds and the end of its turn in one write, without waiting for the answers, and it leaves
+ * when told the match is over. All connections share one epoll loop, so a single swarm can keep
+ * tens of thousands of connections busy; raise the open file limit first, see raiseOpenFileLimit().
+ */
+    class BotSwarm {
+    private:
+        SwarmOptions _options; ///< Settings.
+
+    public:
+        /**
+         * @brief Constructor.
+         * @param options Settings.
+         */
+        explicit BotSwarm(SwarmOptions options);
+
+        /**
+         * @brief Connect every bot and play until every match is over.
+         * @return What the bots saw.
+         * @throws std::runtime_error if a connection fails or the server stops answering.
+         */
+        SwarmStats run();
+    };
+
+} // namespace strategy
+
+#endif // BOT_SWARM_HPP
@@ -0,0 +1,103 @@
+#ifndef DATASET_EXPORTER_HPP
+#define DATASET_EXPORTER_HPP
+
+#include "GameRecord.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+
+namespace strategy {
+
+/**
+ * @struct StateTensor
+ * @brief Fixed-layout snapshot of a game at the end of a turn, one byte per feature.
+ *
+ * Features, in order:
+ * - 54 nodes: 0 if empty, seat+1 for a settlement, seat+4 for a city.
+ * - 72 pathways: 0 if empty, seat+1 for a road.
+ * - 19 terrains: resource type, then number token (0 for the desert).
+ * - 3 players: 5 resource counts, 5 development card counts (by DevCardType), score.
+ */
+    struct StateTensor {
+        static constexpr std::size_t NODE_COUNT = 54;
+        static constexpr std::size_t PATHWAY_COUNT = 72;
+        static constexpr std::size_t TERRAIN_COUNT = 19;
+        static constexpr std::size_t PLAYER_COUNT = 3;
+        static constexpr std::size_t PLAYER_STRIDE = RESOURCE_TYPE_COUNT + game::DEV_CARD_TYPE_COUNT + 1;
+
+        static constexpr std::size_t NODE_OFFSET = 0;
+        static constexpr std::size_t PATHWAY_OFFSET = NODE_OFFSET + NODE_COUNT;
+        static constexpr std::size_t TERRAIN_OFFSET = PATHWAY_OFFSET + PATHWAY_COUNT;
+        static constexpr std::size_t PLAYER_OFFSET = TERRAIN_OFFSET + 2 * TERRAIN_COUNT;
+        static constexpr std::size_t FEATURE_COUNT = PLAYER_OFFSET + PLAYER_COUNT * PLAYER_STRIDE;
+
+        std::uint64_t seed = 0;     ///< Seed of the game.
+        std::uint32_t turn = 0;     ///< Turn the snapshot was taken at.
+        std::int8_t winner = -1;    ///< Seat of the winner of the game, or -1.
+        std::uint8_t activeSeat = 0; ///< Seat of the player about to roll.
+        std::array<std::uint8_t, FEATURE_COUNT> features{}; ///< The features, laid out as described above.
+
+        static constexpr std::size_t RECORD_SIZE = 8 + 4 + 1 + 1 + FEATURE_COUNT; ///< Bytes per record on disk.
+    };
+
+/**
+ * @brief Encode the current state of a replayed game.
+ * @param replayer The replayer positioned at the end of a turn.
+ * @param tensor Output; the features, turn and active seat are filled in.
+ */
+    void encodeState(GameReplayer &replayer, StateTensor &tensor);
+
+/**
+ * @struct ExportOptions
+ * @brief Settings of a dataset export.
+ */
+    struct ExportOptions {
+        std::string outputPrefix = "dataset"; ///< Shards are written to <prefix>-<worker>-<index>.tensors.
+        unsigned threadCount = 0;             ///< Worker threads, or 0 for one per core.
+        std::size_t recordsPerShard = 1 << 20; ///< Records after which a worker starts a new shard.
+    };
+
+/**
+ * @struct ExportStats
+ * @brief What an export produced.
+ */
+    struct ExportStats {
+        std::size_t games = 0;   ///< Games converted.
+        std::size_t records = 0; ///< Tensors written.
+        std::size_t shards = 0;  ///< Shard files written.
+    };
+
+/**
+ * @class DatasetExporter
+ * @brief Replays the games of a log and streams one StateTensor per turn to sharded binary files.
+ *
+ * Every shard starts with the magic string "CATANTSR", a version byte, and the record size as
+ * a little-endian uint32, followed by fixed-size records (seed, turn, winner, active seat,
+ * features). Workers take every n-th game of the memory-mapped log and write their own shards,
+ * so no game is ever held in memory beyond its current state and workers never share a file.
+ */
+    class DatasetExporter {
+    private:
+        ExportOptions _options; ///< Settings of the export.
+
+    public:
+        static constexpr std::uint8_t FORMAT_VERSION = 1; ///< Version of the shard layout.
+
+        /**
+         * @brief Constructor.
+         * @param options Settings of the export.
+         */
+        explicit DatasetExporter(ExportOptions options);
+
+        /**
+         * @brief Convert every game of a log.
+         * @param logPath Path of the game log.
+         * @return Counts of the converted games, written records and shards.
+         * @throws std::runtime_error if the log cannot be read or a shard cannot be written.
+         */
+        ExportStats exportLog(const std::string &logPath);
+    };
+
+} // namespace strategy
+
+#endif // DATASET_EXPORTER_HPP
@@ -1,10 +1,30 @@
 #ifndef DEVELOPMENT_CARD_HPP
 #define DEVELOPMENT_CARD_HPP
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 
 namespace game {
 
+/**
+ * @enum DevCardType
+ * @brief Identifies the kind of a development card without comparing type names.
+ */
+    enum class DevCardType : std::uint8_t {
+        Monopoly = 0,
+        VictoryPoint,
+        YearOfPlenty,
+        RoadBuilding,
+        Knight,
+        None
+    };
+
+    constexpr std::size_t DEV_CARD_TYPE_COUNT = 5; ///< Number of development card kinds (None excluded).
+
+    constexpr std::array<std::uint8_t, DEV_CARD_TYPE_COUNT> DEV_CARD_DECK = {100, 4, 100, 100, 3}; ///< Cards of each kind in a new deck, by DevCardType.
+
 /**
  * @class DevelopmentCard
  * @brief Abstract base class representing development cards in the game.
@@ -42,6 +62,12 @@ namespace game {
          * @return The type of the card as a string.
          */
         [[nodiscard]] virtual std::string cardType() const = 0;
+
+        /**
+         * @brief Retrieve the kind of the card.
+         * @return The card kind as a DevCardType.
+         */
+        [[nodiscard]] virtual DevCardType cardTypeId() const = 0;
     };
 
 /**
@@ -56,6 +82,7 @@ namespace game {
         [[nodiscard]] int getCardCount() const override;
         [[nodiscard]] DevelopmentCard* cloneCard() const override;
         [[nodiscard]] std::string cardType() const override;
+        [[nodiscard]] DevCardType cardTypeId() const override;
     };
 
 /**
@@ -69,6 +96,7 @@ namespace game {
         [[nodiscard]] int getCardCount() const override;
         [[nodiscard]] DevelopmentCard* cloneCard() const override;
         [[nodiscard]] std::string cardType() const override;
+        [[nodiscard]] DevCardType cardTypeId() const override;
     };
 
 /**
@@ -82,6 +110,7 @@ namespace game {
         [[nodiscard]] int getCardCount() const override;
         [[nodiscard]] DevelopmentCard* cloneCard() const override;
         [[nodiscard]] std::string cardType() const override;
+        [[nodiscard]] DevCardType cardTypeId() const override;
     };
 
 /**
@@ -95,6 +124,7 @@ namespace game {
         [[nodiscard]] int getCardCount() const override;
         [[nodiscard]] DevelopmentCard* cloneCard() const override;
         [[nodiscard]] std::string cardType() const override;
+        [[nodiscard]] DevCardType cardTypeId() const override;
     };
 
 /**
@@ -109,6 +139,7 @@ namespace game {
         [[nodiscard]] int getCardCount() const override;
         [[nodiscard]] DevelopmentCard* cloneCard() const override;
         [[nodiscard]] std::string cardType() const override;
+        [[nodiscard]] DevCardType cardTypeId() const override;
     };
 
 } // namespace game
@@ -0,0 +1,106 @@
+#ifndef DISCARD_STRATEGY_HPP
+#define DISCARD_STRATEGY_HPP
+
+#include "ResourceType.hpp"
+#include <cstdint>
+#include <functional>
+#include <random>
+
+namespace game {
+
+    class Player;
+
+/**
+ * @brief Draw cards uniformly at random, without replacement, from a hand.
+ *
+ * Performs a single multivariate hypergeometric draw: for each resource type the
+ * number of discarded cards is sampled from the conditional hypergeometric
+ * distribution of what remains, so the cost depends on the number of resource
+ * types rather than on the number of cards drawn.
+ *
+ * @param hand The resource counts to draw from.
+ * @param draws The number of cards to draw (clamped to the hand size).
+ * @param rng The random engine to use.
+ * @return The number of drawn cards per resource type.
+ */
+    strategy::ResourceCounts drawWithoutReplacement(const strategy::ResourceCounts &hand, int draws, std::mt19937 &rng);
+
+/**
+ * @class DiscardStrategy
+ * @brief Abstract policy deciding which cards a player gives up when a 7 is rolled.
+ *
+ * A strategy receives the player's hand and the number of cards that must be
+ * discarded, and returns the counts to discard per resource type.
+ */
+    class DiscardStrategy {
+    public:
+        /**
+         * @brief Virtual destructor for DiscardStrategy.
+         */
+        virtual ~DiscardStrategy();
+
+        /**
+         * @brief Choose the cards to discard.
+         * @param player The player who discards.
+         * @param hand The player's current resource counts.
+         * @param amount The number of cards that must be discarded.
+         * @return The counts to discard; must sum to amount and fit within hand.
+         */
+        virtual strategy::ResourceCounts chooseDiscard(const Player &player, const strategy::ResourceCounts &hand, int amount) = 0;
+    };
+
+/**
+ * @class RandomDiscardStrategy
+ * @brief Discards uniformly random cards with one multivariate hypergeometric draw.
+ */
+    class RandomDiscardStrategy : public DiscardStrategy {
+    private:
+        std::mt19937 _rng; ///< Random engine used for the draws.
+
+    public:
+        /**
+         * @brief Constructor seeding the engine from std::random_device.
+         */
+        RandomDiscardStrategy();
+
+        /**
+         * @brief Constructor with an explicit seed, for reproducible games.
+         * @param seed The seed of the random engine.
+         */
+        explicit RandomDiscardStrategy(std::uint32_t seed);
+
+        strategy::ResourceCounts chooseDiscard(const Player &player, const strategy::ResourceCounts &hand, int amount) override;
+    };
+
+/**
+ * @class GreedyDiscardStrategy
+ * @brief Discards from the largest piles first, keeping the hand as diverse as possible.
+ */
+    class GreedyDiscardStrategy : public DiscardStrategy {
+    public:
+        strategy::ResourceCounts chooseDiscard(const Player &player, const strategy::ResourceCounts &hand, int amount) override;
+    };
+
+/**
+ * @class BotDiscardStrategy
+ * @brief Delegates the discard decision to a bot-supplied callback.
+ */
+    class BotDiscardStrategy : public DiscardStrategy {
+    public:
+        using Chooser = std::function<strategy::ResourceCounts(const Player &, const strategy::ResourceCounts &, int)>;
+
+        /**
+         * @brief Constructor with the bot's decision callback.
+         * @param chooser Callback returning the counts to discard.
+         */
+        explicit BotDiscardStrategy(Chooser chooser);
+
+        strategy::ResourceCounts chooseDiscard(const Player &player, const strategy::ResourceCounts &hand, int amount) override;
+
+    private:
+        Chooser _chooser; ///< The bot's decision callback.
+    };
+
+} // namespace game
+
+#endif // DISCARD_STRATEGY_HPP
@@ -0,0 +1,68 @@
+#ifndef GAME_ACTION_HPP
+#define GAME_ACTION_HPP
+
+#include "ResourceType.hpp"
+#include <cstdint>
+
+namespace strategy {
+
+/**
+ * @enum ActionType
+ * @brief Every state-changing action a player can take during a game.
+ */
+    enum class ActionType : std::uint8_t {
+        InitialSettlement = 1, ///< value: node id
+        InitialPathway,        ///< value: pathway id
+        Roll,                  ///< value: first die, extra: second die
+        Discard,               ///< give: discarded cards
+        BuildPathway,          ///< value: pathway id
+        BuildSettlement,       ///< value: node id
+        UpgradeToCity,         ///< value: node id
+        BuyDevelopmentCard,    ///< value: DevCardType of the drawn card
+        PlayDevelopmentCard,   ///< value: DevCardType of the played card
+        PlayerTrade,           ///< partner: other seat, give/receive: cards from the acting player's side
+        BankTrade,             ///< give/receive: cards from the acting player's side
+        MoveRobber             ///< value: position of the terrain the robber moved to
+    };
+
+/**
+ * @struct GameAction
+ * @brief A successfully executed action, identified by the seat of the acting player.
+ *
+ * The meaning of value and extra depends on the action type, see ActionType.
+ */
+    struct GameAction {
+        ActionType type = ActionType::Roll; ///< The kind of action.
+        std::uint8_t seat = 0;              ///< Seat of the acting player.
+        std::uint8_t partner = 0;           ///< Seat of the other player in a trade.
+        int value = 0;                      ///< Main argument of the action.
+        int extra = 0;                      ///< Secondary argument of the action.
+        ResourceCounts give;                ///< Cards leaving the acting player's hand.
+        ResourceCounts receive;             ///< Cards entering the acting player's hand.
+    };
+
+/**
+ * @class GameObserver
+ * @brief Interface for components that follow every action applied to a game board.
+ *
+ * Observers are registered with the GameBoard and notified after each action took effect.
+ * A Roll is the exception: it is published before the discards and the production it causes,
+ * so that the actions of a turn are seen in the order they happen.
+ */
+    class GameObserver {
+    public:
+        /**
+         * @brief Virtual destructor for GameObserver.
+         */
+        virtual ~GameObserver();
+
+        /**
+         * @brief Called after an action was applied to the board.
+         * @param action The action that took place.
+         */
+        virtual void onAction(const GameAction &action) = 0;
+    };
+
+} // namespace strategy
+
+#endif // GAME_ACTION_HPP
@@ -4,7 +4,17 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <random>
+#include <span>
+#include "Bank.hpp"
+#include "BoardGraph.hpp"
 #include "DevelopmentCard.hpp"
+#include "GameAction.hpp"
+#include "ProductionTable.hpp"
+
+namespace game {
+    class Player;
+}
 
 namespace strategy {
 
@@ -21,13 +31,20 @@ namespace strategy {
  * - 54 nodes where settlements or cities can be established.
  * - 72 pathways connecting nodes, where roads can be built.
  * - A deck of development cards available for purchase.
+ * - 9 harbors on coastal nodes and the bank holding the resource supply.
  */
     class GameBoard {
     private:
         std::vector<Node *> _nodes; ///< Vector of pointers to nodes on the board.
         std::vector<Pathway *> _pathways; ///< Vector of pointers to pathways on the board.
         std::vector<Terrain *> _terrains; ///< Vector of pointers to terrains on the board.
+        BoardGraph _graph; ///< Adjacency of nodes, pathways and terrains, built once in the constructor.
+        ProductionTable _production; ///< Terrain and building data the payout of a roll is computed from.
         std::map<game::DevelopmentCard *, int> _devCardDeck; ///< Map of development cards and their quantities.
+        Bank _bank; ///< The bank holding the resource cards not in any player's hand.
+        std::vector<game::Player *> _players; ///< Players using this board, indexed by seat.
+        std::vector<GameObserver *> _observers; ///< Observers notified of every action.
+        std::mt19937 _rng; ///< Random engine used to draw development cards.
 
     public:
 
@@ -46,6 +63,49 @@ namespace strategy {
          */
         ~GameBoard();
 
+        GameBoard(const GameBoard &) = delete;
+        GameBoard &operator=(const GameBoard &) = delete;
+
+        /**
+         * @brief Get the adjacency graph of the board.
+         * @return The graph, indexed by node id minus one, pathway id minus one and terrain position.
+         */
+        [[nodiscard]] const BoardGraph &getGraph() const;
+
+        /**
+         * @brief Get the production data of the board.
+         * @return The resources, numbers and robber of the terrains and the buildings on the nodes.
+         */
+        [[nodiscard]] const ProductionTable &getProduction() const;
+
+        /**
+         * @brief Hand out the resources produced by a roll to every player.
+         *
+         * Every settlement on a terrain with the rolled number collects one card of its
+         * resource and every city two, unless the robber sits on the terrain. When the bank
+         * cannot pay everyone owed a resource, nobody gets it, unless only one player is owed
+         * it, who then gets what is left.
+         *
+         * @param roll The dice total.
+         */
+        void produce(int roll);
+
+        /**
+         * @brief Move the robber, which blocks the production of its terrain, and notify the observers.
+         *
+         * @param index The position of the terrain the robber is moved to.
+         * @param seat The seat of the player moving the robber.
+         * @throws std::out_of_range if the terrain is not on the board.
+         */
+        void moveRobber(int index, int seat = 0);
+
+        /**
+         * @brief Get the position of the terrain holding the robber; it starts on the desert.
+         *
+         * @return The position of the terrain.
+         */
+        [[nodiscard]] int getRobber() const;
+
         /**
          * @brief Retrieve the node at the specified index.
          *
@@ -57,9 +117,16 @@ namespace strategy {
         /**
          * @brief Get all the nodes on the game board.
          *
-         * @return A vector containing pointers to all nodes.
+         * @return A view of the node pointers, in id order; nothing is copied.
          */
-        std::vector<Node *> getNodes();
+        [[nodiscard]] std::span<Node *const> getNodes() const;
+
+        /**
+         * @brief Get all the pathways on the game board.
+         *
+         * @return A view of the pathway pointers, in id order; nothing is copied.
+         */
+        [[nodiscard]] std::span<Pathway *const> getPathways() const;
 
         /**
          * @brief Retrieve the pathway at the specified index.
@@ -80,9 +147,9 @@ namespace strategy {
         /**
          * @brief Get all terrains on the game board.
          *
-         * @return A vector containing pointers to all terrains on the board.
+         * @return A view of the terrain pointers, in board order; nothing is copied.
          */
-        std::vector<Terrain *> getTerrains();
+        [[nodiscard]] std::span<Terrain *const> getTerrains() const;
 
         /**
          * @brief Draw a random development card from the deck.
@@ -94,6 +161,124 @@ namespace strategy {
          */
         game::DevelopmentCard *drawRandomDevCard();
 
+        /**
+         * @brief Draw a development card of a specific kind from the deck.
+         *
+         * Used to replay recorded games, where the drawn card is known in advance.
+         *
+         * @param type The kind of card to draw.
+         * @return A pointer to a new card of that kind, or nullptr if none is left.
+         */
+        game::DevelopmentCard *drawDevCard(game::DevCardType type);
+
+        /**
+         * @brief Seed the random engine used to draw development cards.
+         *
+         * @param seed The seed, for reproducible games.
+         */
+        void seedRandom(std::uint32_t seed);
+
+        /**
+         * @brief Register a player using this board and assign them a seat.
+         *
+         * Seats are given in registration order, starting at 0. Registering the same
+         * player again returns their existing seat.
+         *
+         * @param player Pointer to the player.
+         * @return The player's seat.
+         * @throws std::logic_error if all ProductionTable::MAX_SEATS seats are taken.
+         */
+        int registerPlayer(game::Player *player);
+
+        /**
+         * @brief Retrieve the player sitting at a seat.
+         *
+         * @param seat The seat of the player.
+         * @return A pointer to the player, or nullptr if the seat is empty.
+         */
+        [[nodiscard]] game::Player *getPlayer(int seat) const;
+
+        /**
+         * @brief Get the number of players registered with the board.
+         *
+         * @return The number of seats taken.
+         */
+        [[nodiscard]] int getPlayerCount() const;
+
+        /**
+         * @brief Register an observer notified of every action applied to the board.
+         *
+         * @param observer Pointer to the observer; the board does not take ownership.
+         */
+        void addObserver(GameObserver *observer);
+
+        /**
+         * @brief Unregister an observer.
+         *
+         * @param observer Pointer to the observer.
+         */
+        void removeObserver(GameObserver *observer);
+
+        /**
+         * @brief Notify all observers of an action.
+         *
+         * Settlements and cities are also recorded in the production table here.
+         *
+         * @param action The action that took place.
+         */
+        void publish(const GameAction &action);
+
+        /**
+         * @brief Count the development cards of a kind left in the deck.
+         *
+         * @param type The kind of card.
+         * @return The number of cards.
+         */
+        [[nodiscard]] int countDeckCards(game::DevCardType type) const;
+
+        /**
+         * @brief Set how many development cards of each kind are left in the deck, as when restoring a saved game.
+         *
+         * @param counts The number of cards, indexed by DevCardType.
+         */
+        void restoreDeck(const std::array<std::uint8_t, game::DEV_CARD_TYPE_COUNT> &counts);
+
+        /**
+         * @brief Put a settlement or city back on a node, as when restoring a saved game.
+         *
+         * Nothing is paid and no observer is notified; the owner claims the node's harbor.
+         *
+         * @param nodeId The id of the node.
+         * @param seat The seat of the owner.
+         * @param city True for a city, false for a settlement.
+         * @throws std::out_of_range if the node or the seat is not on the board.
+         */
+        void restoreBuilding(int nodeId, int seat, bool city);
+
+        /**
+         * @brief Put a road back on a pathway, as when restoring a saved game; nothing is paid and no observer is notified.
+         *
+         * @param pathwayId The id of the pathway.
+         * @param seat The seat of the owner.
+         * @throws std::out_of_range if the pathway or the seat is not on the board.
+         */
+        void restoreRoad(int pathwayId, int seat);
+
+        /**
+         * @brief Put the robber back on a terrain, as when restoring a saved game; no observer is notified.
+         *
+         * @param index The position of the terrain.
+         * @throws std::out_of_range if the terrain is not on the board.
+         */
+        void restoreRobber(int index);
+
+        /**
+         * @brief Get the bank of this game.
+         *
+         * @return A reference to the bank holding the resource supply.
+         */
+        Bank &getBank();
+
         /**
          * @brief Display the current state of the game board.
          *
@@ -0,0 +1,32 @@
+#ifndef GAME_LOG_HPP
+#define GAME_LOG_HPP
+
+#include <ostream>
+
+namespace game {
+
+/**
+ * @brief Get the stream the game writes its play-by-play messages to.
+ *
+ * Returns std::cout while logging is enabled, and a stream that discards everything
+ * otherwise, so headless simulations and replays do not pay for console output.
+ *
+ * @return The output stream for game messages.
+ */
+    std::ostream &gameLog();
+
+/**
+ * @brief Enable or disable the play-by-play messages of the game.
+ * @param enabled True to write messages to std::cout, false to discard them.
+ */
+    void setGameLogEnabled(bool enabled);
+
+/**
+ * @brief Check whether play-by-play messages are written.
+ * @return True if messages go to std::cout.
+ */
+    bool isGameLogEnabled();
+
+} // namespace game
+
+#endif // GAME_LOG_HPP
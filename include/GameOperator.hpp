@@ -2,6 +2,7 @@
 #define GAMEOPERATOR_HPP
 
 #include "Player.hpp"
+#include "TurnDriver.hpp"
 
 namespace strategy {
 
@@ -17,7 +18,12 @@ namespace strategy {
         std::vector<game::Player *> _players; ///< Vector of pointers to the players in the game
         GameBoard *_board; ///< Pointer to the game board
 
+        GameTask driveTurns(std::vector<PlayerAgent *> agents, int maxTurns);
+
     public:
+        static constexpr int WINNING_SCORE = 10;      ///< Score that ends a game, whether played by playTurns() or a simulator.
+        static constexpr int MAX_MOVES_PER_TURN = 64; ///< Moves a player may make in one turn before it ends.
+
         GameOperator(); // Default constructor
         ~GameOperator(); // Destructor
 
@@ -41,7 +47,7 @@ namespace strategy {
         void initiateGame();
 
         /**
-         * @brief Declare the winner if a player reaches 10 points.
+         * @brief Declare the winner if a player reaches WINNING_SCORE points.
          * @return 1 if the game is over, 0 if the game is not yet over.
          */
         int declareWinner();
@@ -51,6 +57,22 @@ namespace strategy {
          * @return Vector of pointers to the players.
          */
         std::vector<game::Player*> getPlayers();
+
+        /**
+         * @brief Play turns as a coroutine, asking each player's agent for its moves.
+         *
+         * The game starts at once and runs until an agent has to wait for its move, see
+         * PlayerAgent; the task then resumes on the thread that delivers the move. So one thread
+         * can keep many games going, each waiting on a slow client, without blocking on any.
+         * Illegal or unaffordable moves are ignored. The players must have their initial
+         * settlements in place.
+         *
+         * @param agents The agent of each player, in the order of setPlayers(). Must outlive the task.
+         * @param maxTurns The turn limit.
+         * @return The game; its result is known once it is done.
+         * @throws std::invalid_argument if there is not one agent per player.
+         */
+        GameTask playTurns(std::vector<PlayerAgent *> agents, int maxTurns);
     };
 
 } // namespace strategy
@@ -0,0 +1,277 @@
+#ifndef GAME_RECORD_HPP
+#define GAME_RECORD_HPP
+
+#include "GameAction.hpp"
+#include "GameOperator.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @brief Append an unsigned LEB128 varint to a byte buffer.
+ * @param out The buffer to append to.
+ * @param value The value to encode.
+ */
+    void writeVarint(std::vector<std::uint8_t> &out, std::uint64_t value);
+
+/**
+ * @brief Decode an unsigned LEB128 varint and advance the read position.
+ * @param pos The read position; advanced past the varint on success.
+ * @param end One past the last readable byte.
+ * @param value Output, the decoded value.
+ * @return True on success, false if the input is truncated or longer than 10 bytes.
+ */
+    bool readVarint(const std::uint8_t *&pos, const std::uint8_t *end, std::uint64_t &value);
+
+/**
+ * @brief Append an action as its type tag, the seat and then the varint fields used by its type.
+ * @param out The buffer to append to.
+ * @param action The action to encode.
+ */
+    void writeAction(std::vector<std::uint8_t> &out, const GameAction &action);
+
+/**
+ * @brief Decode an action written by writeAction() and advance the read position.
+ *
+ * The costs of builds and development cards are not stored; they are implied by the type.
+ *
+ * @param pos The read position; advanced past the action on success.
+ * @param end One past the last readable byte.
+ * @param action Output, the decoded action.
+ * @return True on success, false if the input is truncated or does not start with an action type.
+ */
+    bool readAction(const std::uint8_t *&pos, const std::uint8_t *end, GameAction &action);
+
+/**
+ * @struct TerrainLayout
+ * @brief The resource and number token of one terrain, as stored in a game record.
+ */
+    struct TerrainLayout {
+        ResourceType resource = ResourceType::None; ///< Resource produced by the terrain.
+        int number = 0;                             ///< Number token of the terrain (0 for the desert).
+    };
+
+/**
+ * @struct GameHeader
+ * @brief Everything a game record stores before the first action.
+ */
+    struct GameHeader {
+        std::uint64_t seed = 0;                          ///< Seed the game was played with.
+        std::vector<std::string> playerNames;            ///< Player names, indexed by seat.
+        std::vector<TerrainLayout> terrains;             ///< Board terrains, in board order.
+        std::vector<std::pair<int, HarborType>> harbors; ///< Harbor nodes and their harbor types.
+    };
+
+/**
+ * @brief Capture the layout of a board for a game record.
+ * @param board The board.
+ * @param seed The seed the game is played with.
+ * @return A header with the board layout and the names of the registered players.
+ */
+    GameHeader describeGame(GameBoard &board, std::uint64_t seed);
+
+/**
+ * @class GameRecordWriter
+ * @brief Observer writing every game played on a board to an append-only binary log.
+ *
+ * The log starts with a magic string and a format version, followed by any number of games.
+ * A game is a header (seed, player names, board layout) followed by one record per action,
+ * every field encoded as a varint, and an end record holding the winner. A game is buffered
+ * in memory and appended with a single write when it ends, so a log never holds half a game.
+ */
+    class GameRecordWriter : public GameObserver {
+    private:
+        std::string _path;                  ///< Path of the log file.
+        std::vector<std::uint8_t> _buffer;  ///< Encoded records of the game in progress.
+        bool _inGame = false;               ///< True between beginGame and endGame.
+
+    public:
+        static constexpr std::uint8_t FORMAT_VERSION = 1; ///< Version of the binary layout.
+
+        /**
+         * @brief Constructor opening (or creating) a log file for appending.
+         * @param path Path of the log file.
+         * @throws std::runtime_error if the file cannot be opened or is not a game log.
+         */
+        explicit GameRecordWriter(std::string path);
+
+        /**
+         * @brief Start recording a game.
+         * @param header The seed, players and board layout of the game.
+         */
+        void beginGame(const GameHeader &header);
+
+        /**
+         * @brief Record an action of the game in progress.
+         * @param action The action that took place.
+         */
+        void onAction(const GameAction &action) override;
+
+        /**
+         * @brief Finish the game in progress and append it to the log.
+         * @param winnerSeat The seat of the winner, or -1 if the game had no winner.
+         * @throws std::runtime_error if the log cannot be written.
+         */
+        void endGame(int winnerSeat);
+    };
+
+/**
+ * @class GameRecordCursor
+ * @brief Forward-only decoder over the bytes of a game log.
+ *
+ * A cursor is a pair of pointers and can be copied freely to look ahead.
+ */
+    class GameRecordCursor {
+    private:
+        const std::uint8_t *_pos = nullptr; ///< Next byte to decode.
+        const std::uint8_t *_end = nullptr; ///< One past the last byte.
+        int _winner = -1;                   ///< Winner of the last finished game.
+
+        std::uint64_t readValue();
+
+    public:
+        GameRecordCursor() = default;
+
+        /**
+         * @brief Constructor over the games of a log, after its magic string and version.
+         * @param begin First byte of the first game.
+         * @param end One past the last byte.
+         */
+        GameRecordCursor(const std::uint8_t *begin, const std::uint8_t *end);
+
+        /**
+         * @brief Skip to the next game and decode its header.
+         * @param header Output, the header of the game.
+         * @return True if a game was found, false at the end of the log.
+         * @throws std::runtime_error if the log is malformed.
+         */
+        bool nextGame(GameHeader &header);
+
+        /**
+         * @brief Decode the next action of the current game.
+         * @param action Output, the decoded action.
+         * @return True if an action was decoded, false at the end of the game.
+         * @throws std::runtime_error if the log is malformed.
+         */
+        bool nextAction(GameAction &action);
+
+        /**
+         * @brief Get the winner of the game whose end was last reached.
+         * @return The winner's seat, or -1 if there was none.
+         */
+        [[nodiscard]] int winner() const;
+    };
+
+/**
+ * @class GameRecordReader
+ * @brief Memory-maps a game log for fast, zero-copy reading.
+ */
+    class GameRecordReader {
+    private:
+        const std::uint8_t *_data = nullptr; ///< Start of the mapping.
+        std::size_t _size = 0;               ///< Size of the mapping in bytes.
+
+    public:
+        /**
+         * @brief Constructor mapping a log file into memory.
+         * @param path Path of the log file.
+         * @throws std::runtime_error if the file cannot be mapped or is not a game log.
+         */
+        explicit GameRecordReader(const std::string &path);
+
+        /**
+         * @brief Destructor unmapping the file.
+         */
+        ~GameRecordReader();
+
+        GameRecordReader(const GameRecordReader &) = delete;
+        GameRecordReader &operator=(const GameRecordReader &) = delete;
+
+        /**
+         * @brief Get a cursor positioned before the first game of the log.
+         * @return The cursor.
+         */
+        [[nodiscard]] GameRecordCursor games() const;
+    };
+
+/**
+ * @class GameReplayer
+ * @brief Rebuilds the state of a recorded game by applying its actions to a fresh board.
+ */
+    class GameReplayer {
+    private:
+        GameRecordCursor _cursor;                            ///< Position of the next action.
+        std::unique_ptr<GameBoard> _board;                   ///< The rebuilt board.
+        std::vector<std::unique_ptr<game::Player>> _players; ///< The rebuilt players, indexed by seat.
+        GameOperator _operator;                              ///< Wires the turn order of the players.
+        std::vector<ResourceCounts> _pendingDiscards;        ///< Recorded discards of the roll being replayed.
+        int _turn = 0;                                       ///< Number of rolls replayed.
+        bool _finished = false;                              ///< True once the end of the game was reached.
+
+        void apply(const GameAction &action);
+
+    public:
+        /**
+         * @brief Constructor preparing a board matching a recorded game.
+         * @param header The header of the game.
+         * @param cursor A cursor positioned right after the header.
+         * @throws std::invalid_argument if the recorded board or player count does not match the engine.
+         */
+        GameReplayer(const GameHeader &header, const GameRecordCursor &cursor);
+
+        GameReplayer(const GameReplayer &) = delete;
+        GameReplayer &operator=(const GameReplayer &) = delete;
+        GameReplayer(GameReplayer &&) = delete;
+        GameReplayer &operator=(GameReplayer &&) = delete;
+
+        /**
+         * @brief Apply the next recorded action.
+         * @return True if an action was applied, false at the end of the game.
+         */
+        bool step();
+
+        /**
+         * @brief Apply actions until the state at the end of a turn is reached.
+         *
+         * Turn 0 is the setup phase; turn n ends right before the (n+1)-th roll.
+         *
+         * @param turn The turn to stop at.
+         * @return The turn actually reached, lower if the game ended first.
+         */
+        int replayUntilTurn(int turn);
+
+        /**
+         * @brief Get the number of turns replayed so far.
+         */
+        [[nodiscard]] int getTurn() const;
+
+        /**
+         * @brief Check whether all recorded actions were applied.
+         */
+        [[nodiscard]] bool isFinished() const;
+
+        /**
+         * @brief Get the cursor positioned after the last applied action.
+         *
+         * Once the replay is finished, the cursor can move on to the next game of the log.
+         */
+        [[nodiscard]] const GameRecordCursor &getCursor() const;
+
+        /**
+         * @brief Get the rebuilt board.
+         */
+        GameBoard &getBoard();
+
+        /**
+         * @brief Get the rebuilt player at a seat.
+         * @param seat The seat of the player.
+         */
+        game::Player &getPlayer(int seat);
+    };
+
+} // namespace strategy
+
+#endif // GAME_RECORD_HPP
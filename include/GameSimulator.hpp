@@ -0,0 +1,110 @@
+#ifndef GAME_SIMULATOR_HPP
+#define GAME_SIMULATOR_HPP
+
+#include "GameOperator.hpp"
+#include "GameRecord.hpp"
+#include "GameSnapshot.hpp"
+#include "GameTracer.hpp"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @class GameSimulator
+ * @brief Plays a complete three-player game between greedy bots, reproducibly from a seed.
+ *
+ * Bots place their initial settlements and roads as ranked by the PlacementSolver in snake
+ * order, then on each turn roll and keep upgrading to cities, building settlements, building
+ * roads, trading with the bank and buying or playing development cards while they can.
+ */
+    class GameSimulator {
+    private:
+        std::uint64_t _seed;                                 ///< Seed of the game.
+        std::unique_ptr<GameBoard> _board;                   ///< The board the game is played on.
+        std::vector<std::unique_ptr<game::Player>> _players; ///< The bots, indexed by seat.
+        GameOperator _operator;                              ///< Wires the turn order of the bots.
+        GameRecordWriter *_recorder = nullptr;               ///< Log the game is recorded to, or null.
+        GameTracer *_tracer = nullptr;                       ///< Trace the turns are written to, or null.
+        int _turn = 0;                                       ///< Turns played after the setup phase.
+        bool _setUp = false;                                 ///< Whether the initial settlements are placed.
+
+        bool takeGreedyAction(game::Player &player);
+
+    public:
+        /**
+         * @brief Constructor preparing a board and three bots.
+         * @param seed Seed for the development card deck, the dice and the discards.
+         */
+        explicit GameSimulator(std::uint64_t seed);
+
+        /**
+         * @brief Record the game played by play() to a log.
+         * @param recorder The log writer, or nullptr to stop recording. Must outlive the simulator's games.
+         */
+        void setRecorder(GameRecordWriter *recorder);
+
+        /**
+         * @brief Write spans for every turn, phase and bot search to a trace.
+         * @param tracer The tracer, or nullptr to stop tracing. Must outlive the simulator's games.
+         */
+        void setTracer(GameTracer *tracer);
+
+        /**
+         * @brief Place two settlements and roads per bot, in snake order.
+         */
+        void playSetup();
+
+        /**
+         * @brief Play the turn of the active bot: roll, then act greedily.
+         */
+        void playTurn();
+
+        /**
+         * @brief Save the game as it stands between turns.
+         * @param snapshot Output.
+         */
+        void checkpoint(GameSnapshot &snapshot);
+
+        /**
+         * @brief Continue a saved game on this simulator, which must not have played yet.
+         *
+         * Use a simulator built with the snapshot's seed. The dice and deck draw anew from that
+         * seed, so the rest of the game is reproducible but differs from the one that was saved.
+         * A snapshot taken before the setup leaves the setup to play().
+         *
+         * @param snapshot The snapshot, as checked by viewSnapshot().
+         * @throws std::invalid_argument if the simulator has already played or was built with another seed.
+         */
+        void restore(const GameSnapshot &snapshot);
+
+        /**
+         * @brief Play the setup, unless it was played or restored, and then turns until a bot wins or the turn limit is reached.
+         * @param maxTurns The turn limit.
+         * @return The outcome of the game.
+         * @throws std::logic_error if a recorder is set but the setup was already played or restored,
+         * since the log could not be replayed.
+         */
+        SimulationResult play(int maxTurns);
+
+        /**
+         * @brief Get the board of the game.
+         */
+        GameBoard &getBoard();
+
+        /**
+         * @brief Get the bot at a seat.
+         * @param seat The seat of the bot.
+         */
+        game::Player &getPlayer(int seat);
+
+        /**
+         * @brief Get the operator of the game, to drive turns with agents instead of play().
+         */
+        GameOperator &getOperator();
+    };
+
+} // namespace strategy
+
+#endif // GAME_SIMULATOR_HPP
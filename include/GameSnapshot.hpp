@@ -0,0 +1,125 @@
+#ifndef GAME_SNAPSHOT_HPP
+#define GAME_SNAPSHOT_HPP
+
+#include "StateDelta.hpp"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <type_traits>
+
+namespace strategy {
+
+/**
+ * @struct GameSnapshot
+ * @brief A complete game as one fixed-size, trivially copyable image, saved and restored as raw bytes.
+ *
+ * Pieces and players are referred to by node, pathway and seat instead of pointers, so the image
+ * can be written to a file as is and used straight from a memory mapping. It holds the pieces,
+ * the cards and scores of every seat, the development card deck, the bank and whose turn it is.
+ * The random engines of the board and the players are not saved; reseed them after a restore.
+ * The layout is the one of this build (little-endian), guarded by the version and the size.
+ */
+    struct GameSnapshot {
+        static constexpr std::uint32_t FORMAT_VERSION = 1; ///< Version of the layout.
+        static constexpr std::size_t NAME_LENGTH = 24;     ///< Bytes kept of a player's name, including the terminator.
+
+        std::array<char, 8> magic{};   ///< Identifies a snapshot file.
+        std::uint32_t version = 0;     ///< FORMAT_VERSION of the writer.
+        std::uint32_t size = 0;        ///< Size of the image in bytes.
+        std::uint64_t checksum = 0;    ///< FNV-1a hash of every byte after this field.
+
+        std::uint64_t seed = 0;        ///< Seed the game was started with.
+        std::int32_t turn = 0;         ///< Turns played after the setup phase.
+        std::int8_t activeSeat = -1;   ///< Seat whose turn it is, or -1.
+        std::uint8_t seatCount = 0;    ///< Players in the game.
+        std::array<std::uint8_t, game::DEV_CARD_TYPE_COUNT> deck{}; ///< Development cards left in the deck, per type.
+        ResourceCounts bank;           ///< Resource cards left in the bank.
+        GameState state;               ///< Terrains, robber, buildings, roads and the cards of every seat.
+        std::array<std::int32_t, GameState::MAX_SEATS> scores{};                          ///< Score of every seat.
+        std::array<std::array<char, NAME_LENGTH>, GameState::MAX_SEATS> names{};          ///< Name of every seat.
+    };
+
+    static_assert(std::is_trivially_copyable_v<GameSnapshot>, "A snapshot is saved and restored as raw bytes.");
+
+/**
+ * @brief Capture a game and seal the snapshot with its header and checksum.
+ * @param board The board; its registered players are the seats of the game.
+ * @param seed The seed the game was started with.
+ * @param turn The turns played after the setup phase.
+ * @param snapshot Output.
+ */
+    void captureGame(GameBoard &board, std::uint64_t seed, int turn, GameSnapshot &snapshot);
+
+/**
+ * @brief Check a sealed snapshot held in memory and view it in place.
+ *
+ * Checks the header, the checksum and that every field is in range: owners are seated, cards
+ * are not negative, every resource card is either in the bank or in a hand, and the deck and
+ * the hands hold no more development cards of a kind than a new deck.
+ *
+ * @param bytes The image; must be aligned for GameSnapshot.
+ * @return The snapshot, pointing into bytes.
+ * @throws std::runtime_error naming the first check that failed.
+ */
+    const GameSnapshot &viewSnapshot(std::span<const std::uint8_t> bytes);
+
+/**
+ * @brief Write a sealed snapshot to a file, replacing the file only once the snapshot is complete.
+ *
+ * The snapshot is written to a temporary file, synced to disk and renamed over the target, so
+ * after a crash the file holds either the previous snapshot or this one.
+ * @param path Path of the file.
+ * @param snapshot The snapshot, as sealed by captureGame().
+ * @throws std::runtime_error if the file cannot be written.
+ */
+    void writeSnapshot(const std::string &path, const GameSnapshot &snapshot);
+
+/**
+ * @brief Put a captured game on a fresh board.
+ *
+ * The board must have no pieces yet and exactly the snapshot's number of players registered;
+ * the players keep their names. Pieces are placed and cards handed out without paying the bank
+ * or notifying the board's observers, and only the player at the active seat has its turn.
+ *
+ * @param snapshot The snapshot.
+ * @param board The board to restore the game on.
+ * @throws std::invalid_argument if the board has another layout, another number of players or pieces.
+ */
+    void restoreGame(const GameSnapshot &snapshot, GameBoard &board);
+
+/**
+ * @class GameSnapshotReader
+ * @brief Memory-maps a snapshot file and checks it, without copying it.
+ */
+    class GameSnapshotReader {
+    private:
+        const std::uint8_t *_data = nullptr; ///< Start of the mapping.
+        std::size_t _size = 0;               ///< Size of the mapping in bytes.
+        const GameSnapshot *_snapshot = nullptr; ///< The checked snapshot, in the mapping.
+
+    public:
+        /**
+         * @brief Constructor mapping and checking a snapshot file.
+         * @param path Path of the file.
+         * @throws std::runtime_error if the file cannot be mapped or fails a check of viewSnapshot().
+         */
+        explicit GameSnapshotReader(const std::string &path);
+
+        /**
+         * @brief Destructor unmapping the file.
+         */
+        ~GameSnapshotReader();
+
+        GameSnapshotReader(const GameSnapshotReader &) = delete;
+        GameSnapshotReader &operator=(const GameSnapshotReader &) = delete;
+
+        /**
+         * @brief Get the snapshot; valid as long as the reader.
+         */
+        [[nodiscard]] const GameSnapshot &snapshot() const;
+    };
+
+} // namespace strategy
+
+#endif // GAME_SNAPSHOT_HPP
@@ -0,0 +1,105 @@
+#ifndef GAME_TRACER_HPP
+#define GAME_TRACER_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+
+namespace game {
+    class Player;
+}
+
+namespace strategy {
+
+/**
+ * @class GameTracer
+ * @brief Writes spans in the Chrome trace_event JSON format, to be opened in chrome://tracing or Perfetto.
+ *
+ * Every span is written as one complete ("X") event when it ends, tagged with the player's
+ * name and the turn number. The tracer may be shared by games running on several threads;
+ * each thread appears as its own track.
+ */
+    class GameTracer {
+    private:
+        std::ofstream _file;                              ///< The trace file.
+        std::mutex _mutex;                                ///< Serializes writes from several threads.
+        std::chrono::steady_clock::time_point _origin;    ///< Time zero of the trace.
+        bool _firstEvent = true;                          ///< True until an event was written.
+
+    public:
+        /**
+         * @brief Constructor creating the trace file.
+         * @param path Path of the trace file.
+         * @throws std::runtime_error if the file cannot be created.
+         */
+        explicit GameTracer(const std::string &path);
+
+        /**
+         * @brief Destructor closing the JSON document.
+         */
+        ~GameTracer();
+
+        GameTracer(const GameTracer &) = delete;
+        GameTracer &operator=(const GameTracer &) = delete;
+
+        /**
+         * @brief Get the current time of the trace.
+         * @return Microseconds since the tracer was created.
+         */
+        [[nodiscard]] double now() const;
+
+        /**
+         * @brief Write a finished span.
+         * @param name Name of the span, e.g. "Turn" or "Roll".
+         * @param category Category of the span: "turn", "phase" or "search".
+         * @param start Start time, from now().
+         * @param end End time, from now().
+         * @param player Name of the acting player.
+         * @param turn Turn number.
+         */
+        void writeSpan(const char *name, const char *category, double start, double end, const std::string &player, int turn);
+    };
+
+/**
+ * @class TraceSpan
+ * @brief Scope guard tracing the time until the end of its scope; does nothing without a tracer.
+ */
+    class TraceSpan {
+    private:
+        GameTracer *_tracer;
+        const char *_name;
+        const char *_category;
+        const game::Player *_player;
+        int _turn;
+        double _start = 0.0;
+
+    public:
+        /**
+         * @brief Start a span.
+         * @param tracer The tracer, or nullptr to trace nothing.
+         * @param name Name of the span; must outlive the span.
+         * @param category Category of the span; must outlive the span.
+         * @param player The acting player; must outlive the span.
+         * @param turn Turn number.
+         */
+        TraceSpan(GameTracer *tracer, const char *name, const char *category, const game::Player &player, int turn)
+                : _tracer(tracer), _name(name), _category(category), _player(&player), _turn(turn) {
+            if (_tracer) {
+                _start = _tracer->now();
+            }
+        }
+
+        /**
+         * @brief End the span, writing it to the tracer if there is one.
+         */
+        ~TraceSpan();
+
+        TraceSpan(const TraceSpan &) = delete;
+        TraceSpan &operator=(const TraceSpan &) = delete;
+    };
+
+} // namespace strategy
+
+#endif // GAME_TRACER_HPP
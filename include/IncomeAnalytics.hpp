@@ -0,0 +1,106 @@
+#ifndef INCOME_ANALYTICS_HPP
+#define INCOME_ANALYTICS_HPP
+
+#include "GameAction.hpp"
+#include "ProductionTable.hpp"
+#include <array>
+#include <cstddef>
+
+namespace strategy {
+
+    class GameBoard;
+
+/**
+ * @struct ExpectedIncome
+ * @brief Expected number of cards per roll, per resource type.
+ */
+    struct ExpectedIncome {
+        std::array<double, RESOURCE_TYPE_COUNT> perResource{}; ///< Expected cards per roll, indexed by ResourceType.
+
+        double &operator[](ResourceType type) { return perResource[static_cast<std::size_t>(type)]; }
+        double operator[](ResourceType type) const { return perResource[static_cast<std::size_t>(type)]; }
+
+        /**
+         * @brief Expected cards per roll over all resource types.
+         */
+        [[nodiscard]] double total() const;
+    };
+
+/**
+ * @brief Get the number of dice combinations out of 36 that roll a number token.
+ * @param number The number token, 2 to 12; anything else (the desert's 0, the 7) has no pips.
+ * @return The pips of the token.
+ */
+    int pips(int number);
+
+/**
+ * @brief Compute the expected income of a settlement on every node.
+ * @param table The production data of the board; a terrain holding the robber counts for nothing.
+ * @return The income of every node, by node index (id minus one).
+ */
+    std::array<ExpectedIncome, BoardGraph::MAX_NODES> computeNodeIncome(const ProductionTable &table);
+
+/**
+ * @class IncomeAnalytics
+ * @brief Keeps the pip-weighted expected income of every node and every player of a board.
+ *
+ * The income of a node is the sum, over the terrains it borders, of pips / 36 cards of the
+ * terrain's resource; a terrain holding the robber counts for nothing. A player's income is
+ * the income of their settlements plus twice that of their cities. The analytics register
+ * with the board as an observer and add a node's income to its owner on every settlement and
+ * city, so queries are lookups. Node incomes are recomputed only when the robber moves.
+ * Not thread-safe: query from the thread playing the game.
+ */
+    class IncomeAnalytics : public GameObserver {
+    private:
+        GameBoard &_board;                                              ///< The board being followed.
+        mutable std::array<ExpectedIncome, BoardGraph::MAX_NODES> _nodes; ///< Income per node index.
+        mutable std::array<ExpectedIncome, ProductionTable::MAX_SEATS> _players; ///< Income per seat.
+        mutable int _robber = -2;                                       ///< Robber the cache was computed for.
+
+        void refreshIfRobberMoved() const;
+
+    public:
+        /**
+         * @brief Constructor computing the income of the board and following it from now on.
+         * @param board The board; must outlive the analytics.
+         */
+        explicit IncomeAnalytics(GameBoard &board);
+
+        /**
+         * @brief Destructor unregistering from the board.
+         */
+        ~IncomeAnalytics() override;
+
+        IncomeAnalytics(const IncomeAnalytics &) = delete;
+        IncomeAnalytics &operator=(const IncomeAnalytics &) = delete;
+
+        /**
+         * @brief Recompute the income of every node and player from the board.
+         */
+        void refresh() const;
+
+        /**
+         * @brief Get the expected income of a settlement on a node.
+         * @param nodeId The id of the node, from 1.
+         * @throws std::out_of_range if there is no node with this id.
+         */
+        [[nodiscard]] const ExpectedIncome &nodeIncome(int nodeId) const;
+
+        /**
+         * @brief Get the expected income of a player's settlements and cities.
+         * @param seat The seat of the player.
+         * @throws std::out_of_range if the seat is out of range.
+         */
+        [[nodiscard]] const ExpectedIncome &playerIncome(int seat) const;
+
+        /**
+         * @brief Add the income of new settlements and cities to their owners, and recompute when the robber moves.
+         * @param action The action that took place.
+         */
+        void onAction(const GameAction &action) override;
+    };
+
+} // namespace strategy
+
+#endif // INCOME_ANALYTICS_HPP
@@ -0,0 +1,158 @@
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+
+#ifdef CATAN_INSTRUMENTATION
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#else
+#include <chrono>
+#endif
+#endif
+
+namespace game {
+
+/**
+ * @enum Probe
+ * @brief The engine phases that are counted and timed when instrumentation is compiled in.
+ */
+    enum class Probe : std::uint8_t {
+        Roll,            ///< A whole roll, including discards and production.
+        Production,      ///< Paying out the terrains of a roll.
+        BuildCheck,      ///< Legality checks of roads, settlements and cities.
+        Build,           ///< Building roads, settlements and cities.
+        Setup,           ///< Initial settlements and roads.
+        Trade,           ///< Trades with players and the bank.
+        DevelopmentCard, ///< Buying and playing development cards.
+        Discard,         ///< Discarding half of a hand on a 7.
+        WinnerCheck      ///< Checking the scores for a winner.
+    };
+
+    constexpr std::size_t PROBE_COUNT = 9; ///< Number of probes.
+
+/**
+ * @struct ProbeStats
+ * @brief What a probe measured: how often it ran and the timestamp ticks spent inside it.
+ *
+ * Ticks are CPU timestamp counter cycles on x86 and nanoseconds elsewhere. Ticks are inclusive,
+ * so the production of a roll is counted both under Production and under Roll.
+ */
+    struct ProbeStats {
+        std::uint64_t calls = 0; ///< Number of times the probe ran.
+        std::uint64_t ticks = 0; ///< Total ticks spent inside the probe.
+    };
+
+    using ProbeReport = std::array<ProbeStats, PROBE_COUNT>; ///< Statistics of every probe, indexed by Probe.
+
+/**
+ * @brief Check whether instrumentation was compiled in (with -DCATAN_INSTRUMENTATION).
+ */
+    constexpr bool instrumentationEnabled() {
+#ifdef CATAN_INSTRUMENTATION
+        return true;
+#else
+        return false;
+#endif
+    }
+
+/**
+ * @brief Get the name of a probe.
+ * @param probe The probe.
+ * @return The name, e.g. "Roll".
+ */
+    const char *probeName(Probe probe);
+
+/**
+ * @brief Sum the statistics recorded by all threads, including threads that have exited.
+ * @return The statistics of every probe; all zero when instrumentation is compiled out.
+ */
+    ProbeReport collectProbes();
+
+/**
+ * @brief Clear the statistics of all threads.
+ *
+ * Statistics recorded concurrently with the reset may be partially kept.
+ */
+    void resetProbes();
+
+/**
+ * @brief Write a table of calls, ticks and ticks per call for every probe that ran.
+ * @param out The stream to write to.
+ */
+    void dumpProbes(std::ostream &out);
+
+#ifdef CATAN_INSTRUMENTATION
+
+/**
+ * @brief Per-thread probe statistics.
+ *
+ * Only the owning thread writes; the counters are atomics so that collectProbes() may read
+ * them from another thread, but updates are plain relaxed loads and stores without locking.
+ */
+    struct ProbeBuffer {
+        std::array<std::atomic<std::uint64_t>, PROBE_COUNT> calls{};
+        std::array<std::atomic<std::uint64_t>, PROBE_COUNT> ticks{};
+
+        ProbeBuffer();
+        ~ProbeBuffer();
+
+        void add(Probe probe, std::uint64_t elapsed) {
+            auto i = static_cast<std::size_t>(probe);
+            calls[i].store(calls[i].load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            ticks[i].store(ticks[i].load(std::memory_order_relaxed) + elapsed, std::memory_order_relaxed);
+        }
+    };
+
+/**
+ * @brief Get the probe buffer of the calling thread, registering it on first use.
+ */
+    inline ProbeBuffer &threadProbeBuffer() {
+        thread_local ProbeBuffer buffer;
+        return buffer;
+    }
+
+/**
+ * @brief Read the timestamp counter.
+ */
+    inline std::uint64_t readTicks() {
+#if defined(__x86_64__) || defined(__i386__)
+        return __rdtsc();
+#else
+        return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+/**
+ * @class ScopedProbe
+ * @brief Counts one run of a probe and adds the ticks spent until the end of the scope.
+ */
+    class ScopedProbe {
+    private:
+        Probe _probe;
+        std::uint64_t _start;
+
+    public:
+        explicit ScopedProbe(Probe probe) : _probe(probe), _start(readTicks()) {}
+        ~ScopedProbe() { threadProbeBuffer().add(_probe, readTicks() - _start); }
+        ScopedProbe(const ScopedProbe &) = delete;
+        ScopedProbe &operator=(const ScopedProbe &) = delete;
+    };
+
+#define CATAN_PROBE_CONCAT_(a, b) a##b
+#define CATAN_PROBE_CONCAT(a, b) CATAN_PROBE_CONCAT_(a, b)
+/// Time the rest of the enclosing scope under a probe.
+#define CATAN_PROBE_SCOPE(probe) ::game::ScopedProbe CATAN_PROBE_CONCAT(catanProbe_, __LINE__)(::game::Probe::probe)
+
+#else
+
+#define CATAN_PROBE_SCOPE(probe) static_cast<void>(0)
+
+#endif // CATAN_INSTRUMENTATION
+
+} // namespace game
+
+#endif // INSTRUMENTATION_HPP
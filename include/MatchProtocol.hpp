@@ -0,0 +1,142 @@
+#ifndef MATCH_PROTOCOL_HPP
+#define MATCH_PROTOCOL_HPP
+
+#include "GameAction.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @enum MessageType
+ * @brief Every message of the match protocol.
+ *
+ * A frame is a little-endian 16-bit length of the body, then the body: the message type and its
+ * fields, encoded as varints.
+ */
+    enum class MessageType : std::uint8_t {
+        Join = 1,  ///< Client: take the seat the connection was given.
+        Roll,      ///< Client: roll the dice on the client's turn.
+        Build,     ///< Client: build: a BuildKind and the pathway or node id.
+        EndTurn,   ///< Client: pass the turn on after rolling.
+        Seated,    ///< Server: the match id and the client's seat.
+        YourTurn,  ///< Server: the number of the turn the client has to play.
+        Diff,      ///< Server: the actions that changed the game, in the order they happened.
+        Rejected,  ///< Server: a RejectReason for the last request of the client.
+        GameOver   ///< Server: the winner's seat, or -1, and the number of turns played.
+    };
+
+/**
+ * @enum BuildKind
+ * @brief The pieces a Build request can place.
+ */
+    enum class BuildKind : std::uint8_t {
+        Pathway,    ///< id: pathway id
+        Settlement, ///< id: node id
+        City        ///< id: node id of the client's settlement
+    };
+
+/**
+ * @enum RejectReason
+ * @brief Why the server refused a request.
+ */
+    enum class RejectReason : std::uint8_t {
+        NotYourTurn = 1, ///< Another seat is playing, or the client has not rolled yet.
+        IllegalMove,     ///< The rules or the client's cards do not allow the move.
+        MatchNotReady,   ///< The match is still waiting for players or is over.
+        BadRequest       ///< The request is not one a client sends.
+    };
+
+/**
+ * @class ProtocolError
+ * @brief Thrown for a frame that is not valid in the match protocol.
+ */
+    class ProtocolError : public std::runtime_error {
+    public:
+        using std::runtime_error::runtime_error;
+    };
+
+/**
+ * @struct Message
+ * @brief A decoded message; only the fields of its type are meaningful.
+ */
+    struct Message {
+        static constexpr std::size_t MAX_BODY = 4096;       ///< Longest frame body accepted.
+        static constexpr std::size_t MAX_DIFF_ACTIONS = 64; ///< Most actions carried by one Diff.
+
+        MessageType type = MessageType::Join;   ///< The kind of message.
+        BuildKind build = BuildKind::Pathway;   ///< Build: piece to place.
+        int id = 0;                             ///< Build: pathway or node id.
+        std::uint32_t match = 0;                ///< Seated: id of the match.
+        int seat = -1;                          ///< Seated: the client's seat.
+        int turn = 0;                           ///< YourTurn: turn number; GameOver: turns played.
+        int winner = -1;                        ///< GameOver: seat of the winner, or -1.
+        RejectReason reason = RejectReason::BadRequest; ///< Rejected: why.
+        std::vector<GameAction> actions;        ///< Diff: the actions, at most MAX_DIFF_ACTIONS.
+    };
+
+/**
+ * @brief Append a message as one frame.
+ * @param out The buffer to append to.
+ * @param message The message; only the fields of its type are written.
+ * @throws std::invalid_argument if a Diff holds more than Message::MAX_DIFF_ACTIONS actions.
+ */
+    void encodeMessage(std::vector<std::uint8_t> &out, const Message &message);
+
+/**
+ * @brief Append a Diff frame straight from a run of actions, without building a Message.
+ * @param out The buffer to append to.
+ * @param actions The actions, at most Message::MAX_DIFF_ACTIONS.
+ * @throws std::invalid_argument if there are too many actions.
+ */
+    void encodeDiff(std::vector<std::uint8_t> &out, std::span<const GameAction> actions);
+
+/**
+ * @brief Decode the frame at the start of a buffer.
+ * @param in The bytes received so far.
+ * @param message Output, the decoded message.
+ * @return The length of the frame, or 0 if the buffer does not hold a whole frame yet.
+ * @throws ProtocolError if the frame is too long or its body is malformed.
+ */
+    std::size_t decodeMessage(std::span<const std::uint8_t> in, Message &message);
+
+/**
+ * @struct Endpoint
+ * @brief Where the match server listens: a Unix socket path if one is given, otherwise a TCP address.
+ */
+    struct Endpoint {
+        std::string unixPath;           ///< Path of the Unix socket, or empty for TCP.
+        std::string host = "127.0.0.1"; ///< IPv4 address for TCP.
+        std::uint16_t port = 0;         ///< TCP port; 0 lets the server pick a free one.
+    };
+
+/**
+ * @brief Open a non-blocking listening socket.
+ * @param endpoint The address; an existing file at a Unix socket path is replaced.
+ * @param backlog Connections the kernel may queue before they are accepted.
+ * @return The socket.
+ * @throws std::runtime_error if the socket cannot be bound.
+ */
+    int listenOn(const Endpoint &endpoint, int backlog);
+
+/**
+ * @brief Connect to a server and make the socket non-blocking.
+ * @param endpoint The address of the server.
+ * @return The socket.
+ * @throws std::runtime_error if the connection is refused.
+ */
+    int connectTo(const Endpoint &endpoint);
+
+/**
+ * @brief Raise the limit of open files of the process to its hard limit, for many connections.
+ * @return The limit now in effect.
+ */
+    std::size_t raiseOpenFileLimit();
+
+} // namespace strategy
+
+#endif // MATCH_PROTOCOL_HPP
@@ -0,0 +1,106 @@
+#ifndef MATCH_SERVER_HPP
+#define MATCH_SERVER_HPP
+
+#include "MatchProtocol.hpp"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @struct ServerOptions
+ * @brief Settings of a match server.
+ */
+    struct ServerOptions {
+        Endpoint endpoint;          ///< Where to listen.
+        unsigned threadCount = 0;   ///< Worker threads, or 0 for one per core.
+        bool pinThreads = true;     ///< Pin every worker to its own core.
+        int maxTurns = 200;         ///< Turns after which a match ends without a winner.
+        std::uint64_t seed = 1;     ///< Seed of the first match; match i is played with seed + i.
+        int backlog = 4096;         ///< Connections the kernel queues before they are accepted.
+    };
+
+/**
+ * @struct ServerStats
+ * @brief Counters of a match server, summed over its workers.
+ */
+    struct ServerStats {
+        std::size_t connections = 0;     ///< Connections accepted.
+        std::size_t matchesStarted = 0;  ///< Matches whose three players all joined.
+        std::size_t matchesFinished = 0; ///< Matches played to a winner or to the turn limit.
+        std::size_t matchesAborted = 0;  ///< Matches a player left before the end.
+        std::size_t rejected = 0;        ///< Requests refused.
+    };
+
+/**
+ * @class MatchServer
+ * @brief Hosts many three-player matches at once for clients speaking the match protocol.
+ *
+ * An acceptor thread seats every three consecutive connections in a new match and hands them
+ * to the worker owning that match, round robin. A worker runs its own epoll loop over the
+ * connections of its matches only, so a match is always played on one thread and its game
+ * state is never locked or shared; workers can be pinned to their own cores. A match starts
+ * when its three clients joined: the server places the opening settlements and roads, then
+ * tells the seat on turn to play. Every change is broadcast to the three clients as a Diff of
+ * the GameActions the board published, and replies are written once per batch of events.
+ * Each match is a GameSimulator: its GameOperator wires the turn order of the three players,
+ * and the simulator adds the seeded board and the opening placements.
+ */
+    class MatchServer {
+    private:
+        struct Worker;
+
+        ServerOptions _options;                       ///< Settings.
+        int _listenFd = -1;                           ///< Listening socket.
+        int _wakeFd = -1;                             ///< Event file waking the acceptor to stop.
+        std::uint16_t _port = 0;                      ///< TCP port actually bound.
+        std::vector<std::unique_ptr<Worker>> _workers; ///< Workers, each with its own epoll loop.
+        std::thread _acceptor;                        ///< Accepts and seats connections.
+        std::atomic<std::size_t> _accepted{0};        ///< Connections accepted so far.
+        bool _running = false;                        ///< Whether the threads were started.
+
+        void acceptLoop();
+
+    public:
+        /**
+         * @brief Constructor binding the listening socket; no connection is accepted before start().
+         * @param options Settings.
+         * @throws std::runtime_error if the endpoint cannot be bound.
+         */
+        explicit MatchServer(ServerOptions options = {});
+
+        /**
+         * @brief Destructor stopping the server and closing every connection.
+         */
+        ~MatchServer();
+
+        MatchServer(const MatchServer &) = delete;
+        MatchServer &operator=(const MatchServer &) = delete;
+
+        /**
+         * @brief Start the acceptor and the workers.
+         */
+        void start();
+
+        /**
+         * @brief Stop accepting, wake the workers and wait for them; open matches are dropped.
+         */
+        void stop();
+
+        /**
+         * @brief Get the TCP port the server listens on, or 0 on a Unix socket.
+         */
+        [[nodiscard]] std::uint16_t port() const;
+
+        /**
+         * @brief Get the counters of the server; may be called while it runs.
+         */
+        [[nodiscard]] ServerStats stats() const;
+    };
+
+} // namespace strategy
+
+#endif // MATCH_SERVER_HPP
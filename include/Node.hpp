@@ -1,7 +1,10 @@
 #ifndef NODE_HPP
 #define NODE_HPP
 
+#include "BoardGraph.hpp"
 #include "Property.hpp"
+#include "ResourceType.hpp"
+#include <array>
 #include <iostream>
 #include <vector>
 
@@ -17,6 +20,9 @@ namespace strategy {
  * A Node is a crucial part of the game board, representing locations where settlements or cities can be established.
  * Each node is associated with multiple pathways and terrains. Nodes also store information about whether they are
  * occupied and what kind of property (settlement or city) is currently on them.
+ *
+ * Adjacency added while the board is set up is kept on the node until the board compiles
+ * its BoardGraph; from then on the node reads its pathways, neighbors and terrains from the graph.
  */
     class Node {
     private:
@@ -24,9 +30,12 @@ namespace strategy {
         game::City *_city;                 ///< Pointer to a City, if established on this node.
         game::Settelment *_settlement;     ///< Pointer to a Settlement, if established on this node.
         bool _occupied;                    ///< Occupied status of the node.
-        std::vector<Pathway *> _pathways;  ///< Vector of Pathway pointers associated with this node.
-        std::vector<Terrain *> _terrains;  ///< Vector of Terrain pointers associated with this node.
-        std::vector<Node *> _neighbors;    ///< Vector of neighboring nodes.
+        std::vector<Pathway *> _pathways;  ///< Pathways added before the graph is built; emptied afterwards.
+        std::vector<Terrain *> _terrains;  ///< Terrains added before the graph is built; emptied afterwards.
+        std::vector<Node *> _neighbors;    ///< Neighbors added before the graph is built; emptied afterwards.
+        HarborType _harbor;                ///< Harbor reachable from this node, if any.
+        const BoardGraph *_graph = nullptr; ///< The board graph, once built.
+        std::uint8_t _index = 0;           ///< Index of this node in the board graph.
 
     public:
         /**
@@ -68,22 +77,41 @@ namespace strategy {
         /**
          * @brief Get the Terrain associated with the node at the specified index.
          * @param i The index of the Terrain in the vector.
-         * @return Pointer to the Terrain at the specified index.
+         * @return Pointer to the Terrain at the specified index, or nullptr if out of range.
          */
         Terrain* getTerrainAt(int i);
 
         /**
          * @brief Get the Pathway associated with the node at the specified index.
          * @param i The index of the Pathway in the vector.
-         * @return Pointer to the Pathway at the specified index.
+         * @return Pointer to the Pathway at the specified index, or nullptr if out of range.
          */
         Pathway *getPathwayAt(int i);
 
         /**
          * @brief Get all Pathways associated with the node.
-         * @return A vector of Pathway pointers associated with the node.
+         * @return A view of the Pathway pointers associated with the node; nothing is copied.
+         */
+        [[nodiscard]] GraphRange<Pathway> getPathways() const;
+
+        /**
+         * @brief Get all Terrains around the node.
+         * @return A view of the Terrain pointers around the node.
+         */
+        [[nodiscard]] GraphRange<Terrain> getTerrains() const;
+
+        /**
+         * @brief Get all neighboring nodes.
+         * @return A view of the neighboring Node pointers.
+         */
+        [[nodiscard]] GraphRange<Node> getNeighbors() const;
+
+        /**
+         * @brief Read the adjacency of this node from the board graph from now on.
+         * @param graph The compiled board graph.
+         * @param index The index of this node in the graph.
          */
-        std::vector<Pathway *> getPathways();
+        void attachGraph(const BoardGraph *graph, std::uint8_t index);
 
         /**
          * @brief Set a neighboring node.
@@ -114,7 +142,7 @@ namespace strategy {
          * @brief Check if the node is occupied.
          * @return True if the node is occupied, false otherwise.
          */
-        bool isOccupied();
+        [[nodiscard]] bool isOccupied() const;
 
         /**
          * @brief Set the occupied status of the node.
@@ -126,13 +154,25 @@ namespace strategy {
          * @brief Get the Settlement at the node.
          * @return Pointer to the Settlement at the node.
          */
-        game::Settelment *getSettlement();
+        [[nodiscard]] game::Settelment *getSettlement() const;
 
         /**
          * @brief Get the City at the node.
          * @return Pointer to the City at the node.
          */
-        game::City *getCity();
+        [[nodiscard]] game::City *getCity() const;
+
+        /**
+         * @brief Set the harbor reachable from this node.
+         * @param harbor The harbor type.
+         */
+        void setHarbor(HarborType harbor);
+
+        /**
+         * @brief Get the harbor reachable from this node.
+         * @return The harbor type, or HarborType::None if the node is not on a harbor.
+         */
+        [[nodiscard]] HarborType getHarbor() const;
 
         /**
          * @brief Print information about the node.
@@ -150,7 +190,7 @@ namespace strategy {
     class Pathway {
     private:
         int _id;                      ///< ID of the pathway.
-        std::vector<Node *> _nodes;   ///< Vector of Node pointers that this pathway connects.
+        std::array<Node *, 2> _nodes; ///< The two nodes this pathway connects.
         Pathway *_path;               ///< Pointer to a Path, if set.
         bool _occupied;               ///< Occupied status of the pathway.
         game::Player *_owner;         ///< Pointer to the player who owns this pathway.
@@ -178,13 +218,13 @@ namespace strategy {
          * @brief Get the first Node associated with the pathway.
          * @return Pointer to the first Node.
          */
-        Node *getNode1();
+        [[nodiscard]] Node *getNode1() const;
 
         /**
          * @brief Get the second Node associated with the pathway.
          * @return Pointer to the second Node.
          */
-        Node *getNode2();
+        [[nodiscard]] Node *getNode2() const;
 
         /**
          * @brief Set a Path on the pathway.
@@ -213,7 +253,7 @@ namespace strategy {
          * @brief Check if the pathway is occupied.
          * @return True if the pathway is occupied, false otherwise.
          */
-        bool isOccupied();
+        [[nodiscard]] bool isOccupied() const;
 
         /**
          * @brief Set the occupied status of the pathway.
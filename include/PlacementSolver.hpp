@@ -0,0 +1,90 @@
+#ifndef PLACEMENT_SOLVER_HPP
+#define PLACEMENT_SOLVER_HPP
+
+#include "IncomeAnalytics.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace strategy {
+
+    class GameBoard;
+
+/**
+ * @struct Placement
+ * @brief An initial settlement and the road placed next to it.
+ */
+    struct Placement {
+        int seat = 0;       ///< Seat of the player placing.
+        int nodeId = 0;     ///< Id of the settlement's node.
+        int pathwayId = 0;  ///< Id of the road's pathway, or 0 if every pathway of the node is taken.
+        double score = 0.0; ///< Value of the player's settlements at the end of the setup phase.
+    };
+
+/**
+ * @struct PlacementOptions
+ * @brief Settings of the placement solver.
+ */
+    struct PlacementOptions {
+        unsigned threadCount = 0;       ///< Worker threads, or 0 for one per core.
+        std::size_t limit = 10;         ///< Placements returned by rank(), best first.
+        double diversityWeight = 0.05;  ///< Value of each distinct resource a player collects, in cards per roll.
+    };
+
+/**
+ * @class PlacementSolver
+ * @brief Ranks initial settlements and roads for the snake-order setup phase.
+ *
+ * Picks are numbered in snake order: with three players, seats 0, 1, 2, 2, 1, 0 make picks
+ * 0 to 5. The solver takes the buildings already on the board as the earlier picks. Every
+ * legal node for the current pick is scored by playing the rest of the setup phase: each
+ * later pick greedily takes the legal node adding the most value to its player. A player's
+ * value is the expected income of their settlements (see IncomeAnalytics) plus
+ * diversityWeight for every resource they receive at all. Candidates are scored on
+ * threadCount workers; each candidate's road points toward the best node still free
+ * two steps away, where the player can expand to.
+ */
+    class PlacementSolver {
+    private:
+        using Occupancy = std::array<std::int8_t, BoardGraph::MAX_NODES>;
+
+        const GameBoard &_board;                                        ///< The board being solved.
+        int _players;                                                   ///< Players in the game.
+        PlacementOptions _options;                                      ///< Settings.
+        std::array<ExpectedIncome, BoardGraph::MAX_NODES> _income;      ///< Income of every node.
+        Occupancy _start{};                                             ///< Owner of every node on the board, -1 if free.
+
+        [[nodiscard]] double value(const ExpectedIncome &income) const;
+        [[nodiscard]] bool isLegal(const Occupancy &occupancy, std::size_t node) const;
+        [[nodiscard]] double playOut(std::size_t candidate, int pick) const;
+        [[nodiscard]] int choosePathway(std::size_t node, int seat) const;
+
+    public:
+        /**
+         * @brief Constructor reading the board.
+         * @param board The board, with the picks made so far.
+         * @param players Players in the game.
+         * @param options Settings.
+         * @throws std::invalid_argument if the number of players is not supported.
+         */
+        PlacementSolver(const GameBoard &board, int players, PlacementOptions options = {});
+
+        /**
+         * @brief Get the seat making a pick of the setup phase.
+         * @param pick The pick, from 0 to 2 * players - 1.
+         * @param players Players in the game.
+         */
+        static int seatOfPick(int pick, int players);
+
+        /**
+         * @brief Rank the placements of a pick.
+         * @param pick The pick, from 0 to 2 * players - 1.
+         * @return At most options.limit placements, best first.
+         * @throws std::out_of_range if the pick is not part of the setup phase.
+         */
+        [[nodiscard]] std::vector<Placement> rank(int pick) const;
+    };
+
+} // namespace strategy
+
+#endif // PLACEMENT_SOLVER_HPP
@@ -4,9 +4,15 @@
 #include "GameBoard.hpp"
 #include "ResourceCard.hpp"
 #include "DevelopmentCard.hpp"
+#include "DiscardStrategy.hpp"
+#include "ResourceType.hpp"
+#include "TradeNegotiator.hpp"
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <iostream>
 #include <map>
+#include <memory>
 #include <random>
 #include <stdexcept>
 #include <string>
@@ -25,15 +31,52 @@ namespace game {
     class Player {
     protected:
         std::string _playerName;                       ///< Name of the participant.
-        std::map<std::string, int> _resources;         ///< Resource card counts by type.
+        strategy::ResourceCounts _resources;           ///< Resource card counts by type.
         int _score = 0;                                ///< The player's current score.
         bool _turnActive = false;                      ///< Indicates if it's the player's turn.
         Player *_nextPlayer = nullptr;                 ///< Pointer to the next participant in the turn sequence.
         strategy::GameBoard *_gameBoard = nullptr;     ///< Pointer to the game board.
+        int _seat = -1;                                ///< Seat at the game board, or -1 without a board.
+        std::mt19937 _rng;                             ///< Random engine used for dice rolls.
         std::vector<Player *> _otherParticipants;      ///< List of other participants in the game.
         std::map<DevelopmentCard *, int> _devCards;    ///< Player's development cards with counts.
+        std::unique_ptr<DiscardStrategy> _discardStrategy; ///< Policy choosing the cards to discard on a 7.
+        std::array<std::uint8_t, strategy::RESOURCE_TYPE_COUNT> _tradeRatios{}; ///< Best bank trade ratio per resource.
+        std::unique_ptr<TradePolicy> _tradePolicy;     ///< Policy answering trade offers, or null to reject them all.
+
+        /**
+         * @brief Pay cards from the hand back to the bank.
+         * @param cards The cards to pay.
+         */
+        void payToBank(const strategy::ResourceCounts &cards);
+
+        /**
+         * @brief Take cards from the bank into the hand, limited by the bank's supply.
+         * @param type The resource type.
+         * @param amount The number of cards requested.
+         * @return The number of cards received.
+         */
+        int takeFromBank(strategy::ResourceType type, int amount);
+
+        /**
+         * @brief Pay for a drawn development card and add it to the collection.
+         * @param card Pointer to the drawn card, or nullptr if the deck was empty.
+         */
+        void addDevelopmentCard(DevelopmentCard *card);
+
+        /**
+         * @brief Notify the game board's observers of an action taken by this player.
+         * @param action The action; its seat is filled in.
+         */
+        void publishAction(strategy::GameAction &action);
 
     public:
+        // Building costs, indexed Brick, Grain, Lumber, Ore, Wool
+        static constexpr strategy::ResourceCounts ROAD_COST{{1, 0, 1, 0, 0}};
+        static constexpr strategy::ResourceCounts SETTLEMENT_COST{{1, 1, 1, 0, 1}};
+        static constexpr strategy::ResourceCounts CITY_COST{{0, 2, 0, 3, 0}};
+        static constexpr strategy::ResourceCounts DEVELOPMENT_CARD_COST{{0, 1, 0, 1, 1}};
+
         /**
          * @brief Default constructor for Player.
          */
@@ -67,6 +110,26 @@ namespace game {
          */
         void acquireDevelopmentCard();
 
+        /**
+         * @brief Acquire a development card of a specific kind, as recorded in a replayed game.
+         * @param type The kind of card to draw from the deck.
+         */
+        void acquireDevelopmentCard(DevCardType type);
+
+        /**
+         * @brief Find a development card of a specific kind in the player's collection.
+         * @param type The kind of card.
+         * @return Pointer to the card, or nullptr if the player has none.
+         */
+        DevelopmentCard *findDevelopmentCard(DevCardType type);
+
+        /**
+         * @brief Count the development cards of a specific kind the player holds.
+         * @param type The kind of card.
+         * @return The number of cards.
+         */
+        [[nodiscard]] int countDevelopmentCards(DevCardType type) const;
+
         /**
          * @brief Activate a specific development card.
          * @param card Pointer to the development card to activate.
@@ -91,6 +154,21 @@ namespace game {
          */
         void receiveTwoResourceCards(strategy::ResourceCard *card);
 
+        /**
+         * @brief Receive the cards produced for this player by a roll.
+         * @param cards The cards, already taken out of the bank.
+         */
+        void receiveProduction(const strategy::ResourceCounts &cards);
+
+        /**
+         * @brief Replace the cards and score of the player, as when restoring a saved game; the bank is not involved.
+         * @param resources The resource cards to hold.
+         * @param devCards The number of development cards to hold, indexed by DevCardType.
+         * @param score The score.
+         */
+        void restoreCards(const strategy::ResourceCounts &resources,
+                          const std::array<std::uint8_t, DEV_CARD_TYPE_COUNT> &devCards, int score);
+
         /**
          * @brief Display all development cards owned by the player.
          */
@@ -107,6 +185,35 @@ namespace game {
          */
         int rollDiceAndMove();
 
+        /**
+         * @brief Move with known dice values, as recorded in a replayed game.
+         * @param die1 The value of the first die (1-6).
+         * @param die2 The value of the second die (1-6).
+         * @return The total of the dice.
+         */
+        int rollDiceAndMove(int die1, int die2);
+
+        /**
+         * @brief Check whether a pathway can be built, without side effects.
+         * @param pathNum The number identifying the pathway.
+         * @return True if buildPathway would succeed.
+         */
+        bool canBuildPathway(int pathNum);
+
+        /**
+         * @brief Check whether a settlement can be built, without side effects.
+         * @param nodeNum The number identifying the node.
+         * @return True if buildSettlement would succeed.
+         */
+        bool canBuildSettlement(int nodeNum);
+
+        /**
+         * @brief Check whether a settlement can be upgraded to a city, without side effects.
+         * @param nodeNum The number identifying the node.
+         * @return True if upgradeToCity would succeed.
+         */
+        bool canUpgradeToCity(int nodeNum);
+
         /**
          * @brief Build a pathway on the game board.
          * @param pathNum The number identifying the pathway to build on.
@@ -138,11 +245,23 @@ namespace game {
         void establishInitialPathway(int pathNum);
 
         /**
-         * @brief Set the game board for the player.
+         * @brief Set the game board for the player and take a seat at it.
          * @param board Pointer to the game board.
          */
         void assignGameBoard(strategy::GameBoard *board);
 
+        /**
+         * @brief Get the player's seat at the game board.
+         * @return The seat, or -1 if no board is assigned.
+         */
+        [[nodiscard]] int getSeat() const;
+
+        /**
+         * @brief Seed the random engine used for dice rolls, for reproducible games.
+         * @param seed The seed.
+         */
+        void seedRandom(std::uint32_t seed);
+
         /**
          * @brief Simplify a resource name for internal use.
          * @param complexName The complex name of the resource.
@@ -178,6 +297,73 @@ namespace game {
          */
         void conductTrade(Player *participant, const std::string &give, const std::string &receive, int amountGive, int amountReceive);
 
+        /**
+         * @brief Record the bank trade ratios granted by a harbor the player settled on.
+         * @param harbor The harbor type of the settled node.
+         */
+        void claimHarbor(strategy::HarborType harbor);
+
+        /**
+         * @brief Get the best ratio at which the player can trade a resource with the bank.
+         * @param type The resource to give.
+         * @return 2 with a matching resource harbor, 3 with a generic harbor, 4 otherwise.
+         */
+        [[nodiscard]] int bestTradeRatio(strategy::ResourceType type) const;
+
+        /**
+         * @brief Get the best bank trade ratio of every resource.
+         * @return The trade ratios, indexed by resource type.
+         */
+        [[nodiscard]] const std::array<std::uint8_t, strategy::RESOURCE_TYPE_COUNT> &getTradeRatios() const;
+
+        /**
+         * @brief Check whether a trade with the bank is possible.
+         * @param give The resource to give.
+         * @param receive The resource to receive.
+         * @param amountReceive The number of cards to receive.
+         * @return True if the player holds enough cards and the bank has enough supply.
+         */
+        [[nodiscard]] bool canTradeWithBank(strategy::ResourceType give, strategy::ResourceType receive, int amountReceive = 1) const;
+
+        /**
+         * @brief Trade resources with the bank at the player's best ratio for the given resource.
+         * @param give The resource to give.
+         * @param receive The resource to receive.
+         * @param amountReceive The number of cards to receive.
+         * @return True if the trade was completed, false otherwise.
+         */
+        bool tradeWithBank(strategy::ResourceType give, strategy::ResourceType receive, int amountReceive = 1);
+
+        /**
+         * @brief Exchange several resources with another player atomically.
+         *
+         * Either both hands can pay and the whole exchange happens, or nothing changes.
+         *
+         * @param participant Pointer to the player to trade with.
+         * @param give The cards this player hands over.
+         * @param receive The cards this player receives.
+         * @return True if the exchange was executed, false otherwise.
+         */
+        bool exchangeResources(Player *participant, const strategy::ResourceCounts &give, const strategy::ResourceCounts &receive);
+
+        /**
+         * @brief Set the policy answering trade offers made to this player.
+         * @param policy The trade policy; the player takes ownership. Null makes the player reject all offers.
+         */
+        void setTradePolicy(std::unique_ptr<TradePolicy> policy);
+
+        /**
+         * @brief Get the policy answering trade offers made to this player.
+         * @return Pointer to the trade policy, or nullptr if none is set.
+         */
+        [[nodiscard]] TradePolicy *getTradePolicy() const;
+
+        /**
+         * @brief Get the other participants in the game.
+         * @return The list of other players.
+         */
+        [[nodiscard]] const std::vector<Player *> &getOtherParticipants() const;
+
         /**
          * @brief Activate or deactivate the player's turn.
          * @param isActive True to activate the turn, false to deactivate it.
@@ -197,16 +383,37 @@ namespace game {
          */
         void distributeResourcesAfterSettlement(int nodeNum);
 
+        /**
+         * @brief Count all resource cards the player holds.
+         * @return The total hand size.
+         */
+        [[nodiscard]] int countResourceCards() const;
+
+        /**
+         * @brief Get the player's resource counts.
+         * @return The resource counts indexed by resource type.
+         */
+        [[nodiscard]] const strategy::ResourceCounts &getResources() const;
+
         /**
          * @brief Discard resource cards as per game rules.
+         *
+         * Every participant holding more than 7 resource cards in total discards half of them,
+         * rounded down, as chosen by their discard strategy.
          */
         void discardResourceCards();
 
         /**
-         * @brief Helper function to reduce the number of resource cards.
-         * @param cards Reference to the map of resource cards to reduce.
+         * @brief Discard half of this player's hand if it holds more than 7 resource cards.
+         * @return The number of discarded cards.
+         */
+        int discardHalf();
+
+        /**
+         * @brief Set the policy used to choose cards when discarding.
+         * @param strategy The discard strategy; the player takes ownership.
          */
-        static void reduceResourceCards(std::map<std::string, int> &cards);
+        void setDiscardStrategy(std::unique_ptr<DiscardStrategy> strategy);
 
         /**
          * @brief Check if it's currently the player's turn.
@@ -0,0 +1,126 @@
+#ifndef PRODUCTION_BATCH_HPP
+#define PRODUCTION_BATCH_HPP
+
+#include "ProductionTable.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace strategy {
+
+    class GameBoard;
+
+/**
+ * @enum ProductionKernel
+ * @brief The implementation ProductionBatch::produce runs.
+ */
+    enum class ProductionKernel : std::uint8_t {
+        Auto,   ///< AVX2 when the CPU supports it, scalar otherwise.
+        Scalar, ///< Portable code, one game at a time.
+        Avx2    ///< 32 games per instruction; falls back to scalar on CPUs without AVX2.
+    };
+
+/**
+ * @class ProductionBatch
+ * @brief Computes the production of a roll in many independent games at once.
+ *
+ * All games are played on the same layout (resources, numbers and corners, taken from a
+ * reference board); what differs is the buildings and the robber. Those are stored game-major
+ * per node: the seats of node n in all games are contiguous, padded to a multiple of 32 games,
+ * so one AVX2 register holds node n of 32 games. For every terrain the kernel compares the 32
+ * rolls with its number, masks out games where the robber sits on it, and adds the yield of
+ * each corner into the per-seat delta of the matching owner.
+ *
+ * Deltas are written as bytes, indexed [(seat * RESOURCE_TYPE_COUNT + resource) * stride() + game].
+ * A roll pays at most 24 cards of a resource to a player, so they never overflow. The bank
+ * shortage rule is not applied; callers that keep a bank per game apply it themselves.
+ */
+    class ProductionBatch {
+    public:
+        static constexpr std::size_t LANES = 32; ///< Games per AVX2 register.
+
+    private:
+        ProductionTable _layout;                 ///< Resources, numbers and corners of the terrains.
+        std::size_t _games;                      ///< Games in the batch.
+        std::size_t _stride;                     ///< Games rounded up to a multiple of LANES.
+        std::size_t _seats;                      ///< Players per game.
+        std::vector<std::uint8_t> _nodeSeats;    ///< Owner seat + 1 of every node, [node * stride + game].
+        std::vector<std::uint8_t> _nodeYields;   ///< Yield of every node, [node * stride + game].
+        std::vector<std::uint8_t> _robbers;      ///< Terrain holding the robber in every game.
+
+        void produceScalar(const std::uint8_t *rolls, std::uint8_t *deltas) const;
+        void produceAvx2(const std::uint8_t *rolls, std::uint8_t *deltas) const;
+
+    public:
+        /**
+         * @brief Constructor preparing empty boards.
+         * @param layout A board whose terrain layout every game shares.
+         * @param games Number of games.
+         * @param seats Players per game, at most ProductionTable::MAX_SEATS.
+         * @throws std::invalid_argument if there are too many seats.
+         */
+        ProductionBatch(const GameBoard &layout, std::size_t games, std::size_t seats);
+
+        [[nodiscard]] std::size_t games() const { return _games; }
+        [[nodiscard]] std::size_t seats() const { return _seats; }
+        [[nodiscard]] std::size_t stride() const { return _stride; }
+
+        /**
+         * @brief Get the number of delta bytes produce() writes.
+         */
+        [[nodiscard]] std::size_t deltaSize() const;
+
+        /**
+         * @brief Copy the buildings and the robber of a board into a game of the batch.
+         * @param game The game.
+         * @param board A board with the same layout.
+         * @throws std::out_of_range if the game is not in the batch or a building belongs to a seat past the batch's seats.
+         */
+        void loadGame(std::size_t game, const GameBoard &board);
+
+        /**
+         * @brief Record the building on a node of a game.
+         * @param game The game.
+         * @param node Index of the node (id minus one).
+         * @param seat Seat of the owner.
+         * @param yield 1 for a settlement, 2 for a city.
+         * @throws std::out_of_range if the game, node or seat is out of range.
+         */
+        void setBuilding(std::size_t game, std::size_t node, int seat, int yield);
+
+        /**
+         * @brief Move the robber of a game.
+         * @param game The game.
+         * @param terrain Index of the terrain.
+         * @throws std::out_of_range if the game or terrain is out of range.
+         */
+        void moveRobber(std::size_t game, int terrain);
+
+        /**
+         * @brief Compute the cards every player of every game collects.
+         * @param rolls The dice total of every game; games().
+         * @param deltas Receives the cards, deltaSize() bytes.
+         * @param kernel The implementation to run.
+         * @throws std::invalid_argument if a span is too small.
+         */
+        void produce(std::span<const std::uint8_t> rolls, std::span<std::uint8_t> deltas,
+                     ProductionKernel kernel = ProductionKernel::Auto) const;
+
+        /**
+         * @brief Get the cards a player of a game collected.
+         * @param deltas The output of produce().
+         * @param game The game.
+         * @param seat The seat of the player.
+         */
+        [[nodiscard]] ResourceCounts gainsOf(std::span<const std::uint8_t> deltas, std::size_t game, std::size_t seat) const;
+
+        /**
+         * @brief Check whether this build and CPU run the AVX2 kernel.
+         */
+        [[nodiscard]] static bool avx2Supported();
+    };
+
+} // namespace strategy
+
+#endif // PRODUCTION_BATCH_HPP
@@ -0,0 +1,95 @@
+#ifndef PRODUCTION_TABLE_HPP
+#define PRODUCTION_TABLE_HPP
+
+#include "BoardGraph.hpp"
+#include "ResourceType.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace strategy {
+
+    class Terrain;
+
+/**
+ * @class ProductionTable
+ * @brief The production data of a board in structure-of-arrays form.
+ *
+ * Resource, number token and robber flag of every terrain are kept in three separate
+ * byte arrays padded to a multiple of 32 lanes, and the owner seat and yield (1 for a
+ * settlement, 2 for a city) of every node in two more. The payout of a roll is then
+ * computed for all players at once without a single branch: one compare and mask over
+ * all terrains, followed by a fixed six corners per terrain adding yield times mask
+ * into a per-seat tally. Empty corners and padding lanes add into row 0 or column
+ * ResourceType::None of the tally, which are thrown away.
+ */
+    class ProductionTable {
+    public:
+        static constexpr std::size_t LANES = 32;    ///< Terrain slots, padded for 32-byte vectors.
+        static constexpr std::size_t MAX_SEATS = 8; ///< Most players a board can pay out to.
+
+    private:
+        static constexpr std::uint8_t NO_NODE = BoardGraph::MAX_NODES; ///< Corner padding; never has a building.
+
+        alignas(LANES) std::array<std::uint8_t, LANES> _resources{}; ///< ResourceType of every terrain.
+        alignas(LANES) std::array<std::uint8_t, LANES> _numbers{};   ///< Number token of every terrain, 0 for none.
+        alignas(LANES) std::array<std::uint8_t, LANES> _robbed{};    ///< 1 on the terrain holding the robber.
+        std::array<std::array<std::uint8_t, BoardGraph::TERRAIN_DEGREE>, LANES> _corners{}; ///< Corner nodes of every terrain.
+        std::array<std::uint8_t, BoardGraph::MAX_NODES + 1> _nodeSeats{};  ///< Owner seat + 1 of every node, 0 if empty.
+        std::array<std::uint8_t, BoardGraph::MAX_NODES + 1> _nodeYields{}; ///< Cards a node collects per production.
+        std::size_t _terrainCount = 0; ///< Terrains on the board.
+        int _robber = -1;              ///< Terrain holding the robber, or -1.
+
+    public:
+        /**
+         * @brief Copy the production data of the terrains and place the robber on the first desert.
+         * @param graph The compiled board graph.
+         * @param terrains The terrains, in board order.
+         */
+        void build(const BoardGraph &graph, std::span<Terrain *const> terrains);
+
+        /**
+         * @brief Record the building on a node.
+         * @param node Index of the node (id minus one).
+         * @param seat Seat of the owner.
+         * @param yield Cards collected per production: 1 for a settlement, 2 for a city.
+         * @throws std::out_of_range if the node or seat is not on the board.
+         */
+        void setBuilding(std::size_t node, int seat, int yield);
+
+        /**
+         * @brief Move the robber.
+         * @param terrain Index of the terrain the robber is moved to.
+         * @throws std::out_of_range if the terrain is not on the board.
+         */
+        void moveRobber(int terrain);
+
+        /**
+         * @brief Get the terrain holding the robber.
+         * @return Index of the terrain, or -1 if the board has no desert and the robber was never moved.
+         */
+        [[nodiscard]] int getRobber() const;
+
+        /**
+         * @brief Compute the cards every seat collects for a roll.
+         * @param roll The dice total.
+         * @param gains Filled with the cards of each seat; at most MAX_SEATS entries.
+         */
+        void produce(int roll, std::span<ResourceCounts> gains) const;
+
+        [[nodiscard]] std::size_t terrainCount() const { return _terrainCount; }
+        [[nodiscard]] ResourceType resource(std::size_t terrain) const { return static_cast<ResourceType>(_resources[terrain]); }
+        [[nodiscard]] int number(std::size_t terrain) const { return _numbers[terrain]; }
+        [[nodiscard]] bool robbed(std::size_t terrain) const { return _robbed[terrain] != 0; }
+        /// Corner node indices of a terrain, padded with BoardGraph::MAX_NODES.
+        [[nodiscard]] const std::array<std::uint8_t, BoardGraph::TERRAIN_DEGREE> &corners(std::size_t terrain) const { return _corners[terrain]; }
+        /// Seat of the owner of a node, or -1 if the node is empty.
+        [[nodiscard]] int nodeSeat(std::size_t node) const { return _nodeSeats[node] - 1; }
+        /// Cards a node collects per production: 0 if empty, 1 for a settlement, 2 for a city.
+        [[nodiscard]] int nodeYield(std::size_t node) const { return _nodeYields[node]; }
+    };
+
+} // namespace strategy
+
+#endif // PRODUCTION_TABLE_HPP
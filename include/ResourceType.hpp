@@ -0,0 +1,130 @@
+#ifndef RESOURCE_TYPE_HPP
+#define RESOURCE_TYPE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace strategy {
+
+/**
+ * @enum ResourceType
+ * @brief Index of every resource a terrain can produce.
+ *
+ * The order is alphabetical so that iterating over a hand visits the resources
+ * in the same order as the name-keyed maps used by earlier versions of the game.
+ */
+    enum class ResourceType : std::uint8_t {
+        Brick = 0,
+        Grain,
+        Lumber,
+        Ore,
+        Wool,
+        None  ///< Desert or unknown resource.
+    };
+
+    constexpr std::size_t RESOURCE_TYPE_COUNT = 5; ///< Number of real resource types (None excluded).
+
+/**
+ * @struct ResourceCounts
+ * @brief A fixed-size count vector of resource cards, indexed by ResourceType.
+ *
+ * Used for player hands, building costs and discards so that hot paths work on
+ * five integers instead of string-keyed map lookups.
+ */
+    struct ResourceCounts {
+        std::array<int, RESOURCE_TYPE_COUNT> counts{}; ///< Card count per resource type.
+
+        constexpr int &operator[](ResourceType type) { return counts[static_cast<std::size_t>(type)]; }
+
+        constexpr int operator[](ResourceType type) const { return counts[static_cast<std::size_t>(type)]; }
+
+        constexpr int &operator[](std::size_t index) { return counts[index]; }
+
+        constexpr int operator[](std::size_t index) const { return counts[index]; }
+
+        /**
+         * @brief Total number of cards over all resource types.
+         */
+        [[nodiscard]] constexpr int total() const {
+            int sum = 0;
+            for (int c : counts) sum += c;
+            return sum;
+        }
+
+        /**
+         * @brief Check whether these counts cover another count vector element-wise.
+         * @param cost The counts that must be available.
+         * @return True if every entry is at least the matching entry of cost.
+         */
+        [[nodiscard]] constexpr bool covers(const ResourceCounts &cost) const {
+            for (std::size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i) {
+                if (counts[i] < cost.counts[i]) return false;
+            }
+            return true;
+        }
+
+        constexpr ResourceCounts &operator+=(const ResourceCounts &other) {
+            for (std::size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i) counts[i] += other.counts[i];
+            return *this;
+        }
+
+        constexpr ResourceCounts &operator-=(const ResourceCounts &other) {
+            for (std::size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i) counts[i] -= other.counts[i];
+            return *this;
+        }
+
+        bool operator==(const ResourceCounts &other) const { return counts == other.counts; }
+
+        bool operator!=(const ResourceCounts &other) const { return !(*this == other); }
+    };
+
+/**
+ * @enum HarborType
+ * @brief The kind of harbor a coastal node gives access to.
+ *
+ * A generic harbor allows 3:1 trades with the bank for any resource, while a
+ * resource harbor allows 2:1 trades for its own resource only.
+ */
+    enum class HarborType : std::uint8_t {
+        None = 0,
+        Generic,
+        Brick,
+        Grain,
+        Lumber,
+        Ore,
+        Wool
+    };
+
+/**
+ * @brief Get the resource traded at a 2:1 resource harbor.
+ * @param harbor The harbor type.
+ * @return The harbor's resource, or ResourceType::None for generic harbors and non-harbors.
+ */
+    constexpr ResourceType harborResource(HarborType harbor) {
+        return harbor >= HarborType::Brick
+               ? static_cast<ResourceType>(static_cast<std::uint8_t>(harbor) - static_cast<std::uint8_t>(HarborType::Brick))
+               : ResourceType::None;
+    }
+
+/**
+ * @brief Get the display name of a resource type (e.g. "Lumber").
+ * @param type The resource type.
+ * @return The resource name, or "Desert" for ResourceType::None.
+ */
+    const std::string &resourceName(ResourceType type);
+
+/**
+ * @brief Map a resource name to its type.
+ *
+ * Accepts both the plain names ("Brick") and the card names ("BrickCard").
+ *
+ * @param name The resource or card name.
+ * @return The matching resource type, or ResourceType::None if unknown.
+ */
+    ResourceType resourceFromName(const std::string &name);
+
+} // namespace strategy
+
+#endif // RESOURCE_TYPE_HPP
@@ -0,0 +1,105 @@
+#ifndef SPECTATOR_WALL_HPP
+#define SPECTATOR_WALL_HPP
+
+#include "BoardLayout.hpp"
+#include "BoardSnapshot.hpp"
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @struct WallVertex
+ * @brief A corner of a triangle of the spectator wall.
+ */
+    struct WallVertex {
+        Point position; ///< Position on the wall, in pixels.
+        Rgba color;     ///< Color; transparent for a piece that is not on the board.
+    };
+
+/**
+ * @struct WallOptions
+ * @brief Settings of the spectator wall.
+ */
+    struct WallOptions {
+        std::size_t columns = 8;   ///< Boards per row of the wall.
+        float tileWidth = 200.0f;  ///< Width of a board on the wall, in pixels.
+        float tileHeight = 150.0f; ///< Height of a board on the wall, in pixels.
+    };
+
+/**
+ * @class SpectatorWall
+ * @brief Tiles many live boards into one triangle list, drawn in a single call.
+ *
+ * Every board gets the same fixed run of vertices: a hexagon per terrain, a marker per
+ * terrain for the robber, a bar per pathway and a settlement and a city per node, placed
+ * once from the shared BoardLayout of a tile and offset to the board's tile. Only the colors
+ * are per-board data: a piece that is not there is transparent. refresh() polls the feeds of
+ * the boards, which the games publish from their own threads without locks, and recolors
+ * only the tiles whose board changed, so the cost of a frame follows the number of changes
+ * rather than the number of boards. Use a wall from one thread.
+ */
+    class SpectatorWall {
+    public:
+        static constexpr std::size_t TERRAIN_VERTICES = BoardGraph::MAX_TERRAINS * 6 * 3; ///< Hexagon fans.
+        static constexpr std::size_t ROBBER_VERTICES = BoardGraph::MAX_TERRAINS * 2 * 3;  ///< Diamond per terrain.
+        static constexpr std::size_t ROAD_VERTICES = BoardGraph::MAX_PATHWAYS * 2 * 3;    ///< Bar per pathway.
+        static constexpr std::size_t BUILDING_VERTICES = BoardGraph::MAX_NODES * 2 * 3 * 3; ///< Settlement and city per node.
+        static constexpr std::size_t VERTICES_PER_TILE = TERRAIN_VERTICES + ROBBER_VERTICES + ROAD_VERTICES + BUILDING_VERTICES;
+
+    private:
+        WallOptions _options;              ///< Settings.
+        std::vector<BoardFeed *> _feeds;   ///< Feed of every board, in tile order.
+        std::vector<WallVertex> _vertices; ///< Triangles of every tile, VERTICES_PER_TILE each.
+        std::vector<std::size_t> _changed; ///< Tiles recolored by the last refresh.
+
+        void recolor(std::size_t tile, const BoardSnapshot &snapshot);
+
+    public:
+        /**
+         * @brief Constructor laying out a tile per board.
+         * @param graph The adjacency shared by all the boards.
+         * @param feeds The feed of every board; each must outlive the wall.
+         * @param options Settings.
+         * @throws std::invalid_argument if there are no columns or a tile has no area.
+         */
+        SpectatorWall(const BoardGraph &graph, std::vector<BoardFeed *> feeds, WallOptions options = {});
+
+        /**
+         * @brief Get the number of boards on the wall.
+         */
+        [[nodiscard]] std::size_t boardCount() const;
+
+        /**
+         * @brief Get the width of the wall in pixels.
+         */
+        [[nodiscard]] float width() const;
+
+        /**
+         * @brief Get the height of the wall in pixels.
+         */
+        [[nodiscard]] float height() const;
+
+        /**
+         * @brief Poll every feed and recolor the tiles of the boards that changed.
+         * @return The tiles recolored, in increasing order.
+         */
+        const std::vector<std::size_t> &refresh();
+
+        /**
+         * @brief Get the triangles of the whole wall.
+         */
+        [[nodiscard]] std::span<const WallVertex> vertices() const;
+
+        /**
+         * @brief Get the triangles of one board.
+         * @param index The tile of the board.
+         * @throws std::out_of_range if there is no such tile.
+         */
+        [[nodiscard]] std::span<const WallVertex> tile(std::size_t index) const;
+    };
+
+} // namespace strategy
+
+#endif // SPECTATOR_WALL_HPP
@@ -0,0 +1,128 @@
+#ifndef STATE_DELTA_HPP
+#define STATE_DELTA_HPP
+
+#include "BoardSnapshot.hpp"
+#include "DevelopmentCard.hpp"
+#include "ProductionTable.hpp"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace strategy {
+
+/**
+ * @struct GameState
+ * @brief Everything a client needs to follow a game: the pieces on the board and every seat's cards.
+ */
+    struct GameState {
+        static constexpr std::size_t MAX_SEATS = ProductionTable::MAX_SEATS; ///< Seats a state holds.
+
+        BoardSnapshot board;                                                        ///< Terrains, robber, buildings and roads.
+        std::array<ResourceCounts, MAX_SEATS> hands{};                              ///< Resource cards of every seat.
+        std::array<std::array<std::uint8_t, game::DEV_CARD_TYPE_COUNT>, MAX_SEATS> devCards{}; ///< Development cards of every seat, per type.
+
+        bool operator==(const GameState &other) const = default;
+    };
+
+/**
+ * @brief Copy the board and the cards of its players.
+ * @param board The board.
+ * @param players The players, indexed by seat; at most GameState::MAX_SEATS.
+ * @param state Output; the seats past the players are cleared, the board version is kept.
+ */
+    void captureState(BoardView board, std::span<game::Player *const> players, GameState &state);
+
+/**
+ * @brief Append the changes between two states as one bit-packed delta record.
+ *
+ * A record holds the robber if it moved, the nodes and pathways whose owner changed, and for
+ * every seat whose cards changed the signed change of each resource and development card
+ * count. Fields are packed LSB first with the fewest bits their range needs and the record
+ * is padded to a whole byte, so records can be concatenated into a stream. An unchanged state
+ * takes 3 bytes; a typical action takes 4 to 8. Terrains and numbers never change and are not
+ * encoded.
+ *
+ * @param before The state the reader has.
+ * @param after The state to bring the reader to.
+ * @param out The buffer to append to.
+ * @return The number of bytes appended.
+ */
+    std::size_t encodeDelta(const GameState &before, const GameState &after, std::vector<std::uint8_t> &out);
+
+/**
+ * @brief Apply a record written by encodeDelta() and advance the read position.
+ * @param pos The read position; advanced past the record on success.
+ * @param end One past the last readable byte.
+ * @param state The state to update; left untouched on failure.
+ * @return True on success, false if the record is truncated or holds an out-of-range field.
+ */
+    bool applyDelta(const std::uint8_t *&pos, const std::uint8_t *end, GameState &state);
+
+/**
+ * @class DeltaStream
+ * @brief Observer encoding a delta record after every action played on a board.
+ *
+ * A Roll is published before the production it causes, see GameObserver; call append() at the
+ * end of a turn, or after a roll, to send the cards it paid out without waiting for the next
+ * action. A reader starting from initial() and applying the records in order reaches state().
+ */
+    class DeltaStream : public GameObserver {
+    private:
+        GameBoard &_board;                 ///< The board followed.
+        GameState _initial;                ///< State when the stream started.
+        GameState _state;                  ///< State after the last record.
+        GameState _next;                   ///< Scratch state captured for the next record.
+        std::vector<std::uint8_t> _bytes;  ///< Records appended so far.
+
+    public:
+        /**
+         * @brief Constructor capturing the board and its registered players and following them from now on.
+         * @param board The board; must outlive the stream.
+         */
+        explicit DeltaStream(GameBoard &board);
+
+        /**
+         * @brief Destructor unregistering from the board.
+         */
+        ~DeltaStream() override;
+
+        DeltaStream(const DeltaStream &) = delete;
+        DeltaStream &operator=(const DeltaStream &) = delete;
+
+        /**
+         * @brief Capture the board and append the record of what changed since the last one.
+         * @return The number of bytes appended.
+         */
+        std::size_t append();
+
+        /**
+         * @brief Append a record for the action.
+         * @param action The action that took place.
+         */
+        void onAction(const GameAction &action) override;
+
+        /**
+         * @brief Get the state the stream started from.
+         */
+        [[nodiscard]] const GameState &initial() const;
+
+        /**
+         * @brief Get the state after the last record.
+         */
+        [[nodiscard]] const GameState &state() const;
+
+        /**
+         * @brief Get the records appended so far.
+         */
+        [[nodiscard]] std::span<const std::uint8_t> bytes() const;
+
+        /**
+         * @brief Drop the records appended so far, e.g. once they were sent; state() is kept.
+         */
+        void clear();
+    };
+
+} // namespace strategy
+
+#endif // STATE_DELTA_HPP
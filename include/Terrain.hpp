@@ -18,11 +18,14 @@ namespace strategy {
     class Terrain {
     private:
         string _resource;     ///< The type of resource the terrain produces (e.g., "Lumber", "Grain")
-        int _id;              ///< Unique identifier for the terrain
-        int _terrainNum;      ///< Number associated with the terrain (e.g., 2, 3, ..., 12)
+        ResourceType _type = ResourceType::None; ///< The resource the terrain produces, None for the desert
+        int _id = 0;          ///< Unique identifier for the terrain
+        int _terrainNum = 0;  ///< Number associated with the terrain (e.g., 2, 3, ..., 12)
         vector<Pathway> _pathways;  ///< Pathways associated with the terrain
-        ResourceCard *_card;  ///< Pointer to a ResourceCard representing the resource
-        vector<Node *> _nodes = {3, nullptr}; ///< Nodes located on the vertices of the terrain
+        ResourceCard *_card = nullptr; ///< The resource card handed out by the terrain, null for the desert
+        vector<Node *> _nodes = {3, nullptr}; ///< Corner nodes set before the graph is built; emptied afterwards
+        const BoardGraph *_graph = nullptr; ///< The board graph, once built
+        std::uint8_t _index = 0; ///< Index of this terrain in the board graph
 
     public:
         /**
@@ -47,9 +50,15 @@ namespace strategy {
 
         /**
          * @brief Returns the name of the resource produced by the terrain.
-         * @return The resource name as a string.
+         * @return The resource name, owned by the terrain.
          */
-        string getResourceName();
+        [[nodiscard]] const string &getResourceName() const;
+
+        /**
+         * @brief Returns the resource produced by the terrain.
+         * @return The resource type, or ResourceType::None for the desert.
+         */
+        [[nodiscard]] ResourceType getResourceType() const;
 
         /**
          * @brief Displays information about the terrain.
@@ -64,9 +73,16 @@ namespace strategy {
 
         /**
          * @brief Returns the nodes associated with the terrain.
-         * @return A vector of pointers to Node objects.
+         * @return A view of the Node pointers on the corners of the terrain; nothing is copied.
+         */
+        [[nodiscard]] GraphRange<Node> getNodes() const;
+
+        /**
+         * @brief Read the corner nodes from the board graph from now on.
+         * @param graph The compiled board graph.
+         * @param index The index of this terrain in the graph.
          */
-        vector<Node *> getNodes();
+        void attachGraph(const BoardGraph *graph, std::uint8_t index);
 
         /**
          * @brief Returns the unique identifier of the terrain.
@@ -76,9 +92,9 @@ namespace strategy {
 
         /**
          * @brief Returns the card representing the resource on the terrain.
-         * @return A pointer to a ResourceCard object.
+         * @return A pointer to a ResourceCard object, or nullptr for the desert.
          */
-        ResourceCard *getCard();
+        [[nodiscard]] ResourceCard *getCard() const;
 
         /**
          * @brief Returns the number associated with the terrain.
@@ -89,6 +105,7 @@ namespace strategy {
         /**
          * @brief Sets the number associated with the terrain.
          * @param n The number to set.
+         * @throws std::logic_error once the board graph is built.
          */
         void setTerrainNum(int n);
     };
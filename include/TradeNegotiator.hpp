@@ -0,0 +1,166 @@
+#ifndef TRADE_NEGOTIATOR_HPP
+#define TRADE_NEGOTIATOR_HPP
+
+#include "ResourceType.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace game {
+
+    class Player;
+
+/**
+ * @struct TradeOffer
+ * @brief A proposed exchange of resources, seen from the proposing player's side.
+ */
+    struct TradeOffer {
+        strategy::ResourceCounts give;    ///< Cards the proposer hands over.
+        strategy::ResourceCounts receive; ///< Cards the proposer asks for in return.
+    };
+
+/**
+ * @enum TradeReply
+ * @brief How a participant answers a trade offer.
+ */
+    enum class TradeReply : std::uint8_t {
+        Reject,
+        Accept,
+        Counter
+    };
+
+/**
+ * @struct TradeResponse
+ * @brief A participant's answer to an offer, with the counter-offer if any.
+ */
+    struct TradeResponse {
+        TradeReply reply = TradeReply::Reject; ///< The participant's answer.
+        TradeOffer counter;                    ///< Counter-offer, from the proposer's side; valid if reply is Counter.
+    };
+
+/**
+ * @struct TradeResult
+ * @brief The outcome of a negotiation.
+ */
+    struct TradeResult {
+        bool completed = false;   ///< True if a trade was executed.
+        Player *partner = nullptr; ///< The participant the trade was executed with.
+        TradeOffer executed;      ///< The offer that was executed, from the proposer's side.
+    };
+
+    using ResourceWeights = std::array<float, strategy::RESOURCE_TYPE_COUNT>; ///< Value of one card per resource type.
+
+/**
+ * @class OfferBatch
+ * @brief Candidate offers stored resource-major, so that many offers are scored in one pass.
+ */
+    class OfferBatch {
+    private:
+        std::array<std::vector<std::int16_t>, strategy::RESOURCE_TYPE_COUNT> _give;    ///< Given cards per resource, per offer.
+        std::array<std::vector<std::int16_t>, strategy::RESOURCE_TYPE_COUNT> _receive; ///< Received cards per resource, per offer.
+        std::size_t _size = 0; ///< Number of offers in the batch.
+
+    public:
+        /**
+         * @brief Append an offer to the batch.
+         * @param offer The offer, from the proposer's side.
+         */
+        void add(const TradeOffer &offer);
+
+        /**
+         * @brief Remove all offers from the batch, keeping the allocated storage.
+         */
+        void clear();
+
+        /**
+         * @brief Get the offer at the given position.
+         * @param index The position of the offer.
+         * @return The offer, from the proposer's side.
+         */
+        [[nodiscard]] TradeOffer at(std::size_t index) const;
+
+        /**
+         * @brief Get the number of offers in the batch.
+         */
+        [[nodiscard]] std::size_t size() const;
+
+        /**
+         * @brief Score every offer for a player holding the given hand.
+         *
+         * The score is the weighted value of the received cards minus that of the given cards.
+         * Offers the hand cannot pay for score -infinity.
+         *
+         * @param hand The resource counts of the player evaluating the offers.
+         * @param weights The value of one card of each resource for that player.
+         * @param scores Output, resized to one score per offer.
+         */
+        void score(const strategy::ResourceCounts &hand, const ResourceWeights &weights, std::vector<float> &scores) const;
+    };
+
+/**
+ * @class TradePolicy
+ * @brief Abstract policy answering trade offers on behalf of a (bot) participant.
+ */
+    class TradePolicy {
+    public:
+        /**
+         * @brief Virtual destructor for TradePolicy.
+         */
+        virtual ~TradePolicy();
+
+        /**
+         * @brief Answer a trade offer.
+         * @param responder The participant being asked.
+         * @param proposer The participant who made the offer.
+         * @param offer The offer, from the proposer's side.
+         * @return The answer, with a counter-offer if the reply is Counter.
+         */
+        virtual TradeResponse respond(const Player &responder, const Player &proposer, const TradeOffer &offer) = 0;
+    };
+
+/**
+ * @class ValueTradePolicy
+ * @brief Accepts offers that raise the weighted value of the hand, where scarce resources weigh more.
+ *
+ * An offer that is slightly unfavourable is countered by asking one more card of
+ * the resource the responder lacks most.
+ */
+    class ValueTradePolicy : public TradePolicy {
+    public:
+        TradeResponse respond(const Player &responder, const Player &proposer, const TradeOffer &offer) override;
+    };
+
+/**
+ * @class TradeNegotiator
+ * @brief Posts an offer to every other participant and executes the best answer atomically.
+ */
+    class TradeNegotiator {
+    public:
+        /**
+         * @brief Compute the value of one card of each resource for a hand.
+         *
+         * The value of a resource decreases with the number of cards of it already held.
+         *
+         * @param hand The resource counts.
+         * @return The weight of each resource type.
+         */
+        static ResourceWeights resourceWeights(const strategy::ResourceCounts &hand);
+
+        /**
+         * @brief Offer a trade to all other participants of the proposer.
+         *
+         * Participants answer through their trade policies; participants without a policy
+         * reject. The first acceptance that both sides can pay for is executed. If nobody
+         * accepts, the counter-offers are scored in one batch with the proposer's weights
+         * and the best favourable one is executed.
+         *
+         * @param proposer The player making the offer.
+         * @param offer The offer, from the proposer's side.
+         * @return The outcome of the negotiation.
+         */
+        static TradeResult negotiate(Player &proposer, const TradeOffer &offer);
+    };
+
+} // namespace game
+
+#endif // TRADE_NEGOTIATOR_HPP
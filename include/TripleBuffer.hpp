@@ -0,0 +1,69 @@
+#ifndef TRIPLE_BUFFER_HPP
+#define TRIPLE_BUFFER_HPP
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+namespace strategy {
+
+/**
+ * @class TripleBuffer
+ * @brief Hands the latest value from one producer thread to one consumer thread without locks.
+ *
+ * The producer fills the back slot and publishes it; the consumer takes the most recently
+ * published slot as its front. Neither side ever waits: the producer never overwrites the
+ * slot being read, and a consumer that is slower than the producer simply skips the values
+ * it did not get to. Each slot sits on its own cache line.
+ *
+ * @tparam T The value handed over; copied by the producer into the back slot.
+ */
+    template<typename T>
+    class TripleBuffer {
+    private:
+        static constexpr std::uint8_t INDEX = 0x3; ///< Bits of the middle word holding a slot index.
+        static constexpr std::uint8_t FRESH = 0x4; ///< Set while the middle slot has not been taken.
+
+        struct alignas(64) Slot {
+            T value{};
+        };
+
+        std::array<Slot, 3> _slots{};
+        alignas(64) std::atomic<std::uint8_t> _middle{1}; ///< Slot between the two sides, with the FRESH bit.
+        alignas(64) std::uint8_t _back = 0;               ///< Slot owned by the producer.
+        alignas(64) std::uint8_t _front = 2;              ///< Slot owned by the consumer.
+
+    public:
+        /**
+         * @brief Get the slot the producer fills next.
+         */
+        T &back() { return _slots[_back].value; }
+
+        /**
+         * @brief Make the back slot the latest value and take another slot to fill; producer only.
+         */
+        void publish() {
+            _back = _middle.exchange(static_cast<std::uint8_t>(_back | FRESH), std::memory_order_acq_rel) & INDEX;
+        }
+
+        /**
+         * @brief Take the latest published value as the front, if there is a new one; consumer only.
+         * @return True if the front changed.
+         */
+        bool update() {
+            if (!(_middle.load(std::memory_order_relaxed) & FRESH)) {
+                return false;
+            }
+            _front = _middle.exchange(_front, std::memory_order_acq_rel) & INDEX;
+            return true;
+        }
+
+        /**
+         * @brief Get the value the consumer took last; consumer only.
+         */
+        const T &front() const { return _slots[_front].value; }
+    };
+
+} // namespace strategy
+
+#endif // TRIPLE_BUFFER_HPP
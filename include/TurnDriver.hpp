@@ -0,0 +1,194 @@
+#ifndef TURN_DRIVER_HPP
+#define TURN_DRIVER_HPP
+
+#include "BoardView.hpp"
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <optional>
+
+namespace strategy {
+
+/**
+ * @struct SimulationResult
+ * @brief The outcome of a simulated game.
+ */
+    struct SimulationResult {
+        int winnerSeat = -1; ///< Seat of the winner, or -1 if the turn limit was reached first.
+        int turns = 0;       ///< Number of turns played after the setup phase.
+    };
+
+/**
+ * @enum MoveType
+ * @brief What a player can decide to do after rolling.
+ */
+    enum class MoveType : std::uint8_t {
+        BuildPathway,        ///< id: pathway id
+        BuildSettlement,     ///< id: node id
+        UpgradeToCity,       ///< id: node id
+        BuyDevelopmentCard,  ///< id unused
+        TradeWithBank,       ///< id: resource given, target: resource received
+        PlayDevelopmentCard, ///< id: DevCardType of the card
+        EndTurn              ///< id unused
+    };
+
+/**
+ * @struct Move
+ * @brief One decision of a player during its turn.
+ */
+    struct Move {
+        MoveType type = MoveType::EndTurn; ///< The kind of move.
+        int id = 0;                        ///< Pathway, node, resource or card the move is about.
+        int target = 0;                    ///< Resource received in a bank trade.
+    };
+
+/**
+ * @brief Pick the move of a greedy bot: upgrade a city, else build a settlement, else a road,
+ * else trade the most plentiful resource for a missing one, else buy a development card, else
+ * play one, else end the turn.
+ * @param board The board the bot plays on.
+ * @param player The player, whose turn it is.
+ * @return The first affordable move in that order; roads stop at GreedyAgent::MAX_PATHWAYS.
+ */
+    Move greedyMove(BoardView board, game::Player &player);
+
+/**
+ * @brief Make a move for a player, if it is legal and affordable.
+ * @param player The player, whose turn it is.
+ * @param move The move.
+ * @return True if the move changed the game, false if it was ignored or ends the turn.
+ */
+    bool applyMove(game::Player &player, Move move);
+
+/**
+ * @class PlayerAgent
+ * @brief Makes the decisions of one seat for the coroutine turn driver.
+ *
+ * decide() answers at once for a bot. An agent that has to wait, for a network client or a
+ * human, returns std::nullopt instead: the game then suspends until the move is handed to
+ * deliver(), which resumes it on the caller's thread up to its next suspension.
+ */
+    class PlayerAgent {
+    private:
+        std::coroutine_handle<> _waiting;  ///< Game suspended on this agent, if any.
+        std::optional<Move> _delivered;    ///< Move handed to deliver(), until the game takes it.
+
+        friend struct MoveRequest;
+
+    public:
+        virtual ~PlayerAgent();
+
+        /**
+         * @brief Decide the next move of a player.
+         * @param player The player, whose turn it is.
+         * @param turn The number of the turn.
+         * @return The move, or std::nullopt to suspend the game until deliver() is called.
+         */
+        virtual std::optional<Move> decide(game::Player &player, int turn) = 0;
+
+        /**
+         * @brief Check whether a game is suspended waiting for a move from this agent.
+         */
+        [[nodiscard]] bool waiting() const;
+
+        /**
+         * @brief Hand the move a suspended game waits for and resume the game.
+         * @param move The move.
+         * @throws std::logic_error if no game waits for this agent.
+         */
+        void deliver(Move move);
+    };
+
+/**
+ * @struct MoveRequest
+ * @brief Awaitable asking an agent for a move; completes without suspending when the agent decides at once.
+ *
+ * A game destroyed while it waits stops waiting, so a later deliver() does not resume it.
+ */
+    struct MoveRequest {
+        PlayerAgent &agent;                ///< Agent asked.
+        game::Player &player;              ///< Player on turn.
+        int turn;                          ///< Number of the turn.
+        std::optional<Move> move;          ///< The answer.
+        std::coroutine_handle<> suspended; ///< The game, while it waits for the agent.
+
+        MoveRequest(PlayerAgent &asked, game::Player &onTurn, int turnNumber);
+        ~MoveRequest();
+        MoveRequest(const MoveRequest &) = delete;
+        MoveRequest &operator=(const MoveRequest &) = delete;
+
+        bool await_ready();
+        void await_suspend(std::coroutine_handle<> game);
+        Move await_resume();
+    };
+
+/**
+ * @class GreedyAgent
+ * @brief Bot deciding at once with greedyMove().
+ */
+    class GreedyAgent : public PlayerAgent {
+    private:
+        BoardView _board; ///< Board the bot plays on.
+
+    public:
+        static constexpr int MAX_PATHWAYS = 15; ///< Roads the bot builds at most.
+
+        /**
+         * @brief Constructor.
+         * @param board The board the bot plays on.
+         */
+        explicit GreedyAgent(BoardView board);
+
+        /**
+         * @brief Pick the greedy move of the player.
+         */
+        std::optional<Move> decide(game::Player &player, int) override;
+    };
+
+/**
+ * @class GameTask
+ * @brief A game played by a coroutine; owns the coroutine and destroys it with the task.
+ *
+ * The game starts running when the task is created and runs until an agent makes it wait or
+ * the game ends.
+ */
+    class GameTask {
+    public:
+        struct promise_type {
+            SimulationResult result;
+            std::exception_ptr error;
+
+            GameTask get_return_object();
+            std::suspend_never initial_suspend() noexcept { return {}; }
+            std::suspend_always final_suspend() noexcept { return {}; }
+            void return_value(SimulationResult value);
+            void unhandled_exception();
+        };
+
+    private:
+        std::coroutine_handle<promise_type> _handle; ///< The game.
+
+        explicit GameTask(std::coroutine_handle<promise_type> handle);
+
+    public:
+        GameTask(GameTask &&other) noexcept;
+        GameTask &operator=(GameTask &&other) noexcept;
+        GameTask(const GameTask &) = delete;
+        GameTask &operator=(const GameTask &) = delete;
+        ~GameTask();
+
+        /**
+         * @brief Check whether the game ended.
+         */
+        [[nodiscard]] bool done() const;
+
+        /**
+         * @brief Get the outcome of the game.
+         * @throws std::logic_error if the game did not end yet, or what the game threw.
+         */
+        [[nodiscard]] SimulationResult result() const;
+    };
+
+} // namespace strategy
+
+#endif // TURN_DRIVER_HPP
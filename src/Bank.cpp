@@ -0,0 +1,52 @@
+#include "Bank.hpp"
+#include <algorithm>
+
+namespace strategy {
+
+// Constructor fills the supply of every resource
+    Bank::Bank() {
+        _supply.counts.fill(CARDS_PER_RESOURCE);
+    }
+
+// Get the remaining supply of a resource
+    int Bank::supply(ResourceType type) const {
+        return _supply[type];
+    }
+
+// Get the supply of every resource
+    const ResourceCounts &Bank::getSupply() const {
+        return _supply;
+    }
+
+// Check whether the supply covers a request
+    bool Bank::canWithdraw(const ResourceCounts &cards) const {
+        return _supply.covers(cards);
+    }
+
+// Hand out up to `amount` cards of a resource
+    int Bank::withdraw(ResourceType type, int amount) {
+        int handedOut = std::clamp(amount, 0, _supply[type]);
+        _supply[type] -= handedOut;
+        return handedOut;
+    }
+
+// Hand out a set of cards, all or nothing
+    bool Bank::withdraw(const ResourceCounts &cards) {
+        if (!_supply.covers(cards)) {
+            return false;
+        }
+        _supply -= cards;
+        return true;
+    }
+
+// Return cards to the bank
+    void Bank::deposit(const ResourceCounts &cards) {
+        _supply += cards;
+    }
+
+// Return cards of a single resource to the bank
+    void Bank::deposit(ResourceType type, int amount) {
+        _supply[type] += amount;
+    }
+
+} // namespace strategy
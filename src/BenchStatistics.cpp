@@ -0,0 +1,119 @@
+#include "BenchStatistics.hpp"
+#include <cmath>
+
+namespace strategy {
+
+    namespace {
+
+        // Mean and sample variance of a set of times
+        struct Summary {
+            double mean = 0.0;
+            double variance = 0.0;
+            std::size_t count = 0;
+        };
+
+        Summary summarize(const std::vector<double> &values) {
+            Summary summary;
+            summary.count = values.size();
+            for (double v : values) summary.mean += v;
+            summary.mean /= static_cast<double>(values.size());
+            for (double v : values) summary.variance += (v - summary.mean) * (v - summary.mean);
+            summary.variance = values.size() > 1 ? summary.variance / static_cast<double>(values.size() - 1) : 0.0;
+            return summary;
+        }
+
+        // Continued fraction of the regularized incomplete beta function
+        double betaContinuedFraction(double a, double b, double x) {
+            const double tiny = 1e-300;
+            double c = 1.0, d = 1.0 - (a + b) * x / (a + 1.0);
+            d = 1.0 / (std::fabs(d) < tiny ? tiny : d);
+            double result = d;
+            for (int m = 1; m <= 300; ++m) {
+                double m2 = 2.0 * m;
+                double numerator = m * (b - m) * x / ((a + m2 - 1.0) * (a + m2));
+                d = 1.0 + numerator * d;
+                c = 1.0 + numerator / c;
+                d = 1.0 / (std::fabs(d) < tiny ? tiny : d);
+                c = std::fabs(c) < tiny ? tiny : c;
+                result *= d * c;
+                numerator = -(a + m) * (a + b + m) * x / ((a + m2) * (a + m2 + 1.0));
+                d = 1.0 + numerator * d;
+                c = 1.0 + numerator / c;
+                d = 1.0 / (std::fabs(d) < tiny ? tiny : d);
+                c = std::fabs(c) < tiny ? tiny : c;
+                double delta = d * c;
+                result *= delta;
+                if (std::fabs(delta - 1.0) < 1e-12) break;
+            }
+            return result;
+        }
+
+        double incompleteBeta(double a, double b, double x) {
+            if (x <= 0.0) return 0.0;
+            if (x >= 1.0) return 1.0;
+            double front = std::exp(std::lgamma(a + b) - std::lgamma(a) - std::lgamma(b) + a * std::log(x) + b * std::log(1.0 - x));
+            if (x < (a + 1.0) / (a + b + 2.0)) {
+                return front * betaContinuedFraction(a, b, x) / a;
+            }
+            return 1.0 - front * betaContinuedFraction(b, a, 1.0 - x) / b;
+        }
+
+    } // namespace
+
+// Two-sided p-value of Student's t distribution
+    double twoSidedPValue(double t, double degreesOfFreedom) {
+        return incompleteBeta(degreesOfFreedom / 2.0, 0.5, degreesOfFreedom / (degreesOfFreedom + t * t));
+    }
+
+// Critical value of Student's t distribution for a two-sided confidence level, by bisection
+    double criticalValue(double alpha, double degreesOfFreedom) {
+        double low = 0.0, high = 1000.0;
+        for (int i = 0; i < 100; ++i) {
+            double mid = (low + high) / 2.0;
+            (twoSidedPValue(mid, degreesOfFreedom) > alpha ? low : high) = mid;
+        }
+        return (low + high) / 2.0;
+    }
+
+// Welch's t-test on the difference of means, with Welch-Satterthwaite degrees of freedom
+    BenchComparison compareBenchmarks(const std::vector<double> &baseline, const std::vector<double> &candidate,
+                                      double threshold, double alpha) {
+        BenchComparison result;
+        if (baseline.empty() || candidate.empty()) {
+            return result;
+        }
+        Summary base = summarize(baseline);
+        Summary cand = summarize(candidate);
+        result.baselineMean = base.mean;
+        result.candidateMean = cand.mean;
+
+        double baseError = base.variance / static_cast<double>(base.count);
+        double candError = cand.variance / static_cast<double>(cand.count);
+        double standardError = std::sqrt(baseError + candError);
+        double difference = cand.mean - base.mean;
+        double margin = 0.0;
+        if (base.count > 1 && cand.count > 1 && standardError > 0.0) {
+            double dof = (baseError + candError) * (baseError + candError) /
+                         (baseError * baseError / static_cast<double>(base.count - 1) +
+                          candError * candError / static_cast<double>(cand.count - 1));
+            result.p = twoSidedPValue(difference / standardError, dof);
+            margin = criticalValue(alpha, dof) * standardError;
+        }
+
+        result.change = difference / base.mean;
+        result.low = (difference - margin) / base.mean;
+        result.high = (difference + margin) / base.mean;
+        bool significant = result.p < alpha;
+        if (significant && result.change > threshold) {
+            result.verdict = BenchVerdict::Slower;
+        } else if (significant && result.change < -threshold) {
+            result.verdict = BenchVerdict::Faster;
+        } else if (base.count < 2 || cand.count < 2) {
+            result.verdict = BenchVerdict::NeedRepetitions;
+        } else {
+            result.verdict = BenchVerdict::Same;
+        }
+        return result;
+    }
+
+} // namespace strategy
@@ -0,0 +1,79 @@
+#include "BoardGraph.hpp"
+#include "Node.hpp"
+#include "Terrain.hpp"
+#include <algorithm>
+#include <stdexcept>
+
+namespace strategy {
+
+// {0, 1, ..., 255}
+    static std::array<std::uint8_t, 256> makeIdentity() {
+        std::array<std::uint8_t, 256> identity{};
+        for (std::size_t i = 0; i < identity.size(); ++i) {
+            identity[i] = static_cast<std::uint8_t>(i);
+        }
+        return identity;
+    }
+
+    const std::array<std::uint8_t, 256> BoardGraph::IDENTITY = makeIdentity();
+
+// Find the index of a board object in its table
+    template<typename T>
+    static std::uint8_t indexOf(const std::vector<T *> &table, const T *item) {
+        auto it = std::find(table.begin(), table.end(), item);
+        if (it == table.end()) {
+            throw std::logic_error("Error: The board refers to an object that is not on the board.");
+        }
+        return static_cast<std::uint8_t>(it - table.begin());
+    }
+
+// Append one row of a CSR relation
+    template<typename Csr, typename Row, typename T>
+    static void appendRow(Csr &csr, std::size_t row, const Row &items, const std::vector<T *> &table) {
+        std::size_t end = csr.offsets[row];
+        for (T *item : items) {
+            if (!item) {
+                continue;
+            }
+            if (end == csr.indices.size()) {
+                throw std::logic_error("Error: The board has more connections than the board graph supports.");
+            }
+            csr.indices[end++] = indexOf(table, item);
+        }
+        csr.offsets[row + 1] = static_cast<std::uint8_t>(end);
+    }
+
+// Compile the adjacency recorded on the objects, then bind the objects to the graph
+    void BoardGraph::build(const std::vector<Node *> &nodes, const std::vector<Pathway *> &pathways,
+                           const std::vector<Terrain *> &terrains) {
+        if (nodes.size() > MAX_NODES || pathways.size() > MAX_PATHWAYS || terrains.size() > MAX_TERRAINS) {
+            throw std::logic_error("Error: The board is larger than the board graph supports.");
+        }
+        _nodeCount = nodes.size();
+        _pathwayCount = pathways.size();
+        _terrainCount = terrains.size();
+
+        for (std::size_t n = 0; n < nodes.size(); ++n) {
+            appendRow(_nodePathways, n, nodes[n]->getPathways(), pathways);
+            appendRow(_nodeNeighbors, n, nodes[n]->getNeighbors(), nodes);
+            appendRow(_nodeTerrains, n, nodes[n]->getTerrains(), terrains);
+        }
+        for (std::size_t t = 0; t < terrains.size(); ++t) {
+            appendRow(_terrainNodes, t, terrains[t]->getNodes(), nodes);
+        }
+        for (std::size_t p = 0; p < pathways.size(); ++p) {
+            _pathwayNodes[p] = {indexOf(nodes, pathways[p]->getNode1()), indexOf(nodes, pathways[p]->getNode2())};
+        }
+
+        _nodeTable = nodes.data();
+        _pathwayTable = pathways.data();
+        _terrainTable = terrains.data();
+        for (std::size_t n = 0; n < nodes.size(); ++n) {
+            nodes[n]->attachGraph(this, static_cast<std::uint8_t>(n));
+        }
+        for (std::size_t t = 0; t < terrains.size(); ++t) {
+            terrains[t]->attachGraph(this, static_cast<std::uint8_t>(t));
+        }
+    }
+
+} // namespace strategy
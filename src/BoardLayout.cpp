@@ -0,0 +1,229 @@
+#include "BoardLayout.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+namespace strategy {
+
+    static constexpr float SQRT3 = 1.7320508f;
+
+// Fill colour of each resource, indexed by ResourceType; the last entry is the desert
+    static const std::array<Rgba, RESOURCE_TYPE_COUNT + 1> RESOURCE_COLORS = {{
+            {210, 105, 30},  // Brick
+            {255, 255, 102}, // Grain
+            {34, 139, 34},   // Lumber
+            {105, 105, 105}, // Ore
+            {144, 238, 144}, // Wool
+            {238, 232, 170}  // Desert
+    }};
+
+// Color of the pieces of each seat
+    static const std::array<Rgba, 8> PLAYER_COLORS = {{
+            {200, 30, 30},   // Red
+            {30, 80, 200},   // Blue
+            {240, 140, 0},   // Orange
+            {130, 50, 160},  // Purple
+            {0, 140, 140},   // Teal
+            {120, 70, 20},   // Brown
+            {230, 80, 160},  // Pink
+            {60, 60, 60}     // Gray
+    }};
+
+// Get the color of a terrain
+    const Rgba &resourceColor(ResourceType type) {
+        return RESOURCE_COLORS[std::min(static_cast<std::size_t>(type), RESOURCE_TYPE_COUNT)];
+    }
+
+// Get the color of a seat
+    const Rgba &playerColor(int seat) {
+        return PLAYER_COLORS[static_cast<std::size_t>(std::max(seat, 0)) % PLAYER_COLORS.size()];
+    }
+
+// Five hexagons across, five rows high, with a margin of half a hexagon
+    BoardLayout::BoardLayout(float width, float height)
+            : _radius(std::min(width / (6.0f * SQRT3), height / 9.0f)), _origin{width / 2.0f, height / 2.0f} {}
+
+// Place the nodes and pathways of a board in the layout
+    BoardLayout::BoardLayout(float width, float height, const BoardGraph &graph) : BoardLayout(width, height) {
+        placeNodes(graph);
+        _pathways.resize(graph.pathwayCount());
+        for (std::size_t p = 0; p < graph.pathwayCount(); ++p) {
+            const auto &ends = graph.pathwayNodeIndices(p);
+            _pathways[p] = {_nodes[ends[0]], _nodes[ends[1]]};
+        }
+    }
+
+// Place the nodes in passes: each pass places the nodes whose best corner is unambiguous, and a pass
+// placing none settles the first remaining tie, so that mis-wired adjacency is outvoted
+    void BoardLayout::placeNodes(const BoardGraph &graph) {
+        const std::size_t nodeCount = graph.nodeCount();
+        const float epsilon = _radius * 0.1f;
+        auto near = [epsilon](Point a, Point b) {
+            return std::abs(a.x - b.x) < epsilon && std::abs(a.y - b.y) < epsilon;
+        };
+
+        // The terrains of a node, as recorded on either side
+        std::vector<std::vector<std::size_t>> terrains(nodeCount);
+        for (std::size_t t = 0; t < std::min(graph.terrainCount(), HEX_COUNT); ++t) {
+            for (std::uint8_t node : graph.terrainNodeIndices(t)) {
+                terrains[node].push_back(t);
+            }
+        }
+        for (std::size_t node = 0; node < nodeCount; ++node) {
+            for (std::uint8_t t : graph.nodeTerrainIndices(node)) {
+                if (t < HEX_COUNT && std::find(terrains[node].begin(), terrains[node].end(), t) == terrains[node].end()) {
+                    terrains[node].push_back(t);
+                }
+            }
+        }
+
+        _nodes.assign(nodeCount, _origin);
+        std::vector<bool> placed(nodeCount, false);
+        auto taken = [&](Point corner) {
+            for (std::size_t other = 0; other < nodeCount; ++other) {
+                if (placed[other] && near(_nodes[other], corner)) {
+                    return true;
+                }
+            }
+            return false;
+        };
+
+        for (std::size_t remaining = nodeCount; remaining > 0;) {
+            std::size_t placedThisPass = 0, fallback = nodeCount;
+            Point fallbackCorner;
+            int fallbackScore = -1;
+            for (std::size_t node = 0; node < nodeCount; ++node) {
+                if (placed[node]) {
+                    continue;
+                }
+                // A node with no terrain at all may still sit on a corner of its neighbors' terrains
+                std::vector<std::size_t> sources = terrains[node];
+                if (sources.empty()) {
+                    for (std::uint8_t neighbor : graph.nodeNeighborIndices(node)) {
+                        sources.insert(sources.end(), terrains[neighbor].begin(), terrains[neighbor].end());
+                    }
+                }
+
+                int bestScore = -1;
+                bool tie = false;
+                Point bestCorner;
+                for (std::size_t source : sources) {
+                    const Point center = hexCenter((int) source);
+                    for (int c = 0; c < 6; ++c) {
+                        const Point corner = hexCorner(center, _radius, c);
+                        if (taken(corner) || (bestScore >= 0 && near(corner, bestCorner))) {
+                            continue;
+                        }
+                        int score = 0;
+                        for (std::size_t t : terrains[node]) {
+                            const Point other = hexCenter((int) t);
+                            score += std::abs(std::hypot(corner.x - other.x, corner.y - other.y) - _radius) < epsilon ? 4 : 0;
+                        }
+                        for (std::uint8_t neighbor : graph.nodeNeighborIndices(node)) {
+                            const Point at = _nodes[neighbor];
+                            score += placed[neighbor] && std::abs(std::hypot(corner.x - at.x, corner.y - at.y) - _radius) < epsilon;
+                        }
+                        if (score > bestScore) {
+                            bestScore = score;
+                            bestCorner = corner;
+                            tie = false;
+                        } else if (score == bestScore) {
+                            tie = true;
+                        }
+                    }
+                }
+
+                if (bestScore < 0) {
+                    // Every corner is taken: leave the node at the center
+                    placed[node] = true;
+                    ++placedThisPass;
+                } else if (!tie) {
+                    _nodes[node] = bestCorner;
+                    placed[node] = true;
+                    ++placedThisPass;
+                } else if (bestScore > fallbackScore) {
+                    fallback = node;
+                    fallbackCorner = bestCorner;
+                    fallbackScore = bestScore;
+                }
+            }
+            if (placedThisPass == 0) {
+                _nodes[fallback] = fallbackCorner;
+                placed[fallback] = true;
+                placedThisPass = 1;
+            }
+            remaining -= placedThisPass;
+        }
+    }
+
+// Get the hexagon radius
+    float BoardLayout::radius() const {
+        return _radius;
+    }
+
+// Walk the rows to the terrain's row, then center the row on the middle one
+    Point BoardLayout::hexCenter(int index) const {
+        if (index < 0 || index >= (int) HEX_COUNT) {
+            throw std::out_of_range("Error: Terrain " + std::to_string(index) + " is not on the board.");
+        }
+        int row = 0;
+        while (index >= ROW_LENGTHS[row]) {
+            index -= ROW_LENGTHS[row++];
+        }
+        const float column = (float) index - (float) (ROW_LENGTHS[row] - 1) / 2.0f;
+        return {_origin.x + column * SQRT3 * _radius, _origin.y + (float) (row - 2) * 1.5f * _radius};
+    }
+
+// Get a corner of a hexagon
+    Point BoardLayout::hexCorner(Point center, float radius, int corner) {
+        const float angle = 3.14159265f / 3.0f * (float) corner - 3.14159265f / 2.0f;
+        return {center.x + radius * std::cos(angle), center.y + radius * std::sin(angle)};
+    }
+
+// Get the number of nodes placed
+    std::size_t BoardLayout::nodeCount() const {
+        return _nodes.size();
+    }
+
+// Get the position of a node
+    Point BoardLayout::nodePosition(std::size_t index) const {
+        if (index >= _nodes.size()) {
+            throw std::out_of_range("Error: Node " + std::to_string(index + 1) + " is not in the layout.");
+        }
+        return _nodes[index];
+    }
+
+// Get the ends of a pathway
+    const std::array<Point, 2> &BoardLayout::pathwayEnds(std::size_t index) const {
+        if (index >= _pathways.size()) {
+            throw std::out_of_range("Error: Pathway " + std::to_string(index + 1) + " is not in the layout.");
+        }
+        return _pathways[index];
+    }
+
+// A bar a sixth of a radius wide, leaving a fifth of a radius free at each node
+    std::array<Point, 4> BoardLayout::roadShape(std::size_t index, float margin) const {
+        const std::array<Point, 2> &ends = pathwayEnds(index);
+        const float dx = ends[1].x - ends[0].x, dy = ends[1].y - ends[0].y;
+        const float length = std::hypot(dx, dy);
+        if (length < 1e-3f) {
+            return {ends[0], ends[0], ends[0], ends[0]};
+        }
+        const float ux = dx / length, uy = dy / length;
+        const float inset = _radius * 0.2f - margin, half = _radius * 0.08f + margin;
+        const Point a = {ends[0].x + ux * inset, ends[0].y + uy * inset};
+        const Point b = {ends[1].x - ux * inset, ends[1].y - uy * inset};
+        return {{{a.x - uy * half, a.y + ux * half}, {b.x - uy * half, b.y + ux * half},
+                 {b.x + uy * half, b.y - ux * half}, {a.x + uy * half, a.y - ux * half}}};
+    }
+
+// A square with a pointed roof, half as large again for a city
+    std::array<Point, 5> BoardLayout::buildingShape(std::size_t index, bool city, float margin) const {
+        const Point at = nodePosition(index);
+        const float size = _radius * (city ? 0.27f : 0.18f) + margin;
+        return {{{at.x - size, at.y + size}, {at.x - size, at.y - size * 0.3f}, {at.x, at.y - size * 1.2f},
+                 {at.x + size, at.y - size * 0.3f}, {at.x + size, at.y + size}}};
+    }
+
+} // namespace strategy
@@ -0,0 +1,424 @@
+#include "BoardRasterizer.hpp"
+#include "Node.hpp"
+#include "Player.hpp"
+#include "Property.hpp"
+#include "Terrain.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace strategy {
+
+    namespace {
+
+        const Rgba BACKGROUND = {255, 255, 255};
+        const Rgba OUTLINE = {0, 0, 0};
+        const Rgba TOKEN = {245, 222, 179};
+        const Rgba ROBBER = {40, 40, 40};
+        const Rgba HOT_NUMBER = {178, 34, 34};
+
+        // Digits in a 3x5 bitmap font, one bit per pixel, the top-left pixel in bit 14
+        constexpr std::array<std::uint16_t, 10> DIGITS = {
+                0b111'101'101'101'111, 0b010'110'010'010'111, 0b111'001'111'100'111, 0b111'001'111'001'111,
+                0b101'101'111'001'001, 0b111'100'111'001'111, 0b111'100'111'101'111, 0b111'001'001'001'001,
+                0b111'101'111'101'111, 0b111'101'111'001'111};
+
+        // CRC-32 of the PNG chunks, with the table built on first use
+        std::uint32_t crc32(const std::uint8_t *data, std::size_t size, std::uint32_t crc = 0) {
+            static const std::array<std::uint32_t, 256> table = [] {
+                std::array<std::uint32_t, 256> t{};
+                for (std::uint32_t n = 0; n < 256; ++n) {
+                    std::uint32_t c = n;
+                    for (int k = 0; k < 8; ++k) {
+                        c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+                    }
+                    t[n] = c;
+                }
+                return t;
+            }();
+            crc = ~crc;
+            for (std::size_t i = 0; i < size; ++i) {
+                crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+            }
+            return ~crc;
+        }
+
+        // Adler-32 checksum closing the zlib stream
+        std::uint32_t adler32(const std::vector<std::uint8_t> &data) {
+            std::uint32_t a = 1, b = 0;
+            for (std::uint8_t byte : data) {
+                a = (a + byte) % 65521;
+                b = (b + a) % 65521;
+            }
+            return (b << 16) | a;
+        }
+
+        void putBigEndian(std::vector<std::uint8_t> &out, std::uint32_t value) {
+            for (int shift = 24; shift >= 0; shift -= 8) {
+                out.push_back(static_cast<std::uint8_t>(value >> shift));
+            }
+        }
+
+        // Writes a deflate bit stream, least significant bit first
+        class BitWriter {
+        private:
+            std::vector<std::uint8_t> &_out;
+            std::uint32_t _bits = 0;
+            int _count = 0;
+
+        public:
+            explicit BitWriter(std::vector<std::uint8_t> &out) : _out(out) {}
+
+            void put(std::uint32_t value, int count) {
+                _bits |= value << _count;
+                _count += count;
+                while (_count >= 8) {
+                    _out.push_back(static_cast<std::uint8_t>(_bits));
+                    _bits >>= 8;
+                    _count -= 8;
+                }
+            }
+
+            // Huffman codes are stored most significant bit first
+            void putCode(std::uint32_t code, int length) {
+                std::uint32_t reversed = 0;
+                for (int i = 0; i < length; ++i) {
+                    reversed |= ((code >> i) & 1) << (length - 1 - i);
+                }
+                put(reversed, length);
+            }
+
+            void flush() {
+                if (_count > 0) {
+                    _out.push_back(static_cast<std::uint8_t>(_bits));
+                }
+                _bits = 0;
+                _count = 0;
+            }
+        };
+
+        // Code of a literal or length symbol in the fixed Huffman table
+        void putSymbol(BitWriter &bits, int symbol) {
+            if (symbol < 144) {
+                bits.putCode(0x30 + symbol, 8);
+            } else if (symbol < 256) {
+                bits.putCode(0x190 + symbol - 144, 9);
+            } else if (symbol < 280) {
+                bits.putCode(symbol - 256, 7);
+            } else {
+                bits.putCode(0xC0 + symbol - 280, 8);
+            }
+        }
+
+        constexpr std::array<int, 29> LENGTH_BASE = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                                                     35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+        constexpr std::array<int, 29> LENGTH_EXTRA = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                                                      3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+        constexpr std::array<int, 30> DISTANCE_BASE = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                                                       257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                                                       8193, 12289, 16385, 24577};
+        constexpr std::array<int, 30> DISTANCE_EXTRA = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                                                        7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+        void putMatch(BitWriter &bits, int length, int distance) {
+            int code = (int) LENGTH_BASE.size() - 1;
+            while (LENGTH_BASE[code] > length) {
+                --code;
+            }
+            putSymbol(bits, 257 + code);
+            bits.put(length - LENGTH_BASE[code], LENGTH_EXTRA[code]);
+
+            code = (int) DISTANCE_BASE.size() - 1;
+            while (DISTANCE_BASE[code] > distance) {
+                --code;
+            }
+            bits.putCode(code, 5);
+            bits.put(distance - DISTANCE_BASE[code], DISTANCE_EXTRA[code]);
+        }
+
+        // Compress scanlines as one fixed-Huffman block, matching against the previous pixel and the row above
+        std::vector<std::uint8_t> deflate(const std::vector<std::uint8_t> &data, std::size_t stride) {
+            std::vector<std::uint8_t> out;
+            BitWriter bits(out);
+            bits.put(1, 1); // Last block
+            bits.put(1, 2); // Fixed Huffman codes
+
+            const std::size_t distances[] = {4, stride};
+            for (std::size_t pos = 0; pos < data.size();) {
+                std::size_t bestLength = 0, bestDistance = 0;
+                for (std::size_t distance : distances) {
+                    if (distance > pos || distance > 32768) {
+                        continue;
+                    }
+                    const std::size_t limit = std::min<std::size_t>(258, data.size() - pos);
+                    std::size_t length = 0;
+                    while (length < limit && data[pos + length] == data[pos + length - distance]) {
+                        ++length;
+                    }
+                    if (length > bestLength) {
+                        bestLength = length;
+                        bestDistance = distance;
+                    }
+                }
+                if (bestLength >= 3) {
+                    putMatch(bits, (int) bestLength, (int) bestDistance);
+                    pos += bestLength;
+                } else {
+                    putSymbol(bits, data[pos++]);
+                }
+            }
+            putSymbol(bits, 256);
+            bits.flush();
+            return out;
+        }
+
+        void putChunk(std::vector<std::uint8_t> &png, const char *type, const std::vector<std::uint8_t> &data) {
+            putBigEndian(png, static_cast<std::uint32_t>(data.size()));
+            const std::size_t start = png.size();
+            png.insert(png.end(), type, type + 4);
+            png.insert(png.end(), data.begin(), data.end());
+            putBigEndian(png, crc32(png.data() + start, png.size() - start));
+        }
+
+    } // namespace
+
+// RasterImage Implementation
+
+    RasterImage::RasterImage(int width, int height) : _width(width), _height(height) {
+        if (width <= 0 || height <= 0) {
+            throw std::invalid_argument("Error: An image must be at least one pixel wide and high.");
+        }
+        _pixels.assign((std::size_t) width * height, Rgba{0, 0, 0, 0});
+    }
+
+// Get a pixel
+    Rgba RasterImage::pixel(int x, int y) const {
+        if (x < 0 || y < 0 || x >= _width || y >= _height) {
+            throw std::out_of_range("Error: The pixel is outside the image.");
+        }
+        return _pixels[(std::size_t) y * _width + x];
+    }
+
+// Paint every pixel
+    void RasterImage::fill(Rgba color) {
+        std::fill(_pixels.begin(), _pixels.end(), color);
+    }
+
+// Scan the rows of the polygon, painting between the leftmost and rightmost edge crossing
+    void RasterImage::fillPolygon(std::span<const Point> corners, Rgba color) {
+        if (corners.size() < 3) {
+            return;
+        }
+        float top = corners[0].y, bottom = corners[0].y;
+        for (const Point &corner : corners) {
+            top = std::min(top, corner.y);
+            bottom = std::max(bottom, corner.y);
+        }
+        const int firstRow = std::max(0, (int) std::ceil(top - 0.5f));
+        const int lastRow = std::min(_height - 1, (int) std::floor(bottom - 0.5f));
+        for (int y = firstRow; y <= lastRow; ++y) {
+            const float sampleY = (float) y + 0.5f;
+            float left = (float) _width, right = -1.0f;
+            for (std::size_t i = 0; i < corners.size(); ++i) {
+                const Point &a = corners[i];
+                const Point &b = corners[(i + 1) % corners.size()];
+                if ((a.y <= sampleY && b.y > sampleY) || (b.y <= sampleY && a.y > sampleY)) {
+                    const float x = a.x + (sampleY - a.y) / (b.y - a.y) * (b.x - a.x);
+                    left = std::min(left, x);
+                    right = std::max(right, x);
+                }
+            }
+            const int firstColumn = std::max(0, (int) std::ceil(left - 0.5f));
+            const int lastColumn = std::min(_width - 1, (int) std::floor(right - 0.5f));
+            for (int x = firstColumn; x <= lastColumn; ++x) {
+                _pixels[(std::size_t) y * _width + x] = color;
+            }
+        }
+    }
+
+// Paint the rows of a circle
+    void RasterImage::fillCircle(Point center, float radius, Rgba color) {
+        const int firstRow = std::max(0, (int) std::ceil(center.y - radius - 0.5f));
+        const int lastRow = std::min(_height - 1, (int) std::floor(center.y + radius - 0.5f));
+        for (int y = firstRow; y <= lastRow; ++y) {
+            const float dy = (float) y + 0.5f - center.y;
+            const float half = std::sqrt(std::max(0.0f, radius * radius - dy * dy));
+            const int firstColumn = std::max(0, (int) std::ceil(center.x - half - 0.5f));
+            const int lastColumn = std::min(_width - 1, (int) std::floor(center.x + half - 0.5f));
+            for (int x = firstColumn; x <= lastColumn; ++x) {
+                _pixels[(std::size_t) y * _width + x] = color;
+            }
+        }
+    }
+
+// Encode as 8-bit RGBA without filtering, compressed with a single deflate block
+    std::vector<std::uint8_t> RasterImage::encodePng() const {
+        const std::size_t stride = 1 + (std::size_t) _width * 4;
+        std::vector<std::uint8_t> scanlines;
+        scanlines.reserve(stride * _height);
+        for (int y = 0; y < _height; ++y) {
+            scanlines.push_back(0); // Filter type None
+            for (int x = 0; x < _width; ++x) {
+                const Rgba &p = _pixels[(std::size_t) y * _width + x];
+                scanlines.insert(scanlines.end(), {p.r, p.g, p.b, p.a});
+            }
+        }
+
+        std::vector<std::uint8_t> zlib = {0x78, 0x01};
+        std::vector<std::uint8_t> compressed = deflate(scanlines, stride);
+        zlib.insert(zlib.end(), compressed.begin(), compressed.end());
+        putBigEndian(zlib, adler32(scanlines));
+
+        std::vector<std::uint8_t> header;
+        putBigEndian(header, static_cast<std::uint32_t>(_width));
+        putBigEndian(header, static_cast<std::uint32_t>(_height));
+        header.insert(header.end(), {8, 6, 0, 0, 0}); // 8 bits per channel, RGBA, no interlacing
+
+        std::vector<std::uint8_t> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        putChunk(png, "IHDR", header);
+        putChunk(png, "IDAT", zlib);
+        putChunk(png, "IEND", {});
+        return png;
+    }
+
+// Write the encoded image to a file
+    void RasterImage::savePng(const std::string &path) const {
+        std::vector<std::uint8_t> png = encodePng();
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char *>(png.data()), (std::streamsize) png.size());
+        if (!file) {
+            throw std::runtime_error("Error: Could not write image file " + path + ".");
+        }
+    }
+
+// BoardRasterizer Implementation
+
+    BoardRasterizer::BoardRasterizer(RasterOptions options) : _options(options) {
+        if (options.width <= 0 || options.height <= 0) {
+            throw std::invalid_argument("Error: An image must be at least one pixel wide and high.");
+        }
+        if (_options.threadCount == 0) {
+            _options.threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+// Draw the digits of a number centered on a point
+    void BoardRasterizer::drawNumber(RasterImage &image, Point center, int number, float scale, Rgba color) const {
+        const std::string digits = std::to_string(number);
+        const float width = ((float) digits.size() * 4.0f - 1.0f) * scale;
+        const float left = center.x - width / 2.0f, top = center.y - 2.5f * scale;
+        for (std::size_t d = 0; d < digits.size(); ++d) {
+            const std::uint16_t glyph = DIGITS[digits[d] - '0'];
+            for (int bit = 0; bit < 15; ++bit) {
+                if (glyph & (1 << (14 - bit))) {
+                    const float x = left + ((float) d * 4.0f + (float) (bit % 3)) * scale;
+                    const float y = top + (float) (bit / 3) * scale;
+                    const Point square[] = {{x, y}, {x + scale, y}, {x + scale, y + scale}, {x, y + scale}};
+                    image.fillPolygon(square, color);
+                }
+            }
+        }
+    }
+
+// Draw the terrains with an outline, their number tokens and the robber, then the pieces
+    void BoardRasterizer::render(BoardView board, RasterImage &image) const {
+        if (image.width() != _options.width || image.height() != _options.height) {
+            throw std::invalid_argument("Error: The image does not have the size the rasterizer was set up for.");
+        }
+        image.fill(BACKGROUND);
+        const BoardLayout layout((float) _options.width, (float) _options.height, board.graph());
+        std::span<const Terrain *const> terrains = board.terrains();
+        const int hexCount = std::min<int>((int) terrains.size(), (int) BoardLayout::HEX_COUNT);
+        const float radius = layout.radius();
+        const float scale = std::max(1.0f, std::round(radius * 0.08f));
+
+        for (int t = 0; t < hexCount; ++t) {
+            const Point center = layout.hexCenter(t);
+            std::array<Point, 6> outer{}, inner{};
+            for (int corner = 0; corner < 6; ++corner) {
+                outer[corner] = BoardLayout::hexCorner(center, radius, corner);
+                inner[corner] = BoardLayout::hexCorner(center, radius - scale, corner);
+            }
+            image.fillPolygon(outer, OUTLINE);
+            image.fillPolygon(inner, resourceColor(terrains[t]->getResourceType()));
+
+            const int number = terrains[t]->getTerrainNum();
+            if (number > 0) {
+                image.fillCircle(center, radius * 0.35f, TOKEN);
+                drawNumber(image, center, number, scale, number == 6 || number == 8 ? HOT_NUMBER : OUTLINE);
+            }
+            if (t == board.robber()) {
+                image.fillCircle({center.x, center.y + radius * 0.58f}, radius * 0.18f, ROBBER);
+            }
+        }
+
+        std::span<const Pathway *const> pathways = board.pathways();
+        for (std::size_t p = 0; p < pathways.size(); ++p) {
+            if (pathways[p]->isOccupied() && pathways[p]->getPlayer()) {
+                image.fillPolygon(layout.roadShape(p, scale), OUTLINE);
+                image.fillPolygon(layout.roadShape(p), playerColor(pathways[p]->getPlayer()->getSeat()));
+            }
+        }
+        std::span<const Node *const> nodes = board.nodes();
+        for (std::size_t n = 0; n < nodes.size(); ++n) {
+            const game::Property *building = nodes[n]->getCity() ? (const game::Property *) nodes[n]->getCity() : nodes[n]->getSettlement();
+            if (building && building->identifyOwner()) {
+                const bool city = nodes[n]->getCity() != nullptr;
+                image.fillPolygon(layout.buildingShape(n, city, scale), OUTLINE);
+                image.fillPolygon(layout.buildingShape(n, city), playerColor(building->identifyOwner()->getSeat()));
+            }
+        }
+    }
+
+// Draw a board into a new image
+    RasterImage BoardRasterizer::render(BoardView board) const {
+        RasterImage image(_options.width, _options.height);
+        render(board, image);
+        return image;
+    }
+
+// Hand the boards out to the workers one at a time
+    void BoardRasterizer::renderToFiles(std::span<const GameBoard *const> boards, std::span<const std::string> paths) const {
+        if (boards.size() != paths.size()) {
+            throw std::invalid_argument("Error: Every board needs exactly one image path.");
+        }
+        std::atomic<std::size_t> next{0};
+        std::exception_ptr failure;
+        std::mutex failureMutex;
+
+        auto work = [&]() {
+            try {
+                RasterImage image(_options.width, _options.height);
+                for (std::size_t i = next++; i < boards.size(); i = next++) {
+                    render(BoardView(*boards[i]), image);
+                    image.savePng(paths[i]);
+                }
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failureMutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        };
+
+        const unsigned workers = std::min<unsigned>(_options.threadCount, std::max<std::size_t>(1, boards.size()));
+        std::vector<std::thread> threads;
+        for (unsigned worker = 1; worker < workers; ++worker) {
+            threads.emplace_back(work);
+        }
+        work();
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+    }
+
+} // namespace strategy
@@ -0,0 +1,102 @@
+#include "BoardSnapshot.hpp"
+#include "Node.hpp"
+#include "Player.hpp"
+#include "Property.hpp"
+#include "Terrain.hpp"
+
+namespace strategy {
+
+// Read the board's tables into the snapshot
+    void captureSnapshot(BoardView board, BoardSnapshot &snapshot) {
+        snapshot.resources.fill(static_cast<std::uint8_t>(ResourceType::None));
+        snapshot.numbers.fill(0);
+        snapshot.buildings.fill(0);
+        snapshot.roads.fill(0);
+        snapshot.robber = static_cast<std::int8_t>(board.robber());
+
+        std::span<const Terrain *const> terrains = board.terrains();
+        for (std::size_t t = 0; t < terrains.size() && t < snapshot.resources.size(); ++t) {
+            snapshot.resources[t] = static_cast<std::uint8_t>(terrains[t]->getResourceType());
+            snapshot.numbers[t] = static_cast<std::uint8_t>(terrains[t]->getTerrainNum());
+        }
+        std::span<const Node *const> nodes = board.nodes();
+        for (std::size_t n = 0; n < nodes.size() && n < snapshot.buildings.size(); ++n) {
+            if (const game::City *city = nodes[n]->getCity(); city && city->identifyOwner()) {
+                snapshot.buildings[n] = static_cast<std::uint8_t>((city->identifyOwner()->getSeat() + 1) | BoardSnapshot::CITY);
+            } else if (const game::Settelment *settlement = nodes[n]->getSettlement(); settlement && settlement->identifyOwner()) {
+                snapshot.buildings[n] = static_cast<std::uint8_t>(settlement->identifyOwner()->getSeat() + 1);
+            }
+        }
+        std::span<const Pathway *const> pathways = board.pathways();
+        for (std::size_t p = 0; p < pathways.size() && p < snapshot.roads.size(); ++p) {
+            if (pathways[p]->isOccupied() && pathways[p]->getPlayer()) {
+                snapshot.roads[p] = static_cast<std::uint8_t>(pathways[p]->getPlayer()->getSeat() + 1);
+            }
+        }
+    }
+
+// Capture the board, publish it and follow it
+    BoardFeed::BoardFeed(GameBoard &board) : _board(board) {
+        captureSnapshot(BoardView(board), _working);
+        publishWorking();
+        board.addObserver(this);
+    }
+
+    BoardFeed::~BoardFeed() {
+        _board.removeObserver(this);
+    }
+
+// Copy the working snapshot into the back slot and publish it
+    void BoardFeed::publishWorking() {
+        _buffer.back() = _working;
+        _buffer.publish();
+        _working.version++;
+    }
+
+// Take the latest snapshot
+    bool BoardFeed::poll() {
+        return _buffer.update();
+    }
+
+// Get the snapshot taken last
+    const BoardSnapshot &BoardFeed::latest() const {
+        return _buffer.front();
+    }
+
+// Get the board's adjacency
+    const BoardGraph &BoardFeed::graph() const {
+        return _board.getGraph();
+    }
+
+// Only pieces and the robber change what a spectator sees
+    void BoardFeed::onAction(const GameAction &action) {
+        const auto owner = static_cast<std::uint8_t>(action.seat + 1);
+        const auto index = static_cast<std::size_t>(action.value - 1);
+        switch (action.type) {
+            case ActionType::InitialSettlement:
+            case ActionType::BuildSettlement:
+                if (index < _working.buildings.size()) {
+                    _working.buildings[index] = owner;
+                }
+                break;
+            case ActionType::UpgradeToCity:
+                if (index < _working.buildings.size()) {
+                    _working.buildings[index] = owner | BoardSnapshot::CITY;
+                }
+                break;
+            case ActionType::InitialPathway:
+            case ActionType::BuildPathway:
+                if (index < _working.roads.size()) {
+                    _working.roads[index] = owner;
+                }
+                break;
+            case ActionType::MoveRobber:
+                _working.robber = static_cast<std::int8_t>(action.value);
+                break;
+            default:
+                return;
+        }
+        publishWorking();
+    }
+
+} // namespace strategy
@@ -0,0 +1,76 @@
+#include "BoardView.hpp"
+
+namespace strategy {
+
+// Find the object at a position of a table, or nullptr
+    template<typename T>
+    static const T *at(std::span<T *const> table, int index) {
+        return index >= 0 && index < (int) table.size() ? table[index] : nullptr;
+    }
+
+// View a board
+    BoardView::BoardView(const GameBoard &board) : _board(&board) {}
+
+// Get all the nodes
+    std::span<const Node *const> BoardView::nodes() const {
+        std::span<Node *const> nodes = _board->getNodes();
+        return {nodes.data(), nodes.size()};
+    }
+
+// Get all the pathways
+    std::span<const Pathway *const> BoardView::pathways() const {
+        std::span<Pathway *const> pathways = _board->getPathways();
+        return {pathways.data(), pathways.size()};
+    }
+
+// Get all the terrains
+    std::span<const Terrain *const> BoardView::terrains() const {
+        std::span<Terrain *const> terrains = _board->getTerrains();
+        return {terrains.data(), terrains.size()};
+    }
+
+// Get the node with an id
+    const Node *BoardView::node(int id) const {
+        return at(_board->getNodes(), id - 1);
+    }
+
+// Get the pathway with an id
+    const Pathway *BoardView::pathway(int id) const {
+        return at(_board->getPathways(), id - 1);
+    }
+
+// Get the terrain at a position
+    const Terrain *BoardView::terrain(int index) const {
+        return at(_board->getTerrains(), index);
+    }
+
+// Get the adjacency graph
+    const BoardGraph &BoardView::graph() const {
+        return _board->getGraph();
+    }
+
+// Get the robber's terrain
+    int BoardView::robber() const {
+        return _board->getRobber();
+    }
+
+// Get the number of players
+    int BoardView::playerCount() const {
+        return _board->getPlayerCount();
+    }
+
+// Get the player at a seat
+    const game::Player *BoardView::player(int seat) const {
+        return _board->getPlayer(seat);
+    }
+
+// Count the development cards left in the deck
+    int BoardView::deckCards() const {
+        int cards = 0;
+        for (std::size_t type = 0; type < game::DEV_CARD_TYPE_COUNT; ++type) {
+            cards += _board->countDeckCards(static_cast<game::DevCardType>(type));
+        }
+        return cards;
+    }
+
+} // namespace strategy
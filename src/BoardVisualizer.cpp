@@ -1,95 +1,293 @@
 #include "BoardVisualizer.hpp"
+#include <algorithm>
 #include <cmath>
-#include "Terrain.hpp"
+
+namespace {
+    const float OUTLINE_THICKNESS = 2.0f; // Outline drawn inside each hexagon
+
+    sf::Vector2f toVector(strategy::Point point) {
+        return {point.x, point.y};
+    }
+
+    sf::Color toColor(const strategy::Rgba &color) {
+        return {color.r, color.g, color.b, color.a};
+    }
+
+    // Append a convex polygon as a fan of triangles
+    template<std::size_t N>
+    void appendPolygon(sf::VertexArray &vertices, const std::array<strategy::Point, N> &corners, const sf::Color &color) {
+        for (std::size_t i = 1; i + 1 < N; ++i) {
+            vertices.append(sf::Vertex(toVector(corners[0]), color));
+            vertices.append(sf::Vertex(toVector(corners[i]), color));
+            vertices.append(sf::Vertex(toVector(corners[i + 1]), color));
+        }
+    }
+}
 
 BoardVisualizer::BoardVisualizer(int windowWidth, int windowHeight)
-        : window(sf::VideoMode(windowWidth, windowHeight), "Catan Board") {
-    rowLengths = {3, 4, 5, 4, 3};
+        : window(sf::VideoMode(windowWidth, windowHeight), "Catan Board"), hexGeometry(sf::Triangles) {
     if (!font.loadFromFile("ariblk.ttf")) {
         throw std::runtime_error("Failed to load font");
     }
+    for (std::size_t seat = 0; seat < roadLayers.size(); ++seat) {
+        roadLayers[seat].setPrimitiveType(sf::Triangles);
+        buildingLayers[seat].setPrimitiveType(sf::Triangles);
+    }
+    robberMarker.setFillColor(sf::Color(40, 40, 40));
+    window.setFramerateLimit(FRAME_RATE);
 }
 
-void BoardVisualizer::drawHexagon(float x, float y, const sf::Color &color) {
-    const float radius = 50.0f;  // Radius of the hexagon
-    const float adjustmentX = radius;  // To center the hexagon horizontally
-    const float adjustmentY = radius * sqrt(3) / 2;  // To center the hexagon vertically
-
-    sf::CircleShape hexagon(radius, 6);
-    hexagon.setFillColor(color);
-    hexagon.setOutlineColor(sf::Color::Black);
-    hexagon.setOutlineThickness(2);
+BoardVisualizer::~BoardVisualizer() {
+    if (watchedBoard) {
+        watchedBoard->removeObserver(this);
+    }
+}
 
-    // Adjust position to center the hexagon around (x, y)
-    hexagon.setPosition(x - adjustmentX, y - adjustmentY);
+// Observe a board for changes
+void BoardVisualizer::watch(strategy::GameBoard &board) {
+    if (watchedBoard) {
+        watchedBoard->removeObserver(this);
+    }
+    watchedBoard = &board;
+    board.addObserver(this);
+    markDirty();
+}
 
-    // Optional: Rotate the hexagon by 30 degrees if needed
-    // hexagon.setRotation(30);
+// Request a redraw
+void BoardVisualizer::markDirty() {
+    dirty.store(true, std::memory_order_release);
+}
 
-    window.draw(hexagon);
+// Only changes to pieces and the robber alter the picture
+void BoardVisualizer::onAction(const strategy::GameAction &action) {
+    switch (action.type) {
+        case strategy::ActionType::InitialSettlement:
+        case strategy::ActionType::InitialPathway:
+        case strategy::ActionType::BuildPathway:
+        case strategy::ActionType::BuildSettlement:
+        case strategy::ActionType::UpgradeToCity:
+        case strategy::ActionType::MoveRobber:
+            markDirty();
+            break;
+        default:
+            break;
+    }
 }
 
+// Append the fill (6 triangles) and the outline (6 quads) of a hexagon
+void BoardVisualizer::appendHexagon(strategy::Point center, float radius, const sf::Color &color) {
+    for (int corner = 0; corner < 6; ++corner) {
+        sf::Vector2f a = toVector(strategy::BoardLayout::hexCorner(center, radius - OUTLINE_THICKNESS, corner));
+        sf::Vector2f b = toVector(strategy::BoardLayout::hexCorner(center, radius - OUTLINE_THICKNESS, (corner + 1) % 6));
+        hexGeometry.append(sf::Vertex(toVector(center), color));
+        hexGeometry.append(sf::Vertex(a, color));
+        hexGeometry.append(sf::Vertex(b, color));
+
+        sf::Vector2f outerA = toVector(strategy::BoardLayout::hexCorner(center, radius, corner));
+        sf::Vector2f outerB = toVector(strategy::BoardLayout::hexCorner(center, radius, (corner + 1) % 6));
+        hexGeometry.append(sf::Vertex(a, sf::Color::Black));
+        hexGeometry.append(sf::Vertex(outerA, sf::Color::Black));
+        hexGeometry.append(sf::Vertex(b, sf::Color::Black));
+        hexGeometry.append(sf::Vertex(b, sf::Color::Black));
+        hexGeometry.append(sf::Vertex(outerA, sf::Color::Black));
+        hexGeometry.append(sf::Vertex(outerB, sf::Color::Black));
+    }
+}
 
-void BoardVisualizer::drawText(float x, float y, const std::string& text, const sf::Font& font, unsigned int fontSize, const sf::Color& color) {
+void BoardVisualizer::drawText(sf::RenderTarget &target, float x, float y, const std::string& text, unsigned int fontSize, const sf::Color& color) {
     sf::Text sfText(text, font, fontSize);
     sfText.setFillColor(color);
     sfText.setPosition(x, y);
-    window.draw(sfText);
+    target.draw(sfText);
 }
 
-void BoardVisualizer::drawBoard(strategy::GameBoard& gameBoard) {
-    const float radius = 50.0f;
-    const float hexHeight = sqrt(3) * radius; // Height of a hexagon
-    const float hexWidth = 2 * radius; // Width of a hexagon
-    const float verticalSpacing = hexHeight * 0.75f; // Vertical spacing for overlap
-    const float horizontalSpacing = hexWidth * 0.75f; // Horizontal spacing for overlap
+// Build the hex geometry once and render it with its labels into the static layer
+void BoardVisualizer::rebuildStaticLayer(const strategy::BoardGraph &graph, const strategy::BoardSnapshot &snapshot) {
+    const int hexCount = std::min<int>((int) graph.terrainCount(), (int) strategy::BoardLayout::HEX_COUNT);
+    cachedSize = window.getSize();
+    layout.emplace((float) cachedSize.x, (float) cachedSize.y, graph);
+    const float radius = layout->radius();
 
-    int hexIndex = 0;
-    for (int row = 0; row < (int)rowLengths.size(); ++row) {
-        for (int col = 0; col < rowLengths[row]; ++col) {
-            if (hexIndex >= (int)gameBoard.getTerrains().size()) break;
+    hexGeometry.clear();
+    for (int hexIndex = 0; hexIndex < hexCount; ++hexIndex) {
+        const auto resource = static_cast<strategy::ResourceType>(snapshot.resources[hexIndex]);
+        appendHexagon(layout->hexCenter(hexIndex), radius, toColor(strategy::resourceColor(resource)));
+    }
 
-            auto terrain = gameBoard.getTerrains()[hexIndex++];
-            if (terrain == nullptr) {
-                std::cerr << "Error: Terrain is null at index " << hexIndex - 1 << std::endl;
-                return;
-            }
+    if (!staticLayer.create(cachedSize.x, cachedSize.y)) {
+        throw std::runtime_error("Failed to create the board texture");
+    }
+    staticLayer.clear(sf::Color::Transparent);
+    staticLayer.draw(hexGeometry);
+    for (int hexIndex = 0; hexIndex < hexCount; ++hexIndex) {
+        const auto resource = static_cast<strategy::ResourceType>(snapshot.resources[hexIndex]);
+        strategy::Point center = layout->hexCenter(hexIndex);
+
+        // Center the terrain number in the hexagon
+        drawText(staticLayer, center.x, center.y - radius * 0.4f, std::to_string(snapshot.numbers[hexIndex]), 20, sf::Color::Black);
 
-            float x = col * horizontalSpacing + (3 - rowLengths[row]) * (hexWidth / 2.0f) + 150;
-            float y = row * verticalSpacing + 100;
+        // Center the resource name below the terrain number
+        drawText(staticLayer, center.x - radius * 0.4f, center.y, strategy::resourceName(resource), 15, sf::Color::Black);
+    }
+    staticLayer.display();
 
-            sf::Color color;
-            if (terrain->getResourceName() == "Brick") color = sf::Color(210, 105, 30);
-            else if (terrain->getResourceName() == "Lumber") color = sf::Color(34, 139, 34);
-            else if (terrain->getResourceName() == "Ore") color = sf::Color(105, 105, 105);
-            else if (terrain->getResourceName() == "Grain") color = sf::Color(255, 255, 102);
-            else if (terrain->getResourceName() == "Wool") color = sf::Color(144, 238, 144);
-            else if (terrain->getResourceName() == "Desert") color = sf::Color(238, 232, 170);
-            else color = sf::Color::White;
+    staticSprite.setTexture(staticLayer.getTexture(), true);
+    robberMarker.setRadius(radius * 0.25f);
+    robberMarker.setOrigin(radius * 0.25f, radius * 0.25f);
+    cachedBoard = &graph;
+    cachedResources = snapshot.resources;
+    cachedNumbers = snapshot.numbers;
+}
 
-            drawHexagon(x, y, color);
+// Sort the roads and buildings of the snapshot into the vertex arrays of their owners
+void BoardVisualizer::rebuildPieceLayers(const strategy::BoardGraph &graph, const strategy::BoardSnapshot &snapshot) {
+    for (std::size_t seat = 0; seat < roadLayers.size(); ++seat) {
+        roadLayers[seat].clear();
+        buildingLayers[seat].clear();
+    }
+    const float outline = OUTLINE_THICKNESS;
 
-            // Center the terrain number in the hexagon
-            drawText(x , y - radius*0.4f , std::to_string(terrain->getTerrainNum()), font, 20, sf::Color::Black);
+    const std::size_t pathwayCount = std::min(graph.pathwayCount(), snapshot.roads.size());
+    for (std::size_t p = 0; p < pathwayCount; ++p) {
+        const int seat = snapshot.roadSeat(p);
+        if (seat >= 0 && seat < (int) roadLayers.size()) {
+            sf::VertexArray &layer = roadLayers[seat];
+            appendPolygon(layer, layout->roadShape(p, outline), sf::Color::Black);
+            appendPolygon(layer, layout->roadShape(p), toColor(strategy::playerColor(seat)));
+        }
+    }
 
-            // Center the resource name below the terrain number
-            drawText(x - radius*0.4f, y - radius * 0.02f, terrain->getResourceName(), font, 15, sf::Color::Black);
+    const std::size_t nodeCount = std::min(graph.nodeCount(), snapshot.buildings.size());
+    for (std::size_t n = 0; n < nodeCount; ++n) {
+        const int seat = snapshot.buildingSeat(n);
+        const bool city = snapshot.isCity(n);
+        if (seat >= 0 && seat < (int) buildingLayers.size()) {
+            sf::VertexArray &layer = buildingLayers[seat];
+            appendPolygon(layer, layout->buildingShape(n, city, outline), sf::Color::Black);
+            appendPolygon(layer, layout->buildingShape(n, city), toColor(strategy::playerColor(seat)));
         }
     }
 }
 
-void BoardVisualizer::run() {
+// Draw the cached static layer, rebuilding it only for another board, terrains or window size, then the pieces
+void BoardVisualizer::drawSnapshot(const strategy::BoardGraph &graph, const strategy::BoardSnapshot &snapshot) {
+    if (cachedBoard != &graph || cachedSize != window.getSize()
+        || cachedResources != snapshot.resources || cachedNumbers != snapshot.numbers) {
+        rebuildStaticLayer(graph, snapshot);
+    }
+    window.draw(staticSprite);
+
+    rebuildPieceLayers(graph, snapshot);
+    for (const sf::VertexArray &layer : roadLayers) {
+        if (layer.getVertexCount() > 0) {
+            window.draw(layer);
+        }
+    }
+    for (const sf::VertexArray &layer : buildingLayers) {
+        if (layer.getVertexCount() > 0) {
+            window.draw(layer);
+        }
+    }
+    if (snapshot.robber >= 0 && snapshot.robber < (int) strategy::BoardLayout::HEX_COUNT) {
+        robberMarker.setPosition(toVector(layout->hexCenter(snapshot.robber)));
+        window.draw(robberMarker);
+    }
+}
+
+// Snapshot the board and draw it
+void BoardVisualizer::drawBoard(strategy::BoardView board) {
+    strategy::captureSnapshot(board, shown);
+    drawSnapshot(board.graph(), shown);
+}
+
+// Draw a frame only when something changed
+bool BoardVisualizer::renderFrame(strategy::BoardView board) {
+    if (!dirty.exchange(false, std::memory_order_acq_rel)) {
+        return false;
+    }
+    window.clear(sf::Color::White);
+    drawBoard(board);
+    window.display();
+    return true;
+}
+
+// Close, resize or refocus the window
+void BoardVisualizer::pollEvents() {
+    sf::Event event{};
+    while (window.pollEvent(event)) {
+        if (event.type == sf::Event::Closed) {
+            window.close();
+        } else if (event.type == sf::Event::Resized) {
+            window.setView(sf::View(sf::FloatRect(0, 0, (float) event.size.width, (float) event.size.height)));
+            markDirty();
+        } else if (event.type == sf::Event::GainedFocus) {
+            markDirty();
+        }
+    }
+}
+
+// Handle window events, redraw on changes and sleep while idle
+void BoardVisualizer::run(strategy::BoardView board) {
+    while (window.isOpen()) {
+        pollEvents();
+        if (window.isOpen() && !renderFrame(board)) {
+            sf::sleep(sf::milliseconds(IDLE_SLEEP_MS));
+        }
+    }
+}
+
+// Take the latest snapshot the game published on every frame; the game never waits for the window
+void BoardVisualizer::runLive(strategy::BoardFeed &feed) {
+    markDirty();
+    while (window.isOpen()) {
+        pollEvents();
+        if (feed.poll()) {
+            markDirty();
+        }
+        if (window.isOpen() && dirty.exchange(false, std::memory_order_acq_rel)) {
+            window.clear(sf::Color::White);
+            drawSnapshot(feed.graph(), feed.latest());
+            window.display();
+        } else {
+            sf::sleep(sf::milliseconds(IDLE_SLEEP_MS));
+        }
+    }
+}
+
+// Copy the wall into one vertex array, then on every frame copy only the colors of the boards that changed
+void BoardVisualizer::runWall(strategy::SpectatorWall &wall) {
+    std::span<const strategy::WallVertex> source = wall.vertices();
+    sf::VertexArray triangles(sf::Triangles, source.size());
+    for (std::size_t v = 0; v < source.size(); ++v) {
+        triangles[v].position = toVector(source[v].position);
+    }
+    window.setView(sf::View(sf::FloatRect(0, 0, wall.width(), wall.height())));
+    markDirty();
+
     while (window.isOpen()) {
         sf::Event event{};
         while (window.pollEvent(event)) {
             if (event.type == sf::Event::Closed) {
                 window.close();
+            } else if (event.type == sf::Event::Resized || event.type == sf::Event::GainedFocus) {
+                markDirty();
             }
         }
+        for (std::size_t tile : wall.refresh()) {
+            std::span<const strategy::WallVertex> colors = wall.tile(tile);
+            const std::size_t first = tile * strategy::SpectatorWall::VERTICES_PER_TILE;
+            for (std::size_t v = 0; v < colors.size(); ++v) {
+                triangles[first + v].color = toColor(colors[v].color);
+            }
+            markDirty();
+        }
 
-        window.clear(sf::Color::White);
-        // Assuming you have an instance of GameBoard to pass here
-        // drawBoard(gameBoard);
-        window.display();
+        if (window.isOpen() && dirty.exchange(false, std::memory_order_acq_rel)) {
+            window.clear(sf::Color(20, 40, 90));
+            window.draw(triangles);
+            window.display();
+        } else {
+            sf::sleep(sf::milliseconds(IDLE_SLEEP_MS));
+        }
     }
 }
@@ -0,0 +1,198 @@
+#include "BotSwarm.hpp"
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+namespace strategy {
+
+    namespace {
+
+        constexpr int MAX_EVENTS = 256;            ///< Events taken per epoll_wait.
+        constexpr std::size_t READ_CHUNK = 16384;  ///< Bytes read per recv.
+        constexpr int PATHWAY_COUNT = 72;          ///< Pathway ids a bot picks from.
+        constexpr int NODE_COUNT = 54;             ///< Node ids a bot picks from.
+
+        // One bot and its connection
+        struct Bot {
+            int fd = -1;
+            int seat = -1;
+            bool writing = false;          // Registered for EPOLLOUT
+            std::vector<std::uint8_t> in;  // Bytes received and not decoded yet
+            std::vector<std::uint8_t> out; // Bytes not sent yet
+        };
+
+        // Every socket of a swarm, closed however run() ends
+        struct Sockets {
+            int epollFd = -1;
+            std::vector<Bot> bots;
+
+            ~Sockets() {
+                for (Bot &bot : bots) {
+                    if (bot.fd >= 0) {
+                        ::close(bot.fd);
+                    }
+                }
+                if (epollFd >= 0) {
+                    ::close(epollFd);
+                }
+            }
+        };
+
+        // Write as much as the socket takes and wait for EPOLLOUT only while something is left
+        void flush(Bot &bot, int epollFd, SwarmStats &stats) {
+            std::size_t sent = 0;
+            while (sent < bot.out.size()) {
+                const ssize_t written = ::send(bot.fd, bot.out.data() + sent, bot.out.size() - sent, MSG_NOSIGNAL);
+                if (written > 0) {
+                    sent += static_cast<std::size_t>(written);
+                } else if (written < 0 && errno == EINTR) {
+                    continue;
+                } else {
+                    break;
+                }
+            }
+            stats.bytesSent += sent;
+            bot.out.erase(bot.out.begin(), bot.out.begin() + (std::ptrdiff_t) sent);
+            const bool writing = !bot.out.empty();
+            if (writing != bot.writing) {
+                bot.writing = writing;
+                epoll_event event{};
+                event.events = EPOLLIN | (writing ? EPOLLOUT : 0u);
+                event.data.ptr = &bot;
+                ::epoll_ctl(epollFd, EPOLL_CTL_MOD, bot.fd, &event);
+            }
+        }
+
+        // Close a bot's connection; closing also removes it from the epoll set
+        void leave(Bot &bot, std::size_t &playing) {
+            ::close(bot.fd);
+            bot.fd = -1;
+            playing--;
+        }
+
+    } // namespace
+
+    BotSwarm::BotSwarm(SwarmOptions options) : _options(std::move(options)) {}
+
+// Connect and join every bot, then answer the server until every bot has left
+    SwarmStats BotSwarm::run() {
+        SwarmStats stats;
+        Sockets sockets;
+        sockets.epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (sockets.epollFd < 0) {
+            throw std::runtime_error("Error: Cannot create the event loop of the bot swarm.");
+        }
+        sockets.bots.resize(_options.connections);
+        std::mt19937_64 rng(_options.seed);
+        std::uniform_int_distribution<int> kinds(0, 2);
+        std::uniform_int_distribution<int> pathways(1, PATHWAY_COUNT);
+        std::uniform_int_distribution<int> nodes(1, NODE_COUNT);
+        const auto start = std::chrono::steady_clock::now();
+
+        Message request;
+        for (Bot &bot : sockets.bots) {
+            bot.fd = connectTo(_options.endpoint);
+            stats.connected++;
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.ptr = &bot;
+            ::epoll_ctl(sockets.epollFd, EPOLL_CTL_ADD, bot.fd, &event);
+            request.type = MessageType::Join;
+            encodeMessage(bot.out, request);
+            flush(bot, sockets.epollFd, stats);
+        }
+
+        std::size_t playing = sockets.bots.size();
+        std::array<epoll_event, MAX_EVENTS> events{};
+        std::vector<std::uint8_t> buffer(READ_CHUNK);
+        Message reply;
+        while (playing > 0) {
+            const int ready = ::epoll_wait(sockets.epollFd, events.data(), MAX_EVENTS, _options.idleTimeoutMs);
+            if (ready < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ready <= 0) {
+                throw std::runtime_error("Error: The match server went quiet with " + std::to_string(playing) + " bots still playing.");
+            }
+            for (int i = 0; i < ready; ++i) {
+                Bot &bot = *static_cast<Bot *>(events[i].data.ptr);
+                if (bot.fd < 0) {
+                    continue;
+                }
+                bool closed = false;
+                while (true) {
+                    const ssize_t received = ::recv(bot.fd, buffer.data(), buffer.size(), 0);
+                    if (received > 0) {
+                        stats.bytesReceived += static_cast<std::size_t>(received);
+                        bot.in.insert(bot.in.end(), buffer.begin(), buffer.begin() + received);
+                    } else if (received < 0 && errno == EINTR) {
+                        continue;
+                    } else {
+                        closed = received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK);
+                        break;
+                    }
+                }
+
+                std::size_t offset = 0;
+                bool over = false;
+                while (!over) {
+                    const std::size_t length = decodeMessage(std::span<const std::uint8_t>(bot.in).subspan(offset), reply);
+                    if (length == 0) {
+                        break;
+                    }
+                    offset += length;
+                    switch (reply.type) {
+                        case MessageType::Seated:
+                            bot.seat = reply.seat;
+                            break;
+                        case MessageType::YourTurn:
+                            stats.turns++;
+                            request.type = MessageType::Roll;
+                            encodeMessage(bot.out, request);
+                            request.type = MessageType::Build;
+                            for (int b = 0; b < _options.buildsPerTurn; ++b) {
+                                request.build = static_cast<BuildKind>(kinds(rng));
+                                request.id = request.build == BuildKind::Pathway ? pathways(rng) : nodes(rng);
+                                encodeMessage(bot.out, request);
+                            }
+                            request.type = MessageType::EndTurn;
+                            encodeMessage(bot.out, request);
+                            break;
+                        case MessageType::Diff:
+                            stats.actions += reply.actions.size();
+                            break;
+                        case MessageType::Rejected:
+                            stats.rejected++;
+                            break;
+                        case MessageType::GameOver:
+                            stats.finished++;
+                            stats.wins += reply.winner >= 0 && reply.winner == bot.seat;
+                            over = true;
+                            break;
+                        default:
+                            throw std::runtime_error("Error: The match server sent a client request.");
+                    }
+                }
+                bot.in.erase(bot.in.begin(), bot.in.begin() + (std::ptrdiff_t) offset);
+
+                if (over || closed) {
+                    stats.dropped += !over;
+                    leave(bot, playing);
+                } else {
+                    flush(bot, sockets.epollFd, stats);
+                }
+            }
+        }
+        stats.seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        return stats;
+    }
+
+} // namespace strategy
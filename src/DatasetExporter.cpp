@@ -0,0 +1,210 @@
+#include "DatasetExporter.hpp"
+#include "Node.hpp"
+#include "Terrain.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace game;
+
+namespace strategy {
+
+    static const char SHARD_MAGIC[8] = {'C', 'A', 'T', 'A', 'N', 'T', 'S', 'R'};
+
+// Clamp a count into one feature byte
+    static std::uint8_t feature(int value) {
+        return static_cast<std::uint8_t>(std::clamp(value, 0, 255));
+    }
+
+// Encode the board and players of a replayed game
+    void encodeState(GameReplayer &replayer, StateTensor &tensor) {
+        using T = StateTensor;
+        GameBoard &board = replayer.getBoard();
+        tensor.features.fill(0);
+        tensor.turn = static_cast<std::uint32_t>(replayer.getTurn());
+
+        for (std::size_t i = 0; i < T::NODE_COUNT; ++i) {
+            Node *node = board.locateNode(static_cast<int>(i + 1));
+            if (node->getSettlement() && node->getSettlement()->identifyOwner()) {
+                tensor.features[T::NODE_OFFSET + i] = feature(node->getSettlement()->identifyOwner()->getSeat() + 1);
+            } else if (node->getCity() && node->getCity()->identifyOwner()) {
+                tensor.features[T::NODE_OFFSET + i] = feature(node->getCity()->identifyOwner()->getSeat() + 4);
+            }
+        }
+        for (std::size_t i = 0; i < T::PATHWAY_COUNT; ++i) {
+            Pathway *pathway = board.locatePathway(static_cast<int>(i + 1));
+            if (pathway->isOccupied() && pathway->getPlayer()) {
+                tensor.features[T::PATHWAY_OFFSET + i] = feature(pathway->getPlayer()->getSeat() + 1);
+            }
+        }
+        for (std::size_t i = 0; i < T::TERRAIN_COUNT; ++i) {
+            Terrain *terrain = board.locateTerrain(static_cast<int>(i));
+            tensor.features[T::TERRAIN_OFFSET + 2 * i] = static_cast<std::uint8_t>(terrain->getResourceType());
+            tensor.features[T::TERRAIN_OFFSET + 2 * i + 1] = feature(terrain->getTerrainNum());
+        }
+        for (std::size_t seat = 0; seat < T::PLAYER_COUNT; ++seat) {
+            Player &player = replayer.getPlayer(static_cast<int>(seat));
+            std::uint8_t *out = tensor.features.data() + T::PLAYER_OFFSET + seat * T::PLAYER_STRIDE;
+            for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+                *out++ = feature(player.getResources()[r]);
+            }
+            for (std::size_t type = 0; type < DEV_CARD_TYPE_COUNT; ++type) {
+                *out++ = feature(player.countDevelopmentCards(static_cast<DevCardType>(type)));
+            }
+            *out = feature(player.calculateScore());
+            if (player.isTurnActive()) {
+                tensor.activeSeat = static_cast<std::uint8_t>(seat);
+            }
+        }
+    }
+
+    namespace {
+
+/**
+ * @brief A worker's sequence of shard files, rotated after a fixed number of records.
+ */
+        class ShardWriter {
+        private:
+            std::string _prefix;
+            std::size_t _limit;
+            std::ofstream _file;
+            std::size_t _inShard = 0;
+            std::size_t _shards = 0;
+            std::vector<char> _record = std::vector<char>(StateTensor::RECORD_SIZE);
+
+            void open() {
+                _file.close();
+                std::string path = _prefix + "-" + std::to_string(_shards) + ".tensors";
+                _file.open(path, std::ios::binary | std::ios::trunc);
+                if (!_file) {
+                    throw std::runtime_error("Error: Cannot create shard " + path + ".");
+                }
+                auto size = static_cast<std::uint32_t>(StateTensor::RECORD_SIZE);
+                char preamble[sizeof(SHARD_MAGIC) + 5];
+                std::memcpy(preamble, SHARD_MAGIC, sizeof(SHARD_MAGIC));
+                preamble[sizeof(SHARD_MAGIC)] = static_cast<char>(DatasetExporter::FORMAT_VERSION);
+                for (int i = 0; i < 4; ++i) {
+                    preamble[sizeof(SHARD_MAGIC) + 1 + i] = static_cast<char>(size >> (8 * i));
+                }
+                _file.write(preamble, sizeof(preamble));
+                _inShard = 0;
+                _shards++;
+            }
+
+        public:
+            ShardWriter(std::string prefix, std::size_t limit) : _prefix(std::move(prefix)), _limit(std::max<std::size_t>(limit, 1)) {}
+
+            void write(const StateTensor &tensor) {
+                if (_shards == 0 || _inShard == _limit) {
+                    open();
+                }
+                char *out = _record.data();
+                for (int i = 0; i < 8; ++i) *out++ = static_cast<char>(tensor.seed >> (8 * i));
+                for (int i = 0; i < 4; ++i) *out++ = static_cast<char>(tensor.turn >> (8 * i));
+                *out++ = static_cast<char>(tensor.winner);
+                *out++ = static_cast<char>(tensor.activeSeat);
+                std::memcpy(out, tensor.features.data(), tensor.features.size());
+                if (!_file.write(_record.data(), (std::streamsize) _record.size())) {
+                    throw std::runtime_error("Error: Cannot write shard of " + _prefix + ".");
+                }
+                _inShard++;
+            }
+
+            [[nodiscard]] std::size_t shards() const { return _shards; }
+        };
+
+/**
+ * @brief Where a game starts in the log, and who won it.
+ */
+        struct IndexedGame {
+            GameRecordCursor start; ///< Cursor just before the start tag of the game.
+            int winner;             ///< Seat of the winner, or -1.
+        };
+
+    } // namespace
+
+// DatasetExporter Implementation
+
+    DatasetExporter::DatasetExporter(ExportOptions options) : _options(std::move(options)) {
+        if (_options.threadCount == 0) {
+            _options.threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+    }
+
+// Index the games of a log once, then replay them in parallel, worker w taking games w, w+n, w+2n, ...
+    ExportStats DatasetExporter::exportLog(const std::string &logPath) {
+        GameRecordReader reader(logPath);
+        const unsigned workers = _options.threadCount;
+
+        // The start tag byte can also appear inside varints and names, so the games are found by
+        // decoding the log once here rather than by every worker. The winner is stored at the end
+        // of a game, so it is picked up on the same pass.
+        std::vector<IndexedGame> index;
+        {
+            GameRecordCursor cursor = reader.games();
+            GameHeader header;
+            GameAction skipped;
+            for (GameRecordCursor start = cursor; cursor.nextGame(header); start = cursor) {
+                while (cursor.nextAction(skipped)) {
+                }
+                index.push_back({start, cursor.winner()});
+            }
+        }
+
+        std::atomic<std::size_t> games{0}, records{0}, shards{0};
+        std::exception_ptr failure;
+        std::mutex failureMutex;
+
+        auto work = [&](unsigned worker) {
+            try {
+                ShardWriter shardWriter(_options.outputPrefix + "-" + std::to_string(worker), _options.recordsPerShard);
+                GameHeader header;
+                for (std::size_t game = worker; game < index.size(); game += workers) {
+                    GameRecordCursor cursor = index[game].start;
+                    cursor.nextGame(header);
+
+                    StateTensor tensor;
+                    tensor.seed = header.seed;
+                    tensor.winner = static_cast<std::int8_t>(index[game].winner);
+                    GameReplayer replayer(header, cursor);
+                    for (int turn = 0; ; ++turn) {
+                        replayer.replayUntilTurn(turn);
+                        encodeState(replayer, tensor);
+                        shardWriter.write(tensor);
+                        records++;
+                        if (replayer.isFinished()) {
+                            break;
+                        }
+                    }
+                    games++;
+                }
+                shards += shardWriter.shards();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(failureMutex);
+                if (!failure) {
+                    failure = std::current_exception();
+                }
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (unsigned worker = 1; worker < workers; ++worker) {
+            threads.emplace_back(work, worker);
+        }
+        work(0);
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        if (failure) {
+            std::rethrow_exception(failure);
+        }
+        return {games.load(), records.load(), shards.load()};
+    }
+
+} // namespace strategy
@@ -13,7 +13,7 @@ namespace game {
     MonopolyCard::MonopolyCard() = default;
 
     int MonopolyCard::getCardCount() const {
-        return 100; // Placeholder count, replace with actual game logic.
+        return DEV_CARD_DECK[static_cast<std::size_t>(DevCardType::Monopoly)];
     }
 
     DevelopmentCard* MonopolyCard::cloneCard() const {
@@ -24,12 +24,16 @@ namespace game {
         return "Monopoly";
     }
 
+    DevCardType MonopolyCard::cardTypeId() const {
+        return DevCardType::Monopoly;
+    }
+
 // VictoryPointCard Implementation
 
     VictoryPointCard::VictoryPointCard() = default;
 
     int VictoryPointCard::getCardCount() const {
-        return 4; // Placeholder count, replace with actual game logic.
+        return DEV_CARD_DECK[static_cast<std::size_t>(DevCardType::VictoryPoint)];
     }
 
     DevelopmentCard* VictoryPointCard::cloneCard() const {
@@ -40,12 +44,16 @@ namespace game {
         return "Victory Point";
     }
 
+    DevCardType VictoryPointCard::cardTypeId() const {
+        return DevCardType::VictoryPoint;
+    }
+
 // PlentyCard Implementation
 
     PlentyCard::PlentyCard() = default;
 
     int PlentyCard::getCardCount() const {
-        return 100; // Placeholder count, replace with actual game logic.
+        return DEV_CARD_DECK[static_cast<std::size_t>(DevCardType::YearOfPlenty)];
     }
 
     DevelopmentCard* PlentyCard::cloneCard() const {
@@ -56,12 +64,16 @@ namespace game {
         return "Year of Plenty";
     }
 
+    DevCardType PlentyCard::cardTypeId() const {
+        return DevCardType::YearOfPlenty;
+    }
+
 // RoadBuildingCard Implementation
 
     RoadBuildingCard::RoadBuildingCard() = default;
 
     int RoadBuildingCard::getCardCount() const {
-        return 100; // Placeholder count, replace with actual game logic.
+        return DEV_CARD_DECK[static_cast<std::size_t>(DevCardType::RoadBuilding)];
     }
 
     DevelopmentCard* RoadBuildingCard::cloneCard() const {
@@ -72,12 +84,16 @@ namespace game {
         return "Road Building";
     }
 
+    DevCardType RoadBuildingCard::cardTypeId() const {
+        return DevCardType::RoadBuilding;
+    }
+
 // KnightCard Implementation
 
     KnightCard::KnightCard() = default;
 
     int KnightCard::getCardCount() const {
-        return 3; // Placeholder count, replace with actual game logic.
+        return DEV_CARD_DECK[static_cast<std::size_t>(DevCardType::Knight)];
     }
 
     DevelopmentCard* KnightCard::cloneCard() const {
@@ -88,4 +104,8 @@ namespace game {
         return "Knight";
     }
 
+    DevCardType KnightCard::cardTypeId() const {
+        return DevCardType::Knight;
+    }
+
 }
@@ -0,0 +1,103 @@
+#include "DiscardStrategy.hpp"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+using namespace strategy;
+
+namespace game {
+
+// Log of n!, with the reentrant lgamma since std::lgamma writes the global signgam and races between games on threads
+    static double logFactorial(int n) {
+        int sign;
+        return ::lgamma_r(n + 1.0, &sign);
+    }
+
+// Log of the binomial coefficient C(n, k)
+    static double logChoose(int n, int k) {
+        return logFactorial(n) - logFactorial(k) - logFactorial(n - k);
+    }
+
+// Sample the number of successes when drawing `draws` items out of `population`, `successes` of which are marked
+    static int drawHypergeometric(int population, int successes, int draws, std::mt19937 &rng) {
+        int low = std::max(0, draws - (population - successes));
+        int high = std::min(draws, successes);
+        if (low == high) {
+            return low;
+        }
+
+        // Inverse transform sampling, walking the pmf with its ratio recurrence
+        double p = std::exp(logChoose(successes, low) + logChoose(population - successes, draws - low)
+                            - logChoose(population, draws));
+        double u = std::uniform_real_distribution<double>(0.0, 1.0)(rng);
+        for (int k = low; k < high; ++k) {
+            if (u < p) {
+                return k;
+            }
+            u -= p;
+            p *= static_cast<double>(successes - k) * (draws - k) /
+                 (static_cast<double>(k + 1) * (population - successes - draws + k + 1));
+        }
+        return high;
+    }
+
+// Draw cards uniformly at random from a hand with one multivariate hypergeometric draw
+    ResourceCounts drawWithoutReplacement(const ResourceCounts &hand, int draws, std::mt19937 &rng) {
+        ResourceCounts drawn;
+        int remaining = hand.total();
+        draws = std::clamp(draws, 0, remaining);
+
+        for (std::size_t i = 0; i < RESOURCE_TYPE_COUNT && draws > 0; ++i) {
+            int taken = (i + 1 == RESOURCE_TYPE_COUNT) ? draws : drawHypergeometric(remaining, hand[i], draws, rng);
+            drawn[i] = taken;
+            draws -= taken;
+            remaining -= hand[i];
+        }
+        return drawn;
+    }
+
+// DiscardStrategy Implementation
+
+    DiscardStrategy::~DiscardStrategy() = default;
+
+// RandomDiscardStrategy Implementation
+
+    RandomDiscardStrategy::RandomDiscardStrategy() : _rng(std::random_device{}()) {}
+
+    RandomDiscardStrategy::RandomDiscardStrategy(std::uint32_t seed) : _rng(seed) {}
+
+    ResourceCounts RandomDiscardStrategy::chooseDiscard(const Player &, const ResourceCounts &hand, int amount) {
+        return drawWithoutReplacement(hand, amount, _rng);
+    }
+
+// GreedyDiscardStrategy Implementation
+
+    ResourceCounts GreedyDiscardStrategy::chooseDiscard(const Player &, const ResourceCounts &hand, int amount) {
+        ResourceCounts left = hand;
+        ResourceCounts discard;
+        amount = std::clamp(amount, 0, hand.total());
+
+        // Level the largest piles down one card at a time; ties go to the lower resource index
+        while (amount > 0) {
+            std::size_t largest = 0;
+            for (std::size_t i = 1; i < RESOURCE_TYPE_COUNT; ++i) {
+                if (left[i] > left[largest]) {
+                    largest = i;
+                }
+            }
+            left[largest]--;
+            discard[largest]++;
+            amount--;
+        }
+        return discard;
+    }
+
+// BotDiscardStrategy Implementation
+
+    BotDiscardStrategy::BotDiscardStrategy(Chooser chooser) : _chooser(std::move(chooser)) {}
+
+    ResourceCounts BotDiscardStrategy::chooseDiscard(const Player &player, const ResourceCounts &hand, int amount) {
+        return _chooser(player, hand, amount);
+    }
+
+} // namespace game
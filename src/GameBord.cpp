@@ -3,6 +3,8 @@
 #include "Terrain.hpp"
 #include "DevelopmentCard.hpp"
 #include "Property.hpp"
+#include "Player.hpp"
+#include <algorithm>
 #include <stdexcept>
 #include <cstdlib>
 
@@ -19,7 +21,7 @@ using namespace game;
  */
 
 // Constructor for GameBoard
-GameBoard::GameBoard() {
+GameBoard::GameBoard() : _rng(std::random_device{}()) {
 
     // Initialize resource names
     string forest("Lumber");
@@ -201,6 +203,26 @@ GameBoard::GameBoard() {
     t18->setTerrainNum(2);
     t19->setTerrainNum(6);
 
+    // Set harbors, each reachable from both nodes of a coastal pathway
+    n1->setHarbor(HarborType::Generic);
+    n2->setHarbor(HarborType::Generic);
+    n4->setHarbor(HarborType::Wool);
+    n5->setHarbor(HarborType::Wool);
+    n6->setHarbor(HarborType::Generic);
+    n7->setHarbor(HarborType::Generic);
+    n24->setHarbor(HarborType::Ore);
+    n8->setHarbor(HarborType::Ore);
+    n26->setHarbor(HarborType::Generic);
+    n27->setHarbor(HarborType::Generic);
+    n38->setHarbor(HarborType::Grain);
+    n37->setHarbor(HarborType::Grain);
+    n39->setHarbor(HarborType::Brick);
+    n40->setHarbor(HarborType::Brick);
+    n48->setHarbor(HarborType::Generic);
+    n49->setHarbor(HarborType::Generic);
+    n51->setHarbor(HarborType::Lumber);
+    n52->setHarbor(HarborType::Lumber);
+
     // Populate node connections
     n1->addPathway(p1);
     n1->addPathway(p2);
@@ -851,6 +873,10 @@ GameBoard::GameBoard() {
     _terrains.push_back(t18);
     _terrains.push_back(t19);
 
+    // Compile the adjacency set up above into the flat board graph
+    _graph.build(_nodes, _pathways, _terrains);
+    _production.build(_graph, _terrains);
+
     // Initialize development cards
     auto *monopolyCard = static_cast<DevelopmentCard *>(new MonopolyCard());
     DevelopmentCard *victoryPointCard = new VictoryPointCard();
@@ -889,6 +915,59 @@ GameBoard::~GameBoard() {
     }
 }
 
+// Get the adjacency graph of the board
+const BoardGraph &GameBoard::getGraph() const {
+    return _graph;
+}
+
+// Get the production data of the board
+const ProductionTable &GameBoard::getProduction() const {
+    return _production;
+}
+
+// Pay out a roll to every player, following the bank shortage rule
+void GameBoard::produce(int roll) {
+    std::array<ResourceCounts, ProductionTable::MAX_SEATS> gains{};
+    std::span<ResourceCounts> seats(gains.data(), _players.size());
+    _production.produce(roll, seats);
+
+    for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+        int owed = 0, players = 0;
+        for (const ResourceCounts &cards : seats) {
+            owed += cards[r];
+            players += cards[r] > 0;
+        }
+        int supply = _bank.getSupply()[r];
+        if (owed > supply) {
+            for (ResourceCounts &cards : seats) {
+                cards[r] = players == 1 ? std::min(cards[r], supply) : 0;
+            }
+        }
+    }
+
+    for (std::size_t seat = 0; seat < seats.size(); ++seat) {
+        if (seats[seat].total() > 0 && _bank.withdraw(seats[seat])) {
+            _players[seat]->receiveProduction(seats[seat]);
+        }
+    }
+}
+
+// Move the robber to another terrain
+void GameBoard::moveRobber(int index, int seat) {
+    _production.moveRobber(index);
+
+    GameAction action;
+    action.type = ActionType::MoveRobber;
+    action.seat = static_cast<std::uint8_t>(std::max(seat, 0));
+    action.value = index;
+    publish(action);
+}
+
+// Get the terrain holding the robber
+int GameBoard::getRobber() const {
+    return _production.getRobber();
+}
+
 // Retrieve the node at the specified index
 Node *GameBoard::locateNode(int index) {
     if (index>0 && index<=54) {
@@ -898,20 +977,31 @@ Node *GameBoard::locateNode(int index) {
 
 // Retrieve the pathway at the specified index
 strategy::Pathway *GameBoard::locatePathway(int index) {
-    return _pathways[index-1];
+    if (index > 0 && index <= (int) _pathways.size()) {
+        return _pathways[index - 1];
+    } else return nullptr;
 }
 
 // Retrieve the terrain at the specified index
 Terrain *GameBoard::locateTerrain(int index) {
     return _terrains[index];
 }
-vector<Terrain *> GameBoard:: getTerrains() {
+
+// Get a view of all terrains
+std::span<Terrain *const> GameBoard::getTerrains() const {
     return _terrains;
 }
-vector<Node *> GameBoard:: getNodes() {
+
+// Get a view of all nodes
+std::span<Node *const> GameBoard::getNodes() const {
     return _nodes;
 }
 
+// Get a view of all pathways
+std::span<Pathway *const> GameBoard::getPathways() const {
+    return _pathways;
+}
+
 // Draw a random development card from the deck
 DevelopmentCard *GameBoard::drawRandomDevCard() {
     if (_devCardDeck.empty()) {
@@ -928,13 +1018,142 @@ DevelopmentCard *GameBoard::drawRandomDevCard() {
     if (availableCards.empty()) {
         return nullptr;
     }
+    // The deck is keyed by address, so order the kinds to draw the same card from the same seed
+    std::sort(availableCards.begin(), availableCards.end(), [](DevelopmentCard *a, DevelopmentCard *b) {
+        return a->cardTypeId() < b->cardTypeId();
+    });
 
-    unsigned int randomIndex = rand() % availableCards.size();
-    DevelopmentCard *selectedCard = availableCards[randomIndex];
+    std::uniform_int_distribution<std::size_t> dis(0, availableCards.size() - 1);
+    DevelopmentCard *selectedCard = availableCards[dis(_rng)];
     _devCardDeck[selectedCard]--;
     return selectedCard->cloneCard();
 }
 
+// Draw a development card of a specific kind from the deck
+DevelopmentCard *GameBoard::drawDevCard(DevCardType type) {
+    for (auto &pair : _devCardDeck) {
+        if (pair.first->cardTypeId() == type && pair.second > 0) {
+            pair.second--;
+            return pair.first->cloneCard();
+        }
+    }
+    return nullptr;
+}
+
+// Seed the random engine used to draw development cards
+void GameBoard::seedRandom(std::uint32_t seed) {
+    _rng.seed(seed);
+}
+
+// Register a player and assign them a seat
+int GameBoard::registerPlayer(game::Player *player) {
+    auto it = std::find(_players.begin(), _players.end(), player);
+    if (it != _players.end()) {
+        return (int) (it - _players.begin());
+    }
+    if (_players.size() == ProductionTable::MAX_SEATS) {
+        throw std::logic_error("Error: All seats at the game board are taken.");
+    }
+    _players.push_back(player);
+    return (int) _players.size() - 1;
+}
+
+// Retrieve the player sitting at a seat
+game::Player *GameBoard::getPlayer(int seat) const {
+    if (seat >= 0 && seat < (int) _players.size()) {
+        return _players[seat];
+    }
+    return nullptr;
+}
+
+// Get the number of players registered with the board
+int GameBoard::getPlayerCount() const {
+    return (int) _players.size();
+}
+
+// Register an observer of board actions
+void GameBoard::addObserver(GameObserver *observer) {
+    if (observer && std::find(_observers.begin(), _observers.end(), observer) == _observers.end()) {
+        _observers.push_back(observer);
+    }
+}
+
+// Unregister an observer of board actions
+void GameBoard::removeObserver(GameObserver *observer) {
+    _observers.erase(std::remove(_observers.begin(), _observers.end(), observer), _observers.end());
+}
+
+// Notify all observers of an action
+void GameBoard::publish(const GameAction &action) {
+    if (action.type == ActionType::InitialSettlement || action.type == ActionType::BuildSettlement) {
+        _production.setBuilding(action.value - 1, action.seat, 1);
+    } else if (action.type == ActionType::UpgradeToCity) {
+        _production.setBuilding(action.value - 1, action.seat, 2);
+    }
+    for (GameObserver *observer : _observers) {
+        observer->onAction(action);
+    }
+}
+
+// Count the cards of a kind left in the deck
+int GameBoard::countDeckCards(DevCardType type) const {
+    int count = 0;
+    for (const auto &pair : _devCardDeck) {
+        if (pair.first->cardTypeId() == type) {
+            count += pair.second;
+        }
+    }
+    return count;
+}
+
+// Set the number of cards left of every kind
+void GameBoard::restoreDeck(const std::array<std::uint8_t, DEV_CARD_TYPE_COUNT> &counts) {
+    for (auto &pair : _devCardDeck) {
+        pair.second = counts[static_cast<std::size_t>(pair.first->cardTypeId())];
+    }
+}
+
+// Place a saved building without paying or publishing it
+void GameBoard::restoreBuilding(int nodeId, int seat, bool city) {
+    Node *node = locateNode(nodeId);
+    game::Player *owner = getPlayer(seat);
+    if (!node || !owner) {
+        throw std::out_of_range("Error: No such node or seat to restore a building on.");
+    }
+    if (city) {
+        node->setCity(new City(owner));
+    } else {
+        node->setSettlement(new Settelment(owner));
+    }
+    owner->claimHarbor(node->getHarbor());
+    _production.setBuilding(static_cast<std::size_t>(nodeId - 1), seat, city ? 2 : 1);
+}
+
+// Place a saved road without paying or publishing it
+void GameBoard::restoreRoad(int pathwayId, int seat) {
+    Pathway *pathway = locatePathway(pathwayId);
+    game::Player *owner = getPlayer(seat);
+    if (!pathway || !owner) {
+        throw std::out_of_range("Error: No such pathway or seat to restore a road on.");
+    }
+    pathway->setOccupied(true);
+    pathway->setPath(new Pathway(pathway->getId(), pathway->getNode1(), pathway->getNode2()));
+    pathway->setPlayer(owner);
+}
+
+// Place the robber without publishing it
+void GameBoard::restoreRobber(int index) {
+    _production.moveRobber(index);
+}
+
+// Virtual destructor for GameObserver
+GameObserver::~GameObserver() = default;
+
+// Get the bank of this game
+Bank &GameBoard::getBank() {
+    return _bank;
+}
+
 // Display all nodes, pathways, and terrains on the board
 void GameBoard::displayBoard() {
     for (auto & _node : _nodes) {
@@ -0,0 +1,29 @@
+#include "GameLog.hpp"
+#include <atomic>
+#include <iostream>
+
+namespace game {
+
+    static std::atomic<bool> logEnabled{true}; ///< Whether messages go to std::cout.
+
+// Get the stream for game messages
+    std::ostream &gameLog() {
+        if (logEnabled.load(std::memory_order_relaxed)) {
+            return std::cout;
+        }
+        // A stream without a buffer drops everything; one per thread so the error state is never shared
+        thread_local std::ostream discard(nullptr);
+        return discard;
+    }
+
+// Enable or disable game messages
+    void setGameLogEnabled(bool enabled) {
+        logEnabled.store(enabled, std::memory_order_relaxed);
+    }
+
+// Check whether game messages are written
+    bool isGameLogEnabled() {
+        return logEnabled.load(std::memory_order_relaxed);
+    }
+
+} // namespace game
@@ -1,5 +1,9 @@
 #include "GameOperator.hpp"
+#include "GameLog.hpp"
+#include "Instrumentation.hpp"
 #include <iostream>
+#include <stdexcept>
+#include <utility>
 using namespace std;
 using namespace strategy;
 /**
@@ -21,7 +25,7 @@ void GameOperator::setPlayers(game::Player *p1,game:: Player *p2,game:: Player *
         this->_players.push_back(p2);
         this->_players.push_back(p3);
     } else {
-        cout << "Error: One or more player pointers are null." << endl;
+        game::gameLog() << "Error: One or more player pointers are null." << endl;
     }
 }
 
@@ -30,17 +34,17 @@ GameBoard *GameOperator::getBoard() { return this->_board; }
 
 // Start the game - player #1 always starts
 void GameOperator::initiateGame() {
-    cout << "                                                   \n\n\n" << endl;
-    cout << "---------------------------------------- LET'S START PLAYING ---------------------------------------------"
+    game::gameLog() << "                                                   \n\n\n" << endl;
+    game::gameLog() << "---------------------------------------- LET'S START PLAYING ---------------------------------------------"
          << endl;
-    cout << "------------------------------------- NODES: 54 ______ PATHS: 72 -----------------------------------------"
+    game::gameLog() << "------------------------------------- NODES: 54 ______ PATHS: 72 -----------------------------------------"
          << endl;
-    cout << "----------------------- PLAYER#1: " << this->_players[0]->getName()
+    game::gameLog() << "----------------------- PLAYER#1: " << this->_players[0]->getName()
          << "      PLAYER#2: " << this->_players[1]->getName()
          << "      PLAYER#3: " << this->_players[2]->getName() << " --------------------------" << endl;
-    cout << "----------------------------------------------------------------------------------------------------------"
+    game::gameLog() << "----------------------------------------------------------------------------------------------------------"
          << endl;
-    cout << "                                                   " << endl;
+    game::gameLog() << "                                                   " << endl;
     this->_players[0]->setNextPlayer(_players[1]);
     this->_players[1]->setNextPlayer(_players[2]);
     this->_players[2]->setNextPlayer(_players[0]);
@@ -55,18 +59,19 @@ void GameOperator::initiateGame() {
     this->_players[0]->activateTurn(true);
 }
 
-// Print the winner if a player reaches 10 points
+// Print the winner if a player reaches the winning score
 int GameOperator::declareWinner() {
+    CATAN_PROBE_SCOPE(WinnerCheck);
     for (game::Player *p : this->_players) {
-        if (p->calculateScore() == 10) {
-            cout << "---------- GAME OVER ----------" << endl;
-            cout << "     THE WINNER IS-- " << p->getName() << "      " << endl;
+        if (p->calculateScore() >= WINNING_SCORE) {
+            game::gameLog() << "---------- GAME OVER ----------" << endl;
+            game::gameLog() << "     THE WINNER IS-- " << p->getName() << "      " << endl;
             return 1;
         }
     }
-    cout << "---------- GAME NOT OVER ----------" << endl;
-    cout << "---No player has 10 points yet---" << endl;
-    cout << "---Continue the Game...---" << endl;
+    game::gameLog() << "---------- GAME NOT OVER ----------" << endl;
+    game::gameLog() << "---No player has " << WINNING_SCORE << " points yet---" << endl;
+    game::gameLog() << "---Continue the Game...---" << endl;
     return 0;
 }
 
@@ -74,3 +79,49 @@ int GameOperator::declareWinner() {
 vector<game::Player *> GameOperator::getPlayers() {
     return this->_players;
 }
+
+// Check the agents and start the coroutine playing the turns
+GameTask GameOperator::playTurns(vector<PlayerAgent *> agents, int maxTurns) {
+    if (agents.size() != this->_players.size()) {
+        throw invalid_argument("Error: Every player needs exactly one agent.");
+    }
+    for (PlayerAgent *agent : agents) {
+        if (!agent) {
+            throw invalid_argument("Error: An agent is null.");
+        }
+    }
+    return driveTurns(std::move(agents), maxTurns);
+}
+
+// Roll for the active player, then apply the moves its agent decides, suspending while the agent waits
+GameTask GameOperator::driveTurns(vector<PlayerAgent *> agents, int maxTurns) {
+    SimulationResult result;
+    while (result.winnerSeat < 0 && result.turns < maxTurns) {
+        size_t seat = 0;
+        while (seat < this->_players.size() && !this->_players[seat]->isTurnActive()) {
+            seat++;
+        }
+        if (seat == this->_players.size()) {
+            throw logic_error("Error: No player has an active turn.");
+        }
+        game::Player &player = *this->_players[seat];
+        player.rollDiceAndMove();
+        result.turns++;
+
+        for (int moves = 0; moves < MAX_MOVES_PER_TURN && player.calculateScore() < WINNING_SCORE; ++moves) {
+            const Move move = co_await MoveRequest(*agents[seat], player, result.turns);
+            if (move.type == MoveType::EndTurn) {
+                break;
+            }
+            applyMove(player, move);
+        }
+
+        for (size_t i = 0; i < this->_players.size(); ++i) {
+            if (this->_players[i]->calculateScore() >= WINNING_SCORE) {
+                result.winnerSeat = static_cast<int>(i);
+                break;
+            }
+        }
+    }
+    co_return result;
+}
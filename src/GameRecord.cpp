@@ -0,0 +1,506 @@
+#include "GameRecord.hpp"
+#include "GameLog.hpp"
+#include "Node.hpp"
+#include "Terrain.hpp"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace game;
+
+namespace strategy {
+
+    static const char LOG_MAGIC[8] = {'C', 'A', 'T', 'A', 'N', 'L', 'O', 'G'};
+    static constexpr std::size_t LOG_PREAMBLE_SIZE = sizeof(LOG_MAGIC) + 1; ///< Magic string and version byte.
+    static constexpr std::uint8_t GAME_START_TAG = 0xF0;
+    static constexpr std::uint8_t GAME_END_TAG = 0xF1;
+
+// Append an unsigned LEB128 varint
+    void writeVarint(std::vector<std::uint8_t> &out, std::uint64_t value) {
+        while (value >= 0x80) {
+            out.push_back(static_cast<std::uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back(static_cast<std::uint8_t>(value));
+    }
+
+// Decode an unsigned LEB128 varint
+    bool readVarint(const std::uint8_t *&pos, const std::uint8_t *end, std::uint64_t &value) {
+        value = 0;
+        for (int shift = 0; shift < 70 && pos < end; shift += 7) {
+            std::uint8_t byte = *pos++;
+            value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+// Append the five counts of a resource vector
+    static void writeCounts(std::vector<std::uint8_t> &out, const ResourceCounts &counts) {
+        for (int count : counts.counts) {
+            writeVarint(out, static_cast<std::uint64_t>(count));
+        }
+    }
+
+// Encode one action: tag, seat, then the fields used by its type
+    void writeAction(std::vector<std::uint8_t> &out, const GameAction &action) {
+        out.push_back(static_cast<std::uint8_t>(action.type));
+        writeVarint(out, action.seat);
+
+        switch (action.type) {
+            case ActionType::Roll:
+                writeVarint(out, static_cast<std::uint64_t>(action.value << 3 | action.extra));
+                break;
+            case ActionType::Discard:
+                writeCounts(out, action.give);
+                break;
+            case ActionType::PlayerTrade:
+                writeVarint(out, action.partner);
+                writeCounts(out, action.give);
+                writeCounts(out, action.receive);
+                break;
+            case ActionType::BankTrade:
+                writeCounts(out, action.give);
+                writeCounts(out, action.receive);
+                break;
+            default:
+                writeVarint(out, static_cast<std::uint64_t>(action.value));
+                break;
+        }
+    }
+
+// Decode the five counts of a resource vector
+    static bool readCounts(const std::uint8_t *&pos, const std::uint8_t *end, ResourceCounts &counts) {
+        for (int &count : counts.counts) {
+            std::uint64_t value;
+            if (!readVarint(pos, end, value)) {
+                return false;
+            }
+            count = static_cast<int>(value);
+        }
+        return true;
+    }
+
+// Decode one action, filling in the costs its type implies
+    bool readAction(const std::uint8_t *&pos, const std::uint8_t *end, GameAction &action) {
+        if (pos >= end || *pos < static_cast<std::uint8_t>(ActionType::InitialSettlement) ||
+            *pos > static_cast<std::uint8_t>(ActionType::MoveRobber)) {
+            return false;
+        }
+        action = GameAction();
+        action.type = static_cast<ActionType>(*pos++);
+        std::uint64_t value;
+        if (!readVarint(pos, end, value)) {
+            return false;
+        }
+        action.seat = static_cast<std::uint8_t>(value);
+        switch (action.type) {
+            case ActionType::Roll:
+                if (!readVarint(pos, end, value)) {
+                    return false;
+                }
+                action.value = static_cast<int>(value >> 3);
+                action.extra = static_cast<int>(value & 7);
+                break;
+            case ActionType::Discard:
+                if (!readCounts(pos, end, action.give)) {
+                    return false;
+                }
+                break;
+            case ActionType::PlayerTrade:
+                if (!readVarint(pos, end, value)) {
+                    return false;
+                }
+                action.partner = static_cast<std::uint8_t>(value);
+                if (!readCounts(pos, end, action.give) || !readCounts(pos, end, action.receive)) {
+                    return false;
+                }
+                break;
+            case ActionType::BankTrade:
+                if (!readCounts(pos, end, action.give) || !readCounts(pos, end, action.receive)) {
+                    return false;
+                }
+                break;
+            default:
+                if (!readVarint(pos, end, value)) {
+                    return false;
+                }
+                action.value = static_cast<int>(value);
+                break;
+        }
+
+        // Building costs are implied by the action type
+        if (action.type == ActionType::BuildPathway) action.give = Player::ROAD_COST;
+        else if (action.type == ActionType::BuildSettlement) action.give = Player::SETTLEMENT_COST;
+        else if (action.type == ActionType::UpgradeToCity) action.give = Player::CITY_COST;
+        else if (action.type == ActionType::BuyDevelopmentCard) action.give = Player::DEVELOPMENT_CARD_COST;
+        return true;
+    }
+
+// Capture the board layout and players of a game
+    GameHeader describeGame(GameBoard &board, std::uint64_t seed) {
+        GameHeader header;
+        header.seed = seed;
+        for (int seat = 0; seat < board.getPlayerCount(); ++seat) {
+            header.playerNames.push_back(board.getPlayer(seat)->getName());
+        }
+        for (Terrain *terrain : board.getTerrains()) {
+            header.terrains.push_back({terrain->getResourceType(), terrain->getTerrainNum()});
+        }
+        for (Node *node : board.getNodes()) {
+            if (node->getHarbor() != HarborType::None) {
+                header.harbors.emplace_back(node->getId(), node->getHarbor());
+            }
+        }
+        return header;
+    }
+
+// GameRecordWriter Implementation
+
+// Open the log, writing the preamble if the file is new
+    GameRecordWriter::GameRecordWriter(std::string path) : _path(std::move(path)) {
+        std::fstream file(_path, std::ios::binary | std::ios::in | std::ios::out | std::ios::app);
+        if (!file) {
+            throw std::runtime_error("Error: Cannot open game log " + _path + ".");
+        }
+        file.seekg(0, std::ios::end);
+        if (file.tellg() == 0) {
+            file.write(LOG_MAGIC, sizeof(LOG_MAGIC));
+            file.put(static_cast<char>(FORMAT_VERSION));
+            return;
+        }
+
+        char preamble[LOG_PREAMBLE_SIZE];
+        file.seekg(0);
+        if (!file.read(preamble, LOG_PREAMBLE_SIZE) || std::memcmp(preamble, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 ||
+            static_cast<std::uint8_t>(preamble[sizeof(LOG_MAGIC)]) != FORMAT_VERSION) {
+            throw std::runtime_error("Error: " + _path + " is not a game log of a supported version.");
+        }
+    }
+
+// Encode the header of a new game
+    void GameRecordWriter::beginGame(const GameHeader &header) {
+        _buffer.clear();
+        _inGame = true;
+        _buffer.push_back(GAME_START_TAG);
+        writeVarint(_buffer, header.seed);
+        writeVarint(_buffer, header.playerNames.size());
+        for (const std::string &name : header.playerNames) {
+            writeVarint(_buffer, name.size());
+            _buffer.insert(_buffer.end(), name.begin(), name.end());
+        }
+        writeVarint(_buffer, header.terrains.size());
+        for (const TerrainLayout &terrain : header.terrains) {
+            _buffer.push_back(static_cast<std::uint8_t>(terrain.resource));
+            writeVarint(_buffer, static_cast<std::uint64_t>(terrain.number));
+        }
+        writeVarint(_buffer, header.harbors.size());
+        for (const auto &harbor : header.harbors) {
+            writeVarint(_buffer, static_cast<std::uint64_t>(harbor.first));
+            _buffer.push_back(static_cast<std::uint8_t>(harbor.second));
+        }
+    }
+
+// Record one action of the open game
+    void GameRecordWriter::onAction(const GameAction &action) {
+        if (!_inGame) {
+            return;
+        }
+        writeAction(_buffer, action);
+    }
+
+// Append the finished game to the log in one write
+    void GameRecordWriter::endGame(int winnerSeat) {
+        if (!_inGame) {
+            return;
+        }
+        _buffer.push_back(GAME_END_TAG);
+        writeVarint(_buffer, static_cast<std::uint64_t>(winnerSeat + 1));
+        _inGame = false;
+
+        std::ofstream file(_path, std::ios::binary | std::ios::app);
+        if (!file.write(reinterpret_cast<const char *>(_buffer.data()), (std::streamsize) _buffer.size())) {
+            throw std::runtime_error("Error: Cannot write to game log " + _path + ".");
+        }
+        _buffer.clear();
+    }
+
+// GameRecordCursor Implementation
+
+    GameRecordCursor::GameRecordCursor(const std::uint8_t *begin, const std::uint8_t *end) : _pos(begin), _end(end) {}
+
+// Decode one varint or fail on truncated input
+    std::uint64_t GameRecordCursor::readValue() {
+        std::uint64_t value;
+        if (!readVarint(_pos, _end, value)) {
+            throw std::runtime_error("Error: Truncated game log.");
+        }
+        return value;
+    }
+
+// Skip the rest of the current game and decode the next header
+    bool GameRecordCursor::nextGame(GameHeader &header) {
+        GameAction skipped;
+        while (_pos < _end && *_pos != GAME_START_TAG) {
+            nextAction(skipped);
+        }
+        if (_pos >= _end) {
+            return false;
+        }
+        _pos++;
+
+        header = GameHeader();
+        header.seed = readValue();
+        std::uint64_t players = readValue();
+        for (std::uint64_t i = 0; i < players; ++i) {
+            std::uint64_t length = readValue();
+            if (length > static_cast<std::uint64_t>(_end - _pos)) {
+                throw std::runtime_error("Error: Truncated game log.");
+            }
+            header.playerNames.emplace_back(reinterpret_cast<const char *>(_pos), length);
+            _pos += length;
+        }
+        std::uint64_t terrains = readValue();
+        for (std::uint64_t i = 0; i < terrains; ++i) {
+            if (_pos >= _end) {
+                throw std::runtime_error("Error: Truncated game log.");
+            }
+            if (*_pos > static_cast<std::uint8_t>(ResourceType::None)) {
+                throw std::runtime_error("Error: Unknown terrain resource in game log.");
+            }
+            auto resource = static_cast<ResourceType>(*_pos++);
+            header.terrains.push_back({resource, static_cast<int>(readValue())});
+        }
+        std::uint64_t harbors = readValue();
+        for (std::uint64_t i = 0; i < harbors; ++i) {
+            int node = static_cast<int>(readValue());
+            if (_pos >= _end) {
+                throw std::runtime_error("Error: Truncated game log.");
+            }
+            header.harbors.emplace_back(node, static_cast<HarborType>(*_pos++));
+        }
+        return true;
+    }
+
+// Decode the next action of the current game
+    bool GameRecordCursor::nextAction(GameAction &action) {
+        if (_pos >= _end || *_pos == GAME_START_TAG) {
+            return false;
+        }
+        std::uint8_t tag = *_pos;
+        if (tag == GAME_END_TAG) {
+            _pos++;
+            _winner = static_cast<int>(readValue()) - 1;
+            return false;
+        }
+        if (tag < static_cast<std::uint8_t>(ActionType::InitialSettlement) ||
+            tag > static_cast<std::uint8_t>(ActionType::MoveRobber)) {
+            throw std::runtime_error("Error: Unknown record in game log.");
+        }
+        if (!readAction(_pos, _end, action)) {
+            throw std::runtime_error("Error: Truncated game log.");
+        }
+        return true;
+    }
+
+// Get the winner of the last finished game
+    int GameRecordCursor::winner() const {
+        return _winner;
+    }
+
+// GameRecordReader Implementation
+
+// Map the log file and check its preamble
+    GameRecordReader::GameRecordReader(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Error: Cannot open game log " + path + ".");
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || static_cast<std::size_t>(info.st_size) < LOG_PREAMBLE_SIZE) {
+            ::close(fd);
+            throw std::runtime_error("Error: " + path + " is not a game log.");
+        }
+        _size = static_cast<std::size_t>(info.st_size);
+        void *mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Error: Cannot map game log " + path + ".");
+        }
+        ::madvise(mapping, _size, MADV_SEQUENTIAL);
+        _data = static_cast<const std::uint8_t *>(mapping);
+
+        if (std::memcmp(_data, LOG_MAGIC, sizeof(LOG_MAGIC)) != 0 ||
+            _data[sizeof(LOG_MAGIC)] != GameRecordWriter::FORMAT_VERSION) {
+            ::munmap(const_cast<std::uint8_t *>(_data), _size);
+            throw std::runtime_error("Error: " + path + " is not a game log of a supported version.");
+        }
+    }
+
+// Unmap the log file
+    GameRecordReader::~GameRecordReader() {
+        ::munmap(const_cast<std::uint8_t *>(_data), _size);
+    }
+
+// Get a cursor before the first game
+    GameRecordCursor GameRecordReader::games() const {
+        return {_data + LOG_PREAMBLE_SIZE, _data + _size};
+    }
+
+// GameReplayer Implementation
+
+// Build a board and players matching the recorded game
+    GameReplayer::GameReplayer(const GameHeader &header, const GameRecordCursor &cursor)
+            : _cursor(cursor), _board(std::make_unique<GameBoard>()) {
+        if (header.playerNames.size() != 3) {
+            throw std::invalid_argument("Error: Only three-player games can be replayed.");
+        }
+        GameHeader expected = describeGame(*_board, header.seed);
+        bool sameTerrains = expected.terrains.size() == header.terrains.size();
+        for (std::size_t i = 0; sameTerrains && i < header.terrains.size(); ++i) {
+            sameTerrains = expected.terrains[i].resource == header.terrains[i].resource &&
+                           expected.terrains[i].number == header.terrains[i].number;
+        }
+        if (!sameTerrains || expected.harbors != header.harbors) {
+            throw std::invalid_argument("Error: The recorded board does not match the game board.");
+        }
+
+        _pendingDiscards.resize(header.playerNames.size());
+        for (std::size_t seat = 0; seat < header.playerNames.size(); ++seat) {
+            _players.push_back(std::make_unique<Player>(header.playerNames[seat]));
+            Player &player = *_players.back();
+            player.assignGameBoard(_board.get());
+            player.setDiscardStrategy(std::make_unique<BotDiscardStrategy>(
+                    [this, seat](const Player &, const ResourceCounts &, int) { return _pendingDiscards[seat]; }));
+        }
+        _operator.setPlayers(_players[0].get(), _players[1].get(), _players[2].get());
+        _operator.initiateGame();
+    }
+
+// Apply a single recorded action through the regular player interface
+    void GameReplayer::apply(const GameAction &action) {
+        Player &player = getPlayer(action.seat);
+        switch (action.type) {
+            case ActionType::InitialSettlement:
+                player.establishInitialSettlement(action.value);
+                break;
+            case ActionType::InitialPathway:
+                player.establishInitialPathway(action.value);
+                break;
+            case ActionType::Roll:
+                player.rollDiceAndMove(action.value, action.extra);
+                _turn++;
+                break;
+            case ActionType::Discard:
+                _pendingDiscards[action.seat] = action.give;
+                player.discardHalf();
+                break;
+            case ActionType::BuildPathway:
+                player.buildPathway(action.value);
+                break;
+            case ActionType::BuildSettlement:
+                player.buildSettlement(action.value);
+                break;
+            case ActionType::UpgradeToCity:
+                player.upgradeToCity(action.value);
+                break;
+            case ActionType::BuyDevelopmentCard:
+                player.acquireDevelopmentCard(static_cast<DevCardType>(action.value));
+                break;
+            case ActionType::PlayDevelopmentCard:
+                player.activateDevelopmentCard(player.findDevelopmentCard(static_cast<DevCardType>(action.value)));
+                break;
+            case ActionType::PlayerTrade:
+                player.exchangeResources(&getPlayer(action.partner), action.give, action.receive);
+                break;
+            case ActionType::BankTrade: {
+                std::size_t give = 0, receive = 0;
+                for (std::size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i) {
+                    if (action.give[i] > 0) give = i;
+                    if (action.receive[i] > 0) receive = i;
+                }
+                player.tradeWithBank(static_cast<ResourceType>(give), static_cast<ResourceType>(receive),
+                                     action.receive[receive]);
+                break;
+            }
+            case ActionType::MoveRobber:
+                _board->moveRobber(action.value, action.seat);
+                break;
+        }
+    }
+
+// Apply the next action; the discards caused by a 7 are read together with the roll
+    bool GameReplayer::step() {
+        GameAction action;
+        if (_finished || !_cursor.nextAction(action)) {
+            _finished = true;
+            return false;
+        }
+
+        if (action.type == ActionType::Roll) {
+            std::fill(_pendingDiscards.begin(), _pendingDiscards.end(), ResourceCounts{});
+            GameRecordCursor ahead = _cursor;
+            GameAction next;
+            while (ahead.nextAction(next) && next.type == ActionType::Discard) {
+                _pendingDiscards[next.seat] = next.give;
+                _cursor = ahead;
+            }
+        }
+        apply(action);
+        return true;
+    }
+
+// Apply actions until right before the roll that starts the next turn
+    int GameReplayer::replayUntilTurn(int turn) {
+        while (!_finished) {
+            GameRecordCursor ahead = _cursor;
+            GameAction next;
+            if (!ahead.nextAction(next)) {
+                _cursor = ahead;
+                _finished = true;
+                break;
+            }
+            if (next.type == ActionType::Roll && _turn >= turn) {
+                break;
+            }
+            step();
+        }
+        return _turn;
+    }
+
+// Get the number of turns replayed so far
+    int GameReplayer::getTurn() const {
+        return _turn;
+    }
+
+// Check whether all recorded actions were applied
+    bool GameReplayer::isFinished() const {
+        return _finished;
+    }
+
+// Get the cursor after the last applied action
+    const GameRecordCursor &GameReplayer::getCursor() const {
+        return _cursor;
+    }
+
+// Get the rebuilt board
+    GameBoard &GameReplayer::getBoard() {
+        return *_board;
+    }
+
+// Get the rebuilt player at a seat
+    Player &GameReplayer::getPlayer(int seat) {
+        if (seat < 0 || seat >= (int) _players.size()) {
+            throw std::out_of_range("Error: No player at seat " + std::to_string(seat) + ".");
+        }
+        return *_players[seat];
+    }
+
+} // namespace strategy
@@ -0,0 +1,162 @@
+#include "GameSimulator.hpp"
+#include "PlacementSolver.hpp"
+#include "Node.hpp"
+#include "Terrain.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+using namespace game;
+
+namespace strategy {
+
+// Build the board and the bots, seeding everything random from the game seed
+    GameSimulator::GameSimulator(std::uint64_t seed) : _seed(seed), _board(std::make_unique<GameBoard>()) {
+        auto base = static_cast<std::uint32_t>(seed ^ (seed >> 32));
+        _board->seedRandom(base);
+        for (std::uint32_t seat = 0; seat < 3; ++seat) {
+            _players.push_back(std::make_unique<Player>("Bot " + std::to_string(seat + 1)));
+            Player &player = *_players.back();
+            player.assignGameBoard(_board.get());
+            player.seedRandom(base + 2 * seat + 1);
+            player.setDiscardStrategy(std::make_unique<RandomDiscardStrategy>(base + 2 * seat + 2));
+        }
+        _operator.setPlayers(_players[0].get(), _players[1].get(), _players[2].get());
+        _operator.initiateGame();
+    }
+
+// Record the games played by play() to a log
+    void GameSimulator::setRecorder(GameRecordWriter *recorder) {
+        _recorder = recorder;
+    }
+
+// Trace the turns of the game
+    void GameSimulator::setTracer(GameTracer *tracer) {
+        _tracer = tracer;
+    }
+
+// Place the settlement and road the placement solver ranks first, on this thread only
+    void GameSimulator::playSetup() {
+        PlacementOptions options;
+        options.threadCount = 1;
+        options.limit = 1;
+        const int players = static_cast<int>(_players.size());
+        for (int pick = 0; pick < 2 * players; ++pick) {
+            Player &player = *_players[PlacementSolver::seatOfPick(pick, players)];
+            TraceSpan placement(_tracer, "Setup", "phase", player, 0);
+            std::vector<Placement> best;
+            {
+                TraceSpan search(_tracer, "PlacementSearch", "search", player, 0);
+                best = PlacementSolver(*_board, players, options).rank(pick);
+            }
+            if (best.empty()) {
+                throw std::logic_error("Error: No free node left for an initial settlement.");
+            }
+
+            player.establishInitialSettlement(best.front().nodeId);
+            if (best.front().pathwayId != 0) {
+                player.establishInitialPathway(best.front().pathwayId);
+            }
+        }
+        _setUp = true;
+    }
+
+// Take the first useful action available to a bot; returns false when there is none
+    bool GameSimulator::takeGreedyAction(Player &player) {
+        return applyMove(player, greedyMove(BoardView(*_board), player));
+    }
+
+// Roll for the active bot and let it act until nothing is left to do
+    void GameSimulator::playTurn() {
+        for (auto &player : _players) {
+            if (player->isTurnActive()) {
+                _turn++;
+                TraceSpan turn(_tracer, "Turn", "turn", *player, _turn);
+                {
+                    TraceSpan roll(_tracer, "Roll", "phase", *player, _turn);
+                    player->rollDiceAndMove();
+                }
+                TraceSpan actions(_tracer, "Actions", "phase", *player, _turn);
+                for (bool acted = true; acted && player->calculateScore() < GameOperator::WINNING_SCORE;) {
+                    TraceSpan search(_tracer, "GreedySearch", "search", *player, _turn);
+                    acted = takeGreedyAction(*player);
+                }
+                return;
+            }
+        }
+        throw std::logic_error("Error: No player has an active turn.");
+    }
+
+// Play a full game, recording it if a recorder is set
+    SimulationResult GameSimulator::play(int maxTurns) {
+        if (_recorder && _setUp) {
+            // A log replays from the empty board, so it cannot start from a position already played
+            throw std::logic_error("Error: Only a game played from the start can be recorded.");
+        }
+        if (_recorder) {
+            _board->addObserver(_recorder);
+            _recorder->beginGame(describeGame(*_board, _seed));
+        }
+
+        SimulationResult result;
+        if (!_setUp) {
+            playSetup();
+        }
+        while (result.winnerSeat < 0 && _turn < maxTurns) {
+            playTurn();
+            result.turns = _turn;
+            for (auto &player : _players) {
+                if (player->calculateScore() >= GameOperator::WINNING_SCORE) {
+                    result.winnerSeat = player->getSeat();
+                    break;
+                }
+            }
+        }
+
+        if (_recorder) {
+            _recorder->endGame(result.winnerSeat);
+            _board->removeObserver(_recorder);
+        }
+        return result;
+    }
+
+// Save the board, the bots and the turn count
+    void GameSimulator::checkpoint(GameSnapshot &snapshot) {
+        captureGame(*_board, _seed, _turn, snapshot);
+    }
+
+// Put a saved game on the fresh board and continue counting turns from it
+    void GameSimulator::restore(const GameSnapshot &snapshot) {
+        if (_setUp || _turn != 0) {
+            throw std::invalid_argument("Error: A snapshot can only be restored before the game starts.");
+        }
+        if (snapshot.seed != _seed) {
+            throw std::invalid_argument("Error: The snapshot was taken with seed " + std::to_string(snapshot.seed) +
+                                        ", the simulator has seed " + std::to_string(_seed) + ".");
+        }
+        restoreGame(snapshot, *_board);
+        _turn = snapshot.turn;
+        // A snapshot taken before the setup has no pieces, so play() still has to place them
+        const auto &buildings = snapshot.state.board.buildings;
+        _setUp = std::any_of(buildings.begin(), buildings.end(), [](std::uint8_t owner) { return owner != 0; });
+    }
+
+// Get the board of the game
+    GameBoard &GameSimulator::getBoard() {
+        return *_board;
+    }
+
+// Get the bot at a seat
+    Player &GameSimulator::getPlayer(int seat) {
+        if (seat < 0 || seat >= (int) _players.size()) {
+            throw std::out_of_range("Error: No player at seat " + std::to_string(seat) + ".");
+        }
+        return *_players[seat];
+    }
+
+// Get the operator of the game
+    GameOperator &GameSimulator::getOperator() {
+        return _operator;
+    }
+
+} // namespace strategy
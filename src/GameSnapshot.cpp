@@ -0,0 +1,275 @@
+#include "GameSnapshot.hpp"
+#include "Player.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <stdexcept>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace strategy {
+
+    static constexpr std::array<char, 8> SNAPSHOT_MAGIC = {'C', 'A', 'T', 'A', 'N', 'S', 'A', 'V'};
+    static constexpr std::size_t CHECKSUM_START = offsetof(GameSnapshot, checksum) + sizeof(GameSnapshot::checksum);
+    static constexpr int MAX_SCORE = 255; ///< Far above any score a game reaches.
+
+// FNV-1a hash of the image after the checksum field
+    static std::uint64_t checksumOf(const std::uint8_t *image) {
+        std::uint64_t hash = 0xcbf29ce484222325ULL;
+        for (std::size_t i = CHECKSUM_START; i < sizeof(GameSnapshot); ++i) {
+            hash = (hash ^ image[i]) * 0x100000001b3ULL;
+        }
+        return hash;
+    }
+
+// Fill the snapshot from the board and its players, then seal it
+    void captureGame(GameBoard &board, std::uint64_t seed, int turn, GameSnapshot &snapshot) {
+        // Clear the padding too, since the checksum covers it
+        std::memset(static_cast<void *>(&snapshot), 0, sizeof(GameSnapshot));
+
+        const int seats = board.getPlayerCount();
+        std::array<game::Player *, GameState::MAX_SEATS> players{};
+        for (int seat = 0; seat < seats; ++seat) {
+            players[seat] = board.getPlayer(seat);
+        }
+        captureState(BoardView(board), std::span<game::Player *const>(players.data(), static_cast<std::size_t>(seats)),
+                     snapshot.state);
+
+        snapshot.seed = seed;
+        snapshot.turn = turn;
+        snapshot.activeSeat = -1;
+        snapshot.seatCount = static_cast<std::uint8_t>(seats);
+        for (std::size_t type = 0; type < game::DEV_CARD_TYPE_COUNT; ++type) {
+            snapshot.deck[type] = static_cast<std::uint8_t>(board.countDeckCards(static_cast<game::DevCardType>(type)));
+        }
+        snapshot.bank = board.getBank().getSupply();
+        for (int seat = 0; seat < seats; ++seat) {
+            if (players[seat]->isTurnActive() && snapshot.activeSeat < 0) {
+                snapshot.activeSeat = static_cast<std::int8_t>(seat);
+            }
+            snapshot.scores[seat] = players[seat]->calculateScore();
+            const std::string name = players[seat]->getName();
+            std::copy_n(name.begin(), std::min(name.size(), GameSnapshot::NAME_LENGTH - 1), snapshot.names[seat].begin());
+        }
+
+        snapshot.magic = SNAPSHOT_MAGIC;
+        snapshot.version = GameSnapshot::FORMAT_VERSION;
+        snapshot.size = sizeof(GameSnapshot);
+        snapshot.checksum = checksumOf(reinterpret_cast<const std::uint8_t *>(&snapshot));
+    }
+
+// Check every field a restore relies on
+    static const char *firstInvalidField(const GameSnapshot &snapshot) {
+        const int seats = snapshot.seatCount;
+        if (seats < 1 || seats > static_cast<int>(GameState::MAX_SEATS)) {
+            return "seat count";
+        }
+        if (snapshot.turn < 0 || snapshot.activeSeat < -1 || snapshot.activeSeat >= seats) {
+            return "turn";
+        }
+        const BoardSnapshot &board = snapshot.state.board;
+        if (board.robber < 0 || board.robber >= static_cast<int>(BoardGraph::MAX_TERRAINS)) {
+            return "robber";
+        }
+        for (std::size_t node = 0; node < BoardGraph::MAX_NODES; ++node) {
+            if (board.buildingSeat(node) >= seats || (board.isCity(node) && board.buildingSeat(node) < 0)) {
+                return "buildings";
+            }
+        }
+        for (std::size_t pathway = 0; pathway < BoardGraph::MAX_PATHWAYS; ++pathway) {
+            if (board.roadSeat(pathway) >= seats) {
+                return "roads";
+            }
+        }
+
+        ResourceCounts total = snapshot.bank;
+        for (int seat = 0; seat < static_cast<int>(GameState::MAX_SEATS); ++seat) {
+            const ResourceCounts &hand = snapshot.state.hands[seat];
+            const auto &cards = snapshot.state.devCards[seat];
+            if (seat >= seats) {
+                if (hand.total() != 0 || std::any_of(cards.begin(), cards.end(), [](std::uint8_t n) { return n != 0; }) ||
+                    snapshot.scores[seat] != 0 || snapshot.names[seat][0] != '\0') {
+                    return "empty seats";
+                }
+                continue;
+            }
+            for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+                if (hand[r] < 0) {
+                    return "hands";
+                }
+            }
+            total += hand;
+            if (snapshot.scores[seat] < 0 || snapshot.scores[seat] > MAX_SCORE) {
+                return "scores";
+            }
+            if (snapshot.names[seat][GameSnapshot::NAME_LENGTH - 1] != '\0') {
+                return "names";
+            }
+        }
+        for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+            if (snapshot.bank[r] < 0 || total[r] != Bank::CARDS_PER_RESOURCE) {
+                return "bank";
+            }
+        }
+
+        // Played cards leave the game, so the deck and the hands hold at most a new deck
+        for (std::size_t type = 0; type < game::DEV_CARD_TYPE_COUNT; ++type) {
+            int cards = snapshot.deck[type];
+            for (int seat = 0; seat < seats; ++seat) {
+                cards += snapshot.state.devCards[seat][type];
+            }
+            if (cards > game::DEV_CARD_DECK[type]) {
+                return "development cards";
+            }
+        }
+        return nullptr;
+    }
+
+// Check the header, the checksum and the fields, then view the image in place
+    const GameSnapshot &viewSnapshot(std::span<const std::uint8_t> bytes) {
+        if (bytes.size() < sizeof(GameSnapshot)) {
+            throw std::runtime_error("Error: The snapshot is truncated.");
+        }
+        if (reinterpret_cast<std::uintptr_t>(bytes.data()) % alignof(GameSnapshot) != 0) {
+            throw std::runtime_error("Error: The snapshot is not aligned.");
+        }
+        const auto &snapshot = *reinterpret_cast<const GameSnapshot *>(bytes.data());
+        if (snapshot.magic != SNAPSHOT_MAGIC) {
+            throw std::runtime_error("Error: Not a game snapshot.");
+        }
+        if (snapshot.version != GameSnapshot::FORMAT_VERSION || snapshot.size != sizeof(GameSnapshot) ||
+            bytes.size() != sizeof(GameSnapshot)) {
+            throw std::runtime_error("Error: The snapshot was written by an unsupported version.");
+        }
+        if (snapshot.checksum != checksumOf(bytes.data())) {
+            throw std::runtime_error("Error: The snapshot checksum does not match.");
+        }
+        if (const char *field = firstInvalidField(snapshot)) {
+            throw std::runtime_error(std::string("Error: The snapshot has invalid ") + field + ".");
+        }
+        return snapshot;
+    }
+
+// Write and sync a temporary file, rename it over the target and sync the directory
+    void writeSnapshot(const std::string &path, const GameSnapshot &snapshot) {
+        const std::string temporary = path + ".tmp";
+        int fd = ::open(temporary.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0) {
+            throw std::runtime_error("Error: Cannot write snapshot " + temporary + ".");
+        }
+        const auto *bytes = reinterpret_cast<const std::uint8_t *>(&snapshot);
+        std::size_t written = 0;
+        while (written < sizeof(GameSnapshot)) {
+            ssize_t n = ::write(fd, bytes + written, sizeof(GameSnapshot) - written);
+            if (n < 0 && errno == EINTR) {
+                continue;
+            }
+            if (n <= 0) {
+                break;
+            }
+            written += static_cast<std::size_t>(n);
+        }
+        const bool synced = written == sizeof(GameSnapshot) && ::fsync(fd) == 0;
+        if (::close(fd) != 0 || !synced) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Error: Cannot write snapshot " + temporary + ".");
+        }
+        if (std::rename(temporary.c_str(), path.c_str()) != 0) {
+            std::remove(temporary.c_str());
+            throw std::runtime_error("Error: Cannot replace snapshot " + path + ".");
+        }
+
+        // Make the rename itself durable
+        const std::size_t slash = path.find_last_of('/');
+        const std::string directory = slash == std::string::npos ? "." : slash == 0 ? "/" : path.substr(0, slash);
+        int dirFd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (dirFd >= 0) {
+            ::fsync(dirFd);
+            ::close(dirFd);
+        }
+    }
+
+// Check the board matches, then place the pieces and hand out the cards
+    void restoreGame(const GameSnapshot &snapshot, GameBoard &board) {
+        const int seats = snapshot.seatCount;
+        if (board.getPlayerCount() != seats) {
+            throw std::invalid_argument("Error: The snapshot has " + std::to_string(seats) + " players, the board " +
+                                        std::to_string(board.getPlayerCount()) + ".");
+        }
+        BoardSnapshot current;
+        captureSnapshot(BoardView(board), current);
+        const BoardSnapshot &saved = snapshot.state.board;
+        if (current.resources != saved.resources || current.numbers != saved.numbers) {
+            throw std::invalid_argument("Error: The snapshot was taken on another board layout.");
+        }
+        const auto empty = [](std::uint8_t owner) { return owner == 0; };
+        if (!std::all_of(current.buildings.begin(), current.buildings.end(), empty) ||
+            !std::all_of(current.roads.begin(), current.roads.end(), empty)) {
+            throw std::invalid_argument("Error: A snapshot can only be restored on a board without pieces.");
+        }
+
+        for (std::size_t node = 0; node < BoardGraph::MAX_NODES; ++node) {
+            if (saved.buildingSeat(node) >= 0) {
+                board.restoreBuilding(static_cast<int>(node) + 1, saved.buildingSeat(node), saved.isCity(node));
+            }
+        }
+        for (std::size_t pathway = 0; pathway < BoardGraph::MAX_PATHWAYS; ++pathway) {
+            if (saved.roadSeat(pathway) >= 0) {
+                board.restoreRoad(static_cast<int>(pathway) + 1, saved.roadSeat(pathway));
+            }
+        }
+        board.restoreRobber(saved.robber);
+        board.restoreDeck(snapshot.deck);
+
+        Bank &bank = board.getBank();
+        bank.withdraw(ResourceCounts(bank.getSupply()));
+        bank.deposit(snapshot.bank);
+        for (int seat = 0; seat < seats; ++seat) {
+            game::Player *player = board.getPlayer(seat);
+            player->restoreCards(snapshot.state.hands[seat], snapshot.state.devCards[seat], snapshot.scores[seat]);
+            player->activateTurn(seat == snapshot.activeSeat);
+        }
+    }
+
+// Map the file and check the snapshot it holds
+    GameSnapshotReader::GameSnapshotReader(const std::string &path) {
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("Error: Cannot open snapshot " + path + ".");
+        }
+        struct stat info{};
+        if (::fstat(fd, &info) != 0 || info.st_size <= 0) {
+            ::close(fd);
+            throw std::runtime_error("Error: " + path + " is not a game snapshot.");
+        }
+        _size = static_cast<std::size_t>(info.st_size);
+        void *mapping = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            throw std::runtime_error("Error: Cannot map snapshot " + path + ".");
+        }
+        _data = static_cast<const std::uint8_t *>(mapping);
+
+        try {
+            _snapshot = &viewSnapshot({_data, _size});
+        } catch (...) {
+            ::munmap(const_cast<std::uint8_t *>(_data), _size);
+            throw;
+        }
+    }
+
+// Unmap the snapshot file
+    GameSnapshotReader::~GameSnapshotReader() {
+        ::munmap(const_cast<std::uint8_t *>(_data), _size);
+    }
+
+// Get the checked snapshot
+    const GameSnapshot &GameSnapshotReader::snapshot() const {
+        return *_snapshot;
+    }
+
+} // namespace strategy
@@ -0,0 +1,66 @@
+#include "GameTracer.hpp"
+#include "Player.hpp"
+#include <cstdio>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+namespace strategy {
+
+// Escape a string for a JSON document
+    static std::string escapeJson(const std::string &text) {
+        std::string out;
+        out.reserve(text.size());
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char code[8];
+                std::snprintf(code, sizeof(code), "\\u%04x", c);
+                out += code;
+            } else {
+                out += c;
+            }
+        }
+        return out;
+    }
+
+// Create the trace file and open the event list
+    GameTracer::GameTracer(const std::string &path) : _file(path, std::ios::trunc), _origin(std::chrono::steady_clock::now()) {
+        if (!_file) {
+            throw std::runtime_error("Error: Cannot create trace file " + path + ".");
+        }
+        _file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    }
+
+// Close the event list
+    GameTracer::~GameTracer() {
+        _file << "\n]}\n";
+    }
+
+// Get the microseconds since the tracer was created
+    double GameTracer::now() const {
+        return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - _origin).count();
+    }
+
+// Write a complete event
+    void GameTracer::writeSpan(const char *name, const char *category, double start, double end, const std::string &player, int turn) {
+        auto thread = static_cast<unsigned>(std::hash<std::thread::id>{}(std::this_thread::get_id()) & 0xFFFF);
+        char timing[96];
+        std::snprintf(timing, sizeof(timing), "\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u", start, end - start, thread);
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _file << (_firstEvent ? "\n" : ",\n") << "{\"name\":\"" << name << "\",\"cat\":\"" << category
+              << "\",\"ph\":\"X\"," << timing << ",\"args\":{\"player\":\"" << escapeJson(player) << "\",\"turn\":" << turn << "}}";
+        _firstEvent = false;
+    }
+
+// Write the span when it ends
+    TraceSpan::~TraceSpan() {
+        if (_tracer) {
+            _tracer->writeSpan(_name, _category, _start, _tracer->now(), _player->getName(), _turn);
+        }
+    }
+
+} // namespace strategy
@@ -0,0 +1,114 @@
+#include "IncomeAnalytics.hpp"
+#include "GameBoard.hpp"
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+
+namespace strategy {
+
+// Sum the expected cards of every resource
+    double ExpectedIncome::total() const {
+        double sum = 0.0;
+        for (double cards : perResource) {
+            sum += cards;
+        }
+        return sum;
+    }
+
+// Count the dice combinations of a number token
+    int pips(int number) {
+        return number < 2 || number > 12 || number == 7 ? 0 : 6 - std::abs(7 - number);
+    }
+
+// Sum the pips of the terrains around every node, from the terrain corners the production pays out to
+    std::array<ExpectedIncome, BoardGraph::MAX_NODES> computeNodeIncome(const ProductionTable &table) {
+        std::array<ExpectedIncome, BoardGraph::MAX_NODES> nodes{};
+        for (std::size_t t = 0; t < table.terrainCount(); ++t) {
+            if (table.robbed(t) || table.resource(t) == ResourceType::None) {
+                continue;
+            }
+            const double cards = pips(table.number(t)) / 36.0;
+            for (std::uint8_t node : table.corners(t)) {
+                if (node < BoardGraph::MAX_NODES) {
+                    nodes[node][table.resource(t)] += cards;
+                }
+            }
+        }
+        return nodes;
+    }
+
+// Compute the income and follow the board
+    IncomeAnalytics::IncomeAnalytics(GameBoard &board) : _board(board) {
+        refresh();
+        board.addObserver(this);
+    }
+
+// Stop following the board
+    IncomeAnalytics::~IncomeAnalytics() {
+        _board.removeObserver(this);
+    }
+
+// Recompute the nodes, then the players from their buildings
+    void IncomeAnalytics::refresh() const {
+        const ProductionTable &table = _board.getProduction();
+        _nodes = computeNodeIncome(table);
+
+        _players.fill({});
+        for (std::size_t node = 0; node < BoardGraph::MAX_NODES; ++node) {
+            const int seat = table.nodeSeat(node);
+            if (seat < 0) {
+                continue;
+            }
+            for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+                _players[seat].perResource[r] += table.nodeYield(node) * _nodes[node].perResource[r];
+            }
+        }
+        _robber = table.getRobber();
+    }
+
+// Recompute everything if the robber moved since the last query
+    void IncomeAnalytics::refreshIfRobberMoved() const {
+        if (_board.getRobber() != _robber) {
+            refresh();
+        }
+    }
+
+// Get the income of a node
+    const ExpectedIncome &IncomeAnalytics::nodeIncome(int nodeId) const {
+        if (nodeId < 1 || nodeId > (int) BoardGraph::MAX_NODES) {
+            throw std::out_of_range("Error: No node " + std::to_string(nodeId) + " on the board.");
+        }
+        refreshIfRobberMoved();
+        return _nodes[nodeId - 1];
+    }
+
+// Get the income of a player
+    const ExpectedIncome &IncomeAnalytics::playerIncome(int seat) const {
+        if (seat < 0 || seat >= (int) ProductionTable::MAX_SEATS) {
+            throw std::out_of_range("Error: No seat " + std::to_string(seat) + " at the board.");
+        }
+        refreshIfRobberMoved();
+        return _players[seat];
+    }
+
+// A settlement adds its node's income once, a city once more; the robber changes every node around it
+    void IncomeAnalytics::onAction(const GameAction &action) {
+        if (action.type == ActionType::MoveRobber) {
+            refresh();
+            return;
+        }
+        if (action.type != ActionType::InitialSettlement && action.type != ActionType::BuildSettlement
+            && action.type != ActionType::UpgradeToCity) {
+            return;
+        }
+        if (_board.getRobber() != _robber) {
+            refresh();
+            return;
+        }
+        const ExpectedIncome &node = _nodes[action.value - 1];
+        for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+            _players[action.seat].perResource[r] += node.perResource[r];
+        }
+    }
+
+} // namespace strategy
@@ -0,0 +1,108 @@
+#include "Instrumentation.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+namespace game {
+
+    static const char *const PROBE_NAMES[PROBE_COUNT] = {
+            "Roll", "Production", "BuildCheck", "Build", "Setup", "Trade", "DevelopmentCard", "Discard", "WinnerCheck"};
+
+// Get the name of a probe
+    const char *probeName(Probe probe) {
+        return PROBE_NAMES[static_cast<std::size_t>(probe)];
+    }
+
+#ifdef CATAN_INSTRUMENTATION
+
+    namespace {
+
+// Live thread buffers, and the totals of threads that have exited
+        struct ProbeRegistry {
+            std::mutex mutex;
+            std::vector<ProbeBuffer *> buffers;
+            ProbeReport retired{};
+        };
+
+        ProbeRegistry &registry() {
+            static auto *instance = new ProbeRegistry(); // Never destroyed, so thread exit after main is safe
+            return *instance;
+        }
+
+    } // namespace
+
+// Register the calling thread's buffer
+    ProbeBuffer::ProbeBuffer() {
+        ProbeRegistry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.buffers.push_back(this);
+    }
+
+// Fold the totals of an exiting thread into the registry
+    ProbeBuffer::~ProbeBuffer() {
+        ProbeRegistry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        for (std::size_t i = 0; i < PROBE_COUNT; ++i) {
+            reg.retired[i].calls += calls[i].load(std::memory_order_relaxed);
+            reg.retired[i].ticks += ticks[i].load(std::memory_order_relaxed);
+        }
+        reg.buffers.erase(std::remove(reg.buffers.begin(), reg.buffers.end(), this), reg.buffers.end());
+    }
+
+// Sum the statistics of all threads
+    ProbeReport collectProbes() {
+        ProbeRegistry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        ProbeReport report = reg.retired;
+        for (ProbeBuffer *buffer : reg.buffers) {
+            for (std::size_t i = 0; i < PROBE_COUNT; ++i) {
+                report[i].calls += buffer->calls[i].load(std::memory_order_relaxed);
+                report[i].ticks += buffer->ticks[i].load(std::memory_order_relaxed);
+            }
+        }
+        return report;
+    }
+
+// Clear the statistics of all threads
+    void resetProbes() {
+        ProbeRegistry &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.retired = ProbeReport{};
+        for (ProbeBuffer *buffer : reg.buffers) {
+            for (std::size_t i = 0; i < PROBE_COUNT; ++i) {
+                buffer->calls[i].store(0, std::memory_order_relaxed);
+                buffer->ticks[i].store(0, std::memory_order_relaxed);
+            }
+        }
+    }
+
+#else
+
+    ProbeReport collectProbes() {
+        return {};
+    }
+
+    void resetProbes() {}
+
+#endif // CATAN_INSTRUMENTATION
+
+// Write a table of every probe that ran
+    void dumpProbes(std::ostream &out) {
+        if (!instrumentationEnabled()) {
+            out << "Instrumentation is compiled out (build with -DCATAN_INSTRUMENTATION)." << std::endl;
+            return;
+        }
+        ProbeReport report = collectProbes();
+        out << std::left << std::setw(18) << "Probe" << std::right << std::setw(14) << "Calls" << std::setw(18)
+            << "Ticks" << std::setw(14) << "Ticks/call" << std::endl;
+        for (std::size_t i = 0; i < PROBE_COUNT; ++i) {
+            if (report[i].calls == 0) {
+                continue;
+            }
+            out << std::left << std::setw(18) << PROBE_NAMES[i] << std::right << std::setw(14) << report[i].calls
+                << std::setw(18) << report[i].ticks << std::setw(14) << report[i].ticks / report[i].calls << std::endl;
+        }
+    }
+
+} // namespace game
@@ -0,0 +1,244 @@
+#include "MatchProtocol.hpp"
+#include "GameRecord.hpp"
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace strategy {
+
+    namespace {
+
+        // Reserve the length of a frame and write its type
+        std::size_t beginFrame(std::vector<std::uint8_t> &out, MessageType type) {
+            const std::size_t start = out.size();
+            out.insert(out.end(), {0, 0, static_cast<std::uint8_t>(type)});
+            return start;
+        }
+
+        // Patch the length of the body written since beginFrame
+        void endFrame(std::vector<std::uint8_t> &out, std::size_t start) {
+            const std::size_t body = out.size() - start - 2;
+            if (body > Message::MAX_BODY) {
+                out.resize(start);
+                throw std::invalid_argument("Error: A message of " + std::to_string(body) + " bytes does not fit in a frame.");
+            }
+            out[start] = static_cast<std::uint8_t>(body & 0xFF);
+            out[start + 1] = static_cast<std::uint8_t>(body >> 8);
+        }
+
+        // Decode a varint of the body or reject the frame
+        std::uint64_t readField(const std::uint8_t *&pos, const std::uint8_t *end) {
+            std::uint64_t value;
+            if (!readVarint(pos, end, value)) {
+                throw ProtocolError("Error: Truncated message.");
+            }
+            return value;
+        }
+
+        // Decode a one-byte enumerator between first and last
+        template<typename Enum>
+        Enum readEnum(const std::uint8_t *&pos, const std::uint8_t *end, Enum first, Enum last) {
+            if (pos >= end || *pos < static_cast<std::uint8_t>(first) || *pos > static_cast<std::uint8_t>(last)) {
+                throw ProtocolError("Error: Unknown value in message.");
+            }
+            return static_cast<Enum>(*pos++);
+        }
+
+        // Describe a failed socket call with the address it was for
+        std::runtime_error socketError(const std::string &what, const Endpoint &endpoint) {
+            const std::string address = endpoint.unixPath.empty()
+                                        ? endpoint.host + ":" + std::to_string(endpoint.port) : endpoint.unixPath;
+            return std::runtime_error("Error: Cannot " + what + " " + address + ": " + std::strerror(errno) + ".");
+        }
+
+        // Fill the address of an endpoint
+        socklen_t makeAddress(const Endpoint &endpoint, sockaddr_storage &storage) {
+            std::memset(&storage, 0, sizeof(storage));
+            if (!endpoint.unixPath.empty()) {
+                auto *address = reinterpret_cast<sockaddr_un *>(&storage);
+                if (endpoint.unixPath.size() >= sizeof(address->sun_path)) {
+                    throw std::invalid_argument("Error: Unix socket path " + endpoint.unixPath + " is too long.");
+                }
+                address->sun_family = AF_UNIX;
+                std::memcpy(address->sun_path, endpoint.unixPath.c_str(), endpoint.unixPath.size() + 1);
+                return sizeof(sockaddr_un);
+            }
+            auto *address = reinterpret_cast<sockaddr_in *>(&storage);
+            address->sin_family = AF_INET;
+            address->sin_port = htons(endpoint.port);
+            if (::inet_pton(AF_INET, endpoint.host.c_str(), &address->sin_addr) != 1) {
+                throw std::invalid_argument("Error: " + endpoint.host + " is not an IPv4 address.");
+            }
+            return sizeof(sockaddr_in);
+        }
+
+    } // namespace
+
+// Write the fields the type of the message uses
+    void encodeMessage(std::vector<std::uint8_t> &out, const Message &message) {
+        if (message.type == MessageType::Diff) {
+            encodeDiff(out, message.actions);
+            return;
+        }
+        const std::size_t start = beginFrame(out, message.type);
+        switch (message.type) {
+            case MessageType::Build:
+                out.push_back(static_cast<std::uint8_t>(message.build));
+                writeVarint(out, static_cast<std::uint64_t>(message.id));
+                break;
+            case MessageType::Seated:
+                writeVarint(out, message.match);
+                writeVarint(out, static_cast<std::uint64_t>(message.seat));
+                break;
+            case MessageType::YourTurn:
+                writeVarint(out, static_cast<std::uint64_t>(message.turn));
+                break;
+            case MessageType::Rejected:
+                out.push_back(static_cast<std::uint8_t>(message.reason));
+                break;
+            case MessageType::GameOver:
+                writeVarint(out, static_cast<std::uint64_t>(message.winner + 1));
+                writeVarint(out, static_cast<std::uint64_t>(message.turn));
+                break;
+            default:
+                break;
+        }
+        endFrame(out, start);
+    }
+
+// Write the number of actions and every action as in a game record
+    void encodeDiff(std::vector<std::uint8_t> &out, std::span<const GameAction> actions) {
+        if (actions.size() > Message::MAX_DIFF_ACTIONS) {
+            throw std::invalid_argument("Error: A diff carries at most " + std::to_string(Message::MAX_DIFF_ACTIONS) + " actions.");
+        }
+        const std::size_t start = beginFrame(out, MessageType::Diff);
+        writeVarint(out, actions.size());
+        for (const GameAction &action : actions) {
+            writeAction(out, action);
+        }
+        endFrame(out, start);
+    }
+
+// Wait for a whole frame, then decode the fields of its type and insist they fill the body
+    std::size_t decodeMessage(std::span<const std::uint8_t> in, Message &message) {
+        if (in.size() < 2) {
+            return 0;
+        }
+        const std::size_t body = in[0] | static_cast<std::size_t>(in[1]) << 8;
+        if (body == 0 || body > Message::MAX_BODY) {
+            throw ProtocolError("Error: Frame of " + std::to_string(body) + " bytes.");
+        }
+        if (in.size() < body + 2) {
+            return 0;
+        }
+        const std::uint8_t *pos = in.data() + 2;
+        const std::uint8_t *end = pos + body;
+
+        message = Message();
+        message.type = readEnum(pos, end, MessageType::Join, MessageType::GameOver);
+        switch (message.type) {
+            case MessageType::Build:
+                message.build = readEnum(pos, end, BuildKind::Pathway, BuildKind::City);
+                message.id = static_cast<int>(readField(pos, end));
+                break;
+            case MessageType::Seated:
+                message.match = static_cast<std::uint32_t>(readField(pos, end));
+                message.seat = static_cast<int>(readField(pos, end));
+                break;
+            case MessageType::YourTurn:
+                message.turn = static_cast<int>(readField(pos, end));
+                break;
+            case MessageType::Diff: {
+                const std::uint64_t count = readField(pos, end);
+                if (count > Message::MAX_DIFF_ACTIONS) {
+                    throw ProtocolError("Error: Diff of " + std::to_string(count) + " actions.");
+                }
+                message.actions.resize(count);
+                for (GameAction &action : message.actions) {
+                    if (!readAction(pos, end, action)) {
+                        throw ProtocolError("Error: Malformed action in diff.");
+                    }
+                }
+                break;
+            }
+            case MessageType::Rejected:
+                message.reason = readEnum(pos, end, RejectReason::NotYourTurn, RejectReason::BadRequest);
+                break;
+            case MessageType::GameOver:
+                message.winner = static_cast<int>(readField(pos, end)) - 1;
+                message.turn = static_cast<int>(readField(pos, end));
+                break;
+            default:
+                break;
+        }
+        if (pos != end) {
+            throw ProtocolError("Error: Trailing bytes in message.");
+        }
+        return body + 2;
+    }
+
+// Bind, then listen without blocking on accept
+    int listenOn(const Endpoint &endpoint, int backlog) {
+        sockaddr_storage address{};
+        const socklen_t length = makeAddress(endpoint, address);
+        const int fd = ::socket(address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            throw socketError("open a socket for", endpoint);
+        }
+        if (endpoint.unixPath.empty()) {
+            int on = 1;
+            ::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        } else {
+            ::unlink(endpoint.unixPath.c_str());
+        }
+        if (::bind(fd, reinterpret_cast<const sockaddr *>(&address), length) < 0 || ::listen(fd, backlog) < 0) {
+            std::runtime_error error = socketError("listen on", endpoint);
+            ::close(fd);
+            throw error;
+        }
+        return fd;
+    }
+
+// Connect blocking, so a full backlog slows the caller down instead of failing, then switch to non-blocking
+    int connectTo(const Endpoint &endpoint) {
+        sockaddr_storage address{};
+        const socklen_t length = makeAddress(endpoint, address);
+        const int fd = ::socket(address.ss_family, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd < 0) {
+            throw socketError("open a socket for", endpoint);
+        }
+        if (::connect(fd, reinterpret_cast<const sockaddr *>(&address), length) < 0) {
+            std::runtime_error error = socketError("connect to", endpoint);
+            ::close(fd);
+            throw error;
+        }
+        if (endpoint.unixPath.empty()) {
+            int on = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+        }
+        ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+        return fd;
+    }
+
+// Lift the soft limit of open files to the hard one
+    std::size_t raiseOpenFileLimit() {
+        rlimit limit{};
+        if (::getrlimit(RLIMIT_NOFILE, &limit) != 0) {
+            return 0;
+        }
+        if (limit.rlim_cur < limit.rlim_max) {
+            limit.rlim_cur = limit.rlim_max;
+            ::setrlimit(RLIMIT_NOFILE, &limit);
+            ::getrlimit(RLIMIT_NOFILE, &limit);
+        }
+        return static_cast<std::size_t>(limit.rlim_cur);
+    }
+
+} // namespace strategy
@@ -0,0 +1,696 @@
+#include "MatchServer.hpp"
+#include "GameSimulator.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <chrono>
+#include <mutex>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdexcept>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#include <unordered_map>
+
+using namespace game;
+
+namespace strategy {
+
+    namespace {
+
+        constexpr int MAX_EVENTS = 256;           ///< Events taken per epoll_wait.
+        constexpr std::size_t READ_CHUNK = 16384; ///< Bytes read per recv.
+
+        struct Match;
+
+        // A client, owned by the worker of its match
+        struct Connection {
+            int fd = -1;
+            Match *match = nullptr;
+            int seat = -1;
+            bool joined = false;           // Sent its Join
+            bool writing = false;          // Registered for EPOLLOUT
+            bool queued = false;           // In the worker's list of connections to flush
+            bool closeWhenFlushed = false; // The match is over
+            bool dead = false;             // Closed at the end of the batch of events
+            std::vector<std::uint8_t> in;  // Bytes received and not decoded yet
+            std::vector<std::uint8_t> out; // Bytes not sent yet
+        };
+
+        // A game and its three seats; every action the board publishes waits in pending until broadcast
+        struct Match : public GameObserver {
+            enum class Phase { Waiting, AwaitRoll, Acting, Over };
+
+            std::uint32_t id;
+            GameSimulator game;
+            std::array<Connection *, 3> seats{};
+            int handed = 0; // Seats the acceptor handed over
+            int open = 0;   // Seats still connected
+            int joined = 0;
+            Phase phase = Phase::Waiting;
+            int acting = -1;
+            int turn = 0;
+            std::vector<GameAction> pending;
+
+            Match(std::uint32_t matchId, std::uint64_t seed) : id(matchId), game(seed) {
+                game.getBoard().addObserver(this);
+            }
+
+            ~Match() override {
+                game.getBoard().removeObserver(this);
+            }
+
+            void onAction(const GameAction &action) override {
+                pending.push_back(action);
+            }
+        };
+
+        // A connection the acceptor seated, on its way to the worker of its match
+        struct Handoff {
+            int fd;
+            std::uint32_t match;
+            int seat;
+        };
+
+        // Get the seat whose turn the engine activated
+        int activeSeat(Match &match) {
+            for (int seat = 0; seat < 3; ++seat) {
+                if (match.game.getPlayer(seat).isTurnActive()) {
+                    return seat;
+                }
+            }
+            throw std::logic_error("Error: No player has an active turn.");
+        }
+
+        // Pin a thread to the n-th core the process may run on
+        void pinThread(std::thread &thread, std::size_t n) {
+            cpu_set_t allowed;
+            CPU_ZERO(&allowed);
+            if (::sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || CPU_COUNT(&allowed) == 0) {
+                return;
+            }
+            n %= static_cast<std::size_t>(CPU_COUNT(&allowed));
+            for (int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+                if (CPU_ISSET(cpu, &allowed) && n-- == 0) {
+                    cpu_set_t one;
+                    CPU_ZERO(&one);
+                    CPU_SET(cpu, &one);
+                    ::pthread_setaffinity_np(thread.native_handle(), sizeof(one), &one);
+                    return;
+                }
+            }
+        }
+
+        // Wake the thread waiting on an event file
+        void wakeUp(int fd) {
+            const std::uint64_t one = 1;
+            [[maybe_unused]] ssize_t written = ::write(fd, &one, sizeof(one));
+        }
+
+    } // namespace
+
+/**
+ * @brief One epoll loop serving every connection of the matches it owns.
+ *
+ * Only the acceptor touches the inbox, under its mutex; everything else belongs to the
+ * worker's thread.
+ */
+    struct MatchServer::Worker {
+        const ServerOptions &options;
+        int epollFd = -1;
+        int wakeFd = -1;
+        std::thread thread;
+        std::atomic<bool> stopping{false};
+
+        std::mutex inboxMutex;
+        std::vector<Handoff> inbox;
+
+        std::unordered_map<std::uint32_t, std::unique_ptr<Match>> matches;
+        std::unordered_map<int, std::unique_ptr<Connection>> connections;
+        std::vector<Connection *> flushList; // Connections with replies to send after the batch
+        std::vector<Connection *> graveyard; // Connections to close after the batch
+        std::vector<std::uint8_t> readBuffer;
+
+        std::atomic<std::size_t> started{0};
+        std::atomic<std::size_t> finished{0};
+        std::atomic<std::size_t> aborted{0};
+        std::atomic<std::size_t> rejected{0};
+
+        explicit Worker(const ServerOptions &serverOptions);
+        ~Worker();
+
+        void hand(std::vector<Handoff> &handoffs);
+        void run();
+        void adopt();
+        void receive(Connection &connection);
+        void handle(Connection &connection, const Message &message);
+        bool build(Player &player, const Message &message);
+        void begin(Match &match);
+        void endTurn(Match &match);
+        void endMatch(Match &match, int winner);
+        void broadcastDiff(Match &match);
+        void send(Connection &connection, const Message &message);
+        void reject(Connection &connection, RejectReason reason);
+        void queue(Connection &connection);
+        void flush(Connection &connection);
+        void closeLater(Connection &connection);
+        void bury();
+    };
+
+// Create the epoll instance and the event file the acceptor wakes it with
+    MatchServer::Worker::Worker(const ServerOptions &serverOptions) : options(serverOptions), readBuffer(READ_CHUNK) {
+        epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.ptr = nullptr;
+        if (epollFd < 0 || wakeFd < 0 || ::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event) < 0) {
+            if (epollFd >= 0) ::close(epollFd);
+            if (wakeFd >= 0) ::close(wakeFd);
+            throw std::runtime_error("Error: Cannot create the event loop of a match server worker.");
+        }
+    }
+
+    MatchServer::Worker::~Worker() {
+        for (const Handoff &handoff : inbox) {
+            ::close(handoff.fd);
+        }
+        for (auto &[fd, connection] : connections) {
+            ::close(fd);
+        }
+        connections.clear();
+        matches.clear();
+        ::close(wakeFd);
+        ::close(epollFd);
+    }
+
+// Queue seated connections for the worker's thread and wake it
+    void MatchServer::Worker::hand(std::vector<Handoff> &handoffs) {
+        {
+            std::lock_guard<std::mutex> lock(inboxMutex);
+            inbox.insert(inbox.end(), handoffs.begin(), handoffs.end());
+        }
+        handoffs.clear();
+        wakeUp(wakeFd);
+    }
+
+// Wait for events, handle a whole batch, then send every reply and close every finished connection
+    void MatchServer::Worker::run() {
+        std::array<epoll_event, MAX_EVENTS> events{};
+        while (!stopping.load(std::memory_order_acquire)) {
+            const int ready = ::epoll_wait(epollFd, events.data(), MAX_EVENTS, -1);
+            if (ready < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                break;
+            }
+            for (int i = 0; i < ready; ++i) {
+                auto *connection = static_cast<Connection *>(events[i].data.ptr);
+                if (!connection) {
+                    std::uint64_t count;
+                    [[maybe_unused]] ssize_t read = ::read(wakeFd, &count, sizeof(count));
+                    adopt();
+                    continue;
+                }
+                if (connection->dead) {
+                    continue;
+                }
+                if (events[i].events & (EPOLLIN | EPOLLHUP | EPOLLERR)) {
+                    receive(*connection);
+                }
+                if (!connection->dead && (events[i].events & EPOLLOUT)) {
+                    queue(*connection);
+                }
+            }
+            // Closing a connection aborts its match, which has news for the other seats
+            while (!flushList.empty() || !graveyard.empty()) {
+                std::vector<Connection *> flushing;
+                flushing.swap(flushList);
+                for (Connection *connection : flushing) {
+                    connection->queued = false;
+                    if (!connection->dead) {
+                        flush(*connection);
+                    }
+                }
+                bury();
+            }
+        }
+    }
+
+// Register the connections the acceptor handed over with their matches
+    void MatchServer::Worker::adopt() {
+        std::vector<Handoff> handoffs;
+        {
+            std::lock_guard<std::mutex> lock(inboxMutex);
+            handoffs.swap(inbox);
+        }
+        for (const Handoff &handoff : handoffs) {
+            std::unique_ptr<Match> &slot = matches[handoff.match];
+            if (!slot) {
+                slot = std::make_unique<Match>(handoff.match, options.seed + handoff.match);
+            }
+            auto connection = std::make_unique<Connection>();
+            connection->fd = handoff.fd;
+            connection->match = slot.get();
+            connection->seat = handoff.seat;
+
+            epoll_event event{};
+            event.events = EPOLLIN;
+            event.data.ptr = connection.get();
+            if (::epoll_ctl(epollFd, EPOLL_CTL_ADD, handoff.fd, &event) < 0) {
+                ::close(handoff.fd);
+                continue;
+            }
+            slot->seats[handoff.seat] = connection.get();
+            slot->handed++;
+            slot->open++;
+            Connection &adopted = *connection;
+            connections.emplace(handoff.fd, std::move(connection));
+
+            // A seat arriving after another one left finds its match already over
+            if (slot->phase == Match::Phase::Over) {
+                Message over;
+                over.type = MessageType::GameOver;
+                over.turn = slot->turn;
+                send(adopted, over);
+                adopted.closeWhenFlushed = true;
+            }
+        }
+    }
+
+// Read everything available and handle every whole frame; a malformed frame drops the client
+    void MatchServer::Worker::receive(Connection &connection) {
+        while (true) {
+            const ssize_t received = ::recv(connection.fd, readBuffer.data(), readBuffer.size(), 0);
+            if (received > 0) {
+                connection.in.insert(connection.in.end(), readBuffer.begin(), readBuffer.begin() + received);
+                continue;
+            }
+            if (received < 0 && errno == EINTR) {
+                continue;
+            }
+            if (received == 0 || (errno != EAGAIN && errno != EWOULDBLOCK)) {
+                closeLater(connection);
+                return;
+            }
+            break;
+        }
+
+        std::size_t offset = 0;
+        Message message;
+        try {
+            while (!connection.dead) {
+                const std::size_t length = decodeMessage(std::span<const std::uint8_t>(connection.in).subspan(offset), message);
+                if (length == 0) {
+                    break;
+                }
+                offset += length;
+                handle(connection, message);
+            }
+        } catch (const ProtocolError &) {
+            closeLater(connection);
+        }
+        connection.in.erase(connection.in.begin(), connection.in.begin() + (std::ptrdiff_t) offset);
+    }
+
+// Check that the request is the client's to make, apply it and broadcast what changed
+    void MatchServer::Worker::handle(Connection &connection, const Message &message) {
+        Match &match = *connection.match;
+        if (message.type == MessageType::Join) {
+            if (connection.joined) {
+                reject(connection, RejectReason::BadRequest);
+                return;
+            }
+            connection.joined = true;
+            Message seated;
+            seated.type = MessageType::Seated;
+            seated.match = match.id;
+            seated.seat = connection.seat;
+            send(connection, seated);
+            if (++match.joined == 3 && match.phase == Match::Phase::Waiting) {
+                begin(match);
+            }
+            return;
+        }
+        if (message.type != MessageType::Roll && message.type != MessageType::Build && message.type != MessageType::EndTurn) {
+            reject(connection, RejectReason::BadRequest);
+            return;
+        }
+        if (!connection.joined || match.phase == Match::Phase::Waiting || match.phase == Match::Phase::Over) {
+            reject(connection, RejectReason::MatchNotReady);
+            return;
+        }
+        const Match::Phase expected = message.type == MessageType::Roll ? Match::Phase::AwaitRoll : Match::Phase::Acting;
+        if (connection.seat != match.acting || match.phase != expected) {
+            reject(connection, RejectReason::NotYourTurn);
+            return;
+        }
+
+        Player &player = match.game.getPlayer(connection.seat);
+        try {
+            if (message.type == MessageType::Roll) {
+                player.rollDiceAndMove();
+                match.phase = Match::Phase::Acting;
+            } else if (message.type == MessageType::Build && !build(player, message)) {
+                reject(connection, RejectReason::IllegalMove);
+            }
+        } catch (const std::exception &) {
+            reject(connection, RejectReason::IllegalMove);
+        }
+        broadcastDiff(match);
+        if (message.type == MessageType::EndTurn) {
+            endTurn(match);
+        }
+    }
+
+// Place a piece if the rules and the player's cards allow it
+    bool MatchServer::Worker::build(Player &player, const Message &message) {
+        switch (message.build) {
+            case BuildKind::Pathway:
+                if (!player.canBuildPathway(message.id)) {
+                    return false;
+                }
+                player.buildPathway(message.id);
+                return true;
+            case BuildKind::Settlement:
+                if (!player.canBuildSettlement(message.id)) {
+                    return false;
+                }
+                player.buildSettlement(message.id);
+                return true;
+            case BuildKind::City:
+                if (!player.canUpgradeToCity(message.id)) {
+                    return false;
+                }
+                player.upgradeToCity(message.id);
+                return true;
+        }
+        return false;
+    }
+
+// Place the openings as the placement solver ranks them and give the first turn
+    void MatchServer::Worker::begin(Match &match) {
+        started.fetch_add(1, std::memory_order_relaxed);
+        match.game.playSetup();
+        broadcastDiff(match);
+        match.phase = Match::Phase::AwaitRoll;
+        match.acting = activeSeat(match);
+
+        Message turn;
+        turn.type = MessageType::YourTurn;
+        turn.turn = match.turn + 1;
+        send(*match.seats[match.acting], turn);
+    }
+
+// End the match on a winner or the turn limit, otherwise give the turn to the seat the engine activated
+    void MatchServer::Worker::endTurn(Match &match) {
+        match.turn++;
+        int winner = -1;
+        for (int seat = 0; seat < 3; ++seat) {
+            if (match.game.getPlayer(seat).calculateScore() >= GameOperator::WINNING_SCORE) {
+                winner = seat;
+            }
+        }
+        if (winner >= 0 || match.turn >= options.maxTurns) {
+            finished.fetch_add(1, std::memory_order_relaxed);
+            endMatch(match, winner);
+            return;
+        }
+        match.phase = Match::Phase::AwaitRoll;
+        match.acting = activeSeat(match);
+
+        Message turn;
+        turn.type = MessageType::YourTurn;
+        turn.turn = match.turn + 1;
+        send(*match.seats[match.acting], turn);
+    }
+
+// Tell every seat still connected how the match ended and close it once told
+    void MatchServer::Worker::endMatch(Match &match, int winner) {
+        match.phase = Match::Phase::Over;
+        Message over;
+        over.type = MessageType::GameOver;
+        over.winner = winner;
+        over.turn = match.turn;
+        for (Connection *connection : match.seats) {
+            if (connection) {
+                send(*connection, over);
+                connection->closeWhenFlushed = true;
+            }
+        }
+    }
+
+// Send the actions published since the last broadcast to every seat, in frames of at most MAX_DIFF_ACTIONS
+    void MatchServer::Worker::broadcastDiff(Match &match) {
+        std::span<const GameAction> pending(match.pending);
+        while (!pending.empty()) {
+            std::span<const GameAction> chunk = pending.first(std::min(pending.size(), Message::MAX_DIFF_ACTIONS));
+            for (Connection *connection : match.seats) {
+                if (connection && !connection->dead) {
+                    encodeDiff(connection->out, chunk);
+                    queue(*connection);
+                }
+            }
+            pending = pending.subspan(chunk.size());
+        }
+        match.pending.clear();
+    }
+
+// Append a reply; it is written with the others at the end of the batch
+    void MatchServer::Worker::send(Connection &connection, const Message &message) {
+        if (!connection.dead) {
+            encodeMessage(connection.out, message);
+            queue(connection);
+        }
+    }
+
+// Count a refused request and tell the client why
+    void MatchServer::Worker::reject(Connection &connection, RejectReason reason) {
+        rejected.fetch_add(1, std::memory_order_relaxed);
+        Message rejection;
+        rejection.type = MessageType::Rejected;
+        rejection.reason = reason;
+        send(connection, rejection);
+    }
+
+// Remember to flush a connection once per batch
+    void MatchServer::Worker::queue(Connection &connection) {
+        if (!connection.queued && !connection.dead) {
+            connection.queued = true;
+            flushList.push_back(&connection);
+        }
+    }
+
+// Write as much as the socket takes and wait for EPOLLOUT only while something is left
+    void MatchServer::Worker::flush(Connection &connection) {
+        std::size_t sent = 0;
+        while (sent < connection.out.size()) {
+            const ssize_t written = ::send(connection.fd, connection.out.data() + sent, connection.out.size() - sent, MSG_NOSIGNAL);
+            if (written > 0) {
+                sent += static_cast<std::size_t>(written);
+            } else if (written < 0 && errno == EINTR) {
+                continue;
+            } else if (written < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            } else {
+                closeLater(connection);
+                return;
+            }
+        }
+        connection.out.erase(connection.out.begin(), connection.out.begin() + (std::ptrdiff_t) sent);
+        if (connection.out.empty() && connection.closeWhenFlushed) {
+            closeLater(connection);
+            return;
+        }
+        const bool writing = !connection.out.empty();
+        if (writing != connection.writing) {
+            connection.writing = writing;
+            epoll_event event{};
+            event.events = EPOLLIN | (writing ? EPOLLOUT : 0u);
+            event.data.ptr = &connection;
+            ::epoll_ctl(epollFd, EPOLL_CTL_MOD, connection.fd, &event);
+        }
+    }
+
+// Mark a connection closed; it stays allocated until the batch of events that may name it is done
+    void MatchServer::Worker::closeLater(Connection &connection) {
+        if (!connection.dead) {
+            connection.dead = true;
+            graveyard.push_back(&connection);
+        }
+    }
+
+// Close the dead connections, aborting matches they leave unfinished, and drop matches nobody is left in
+    void MatchServer::Worker::bury() {
+        std::vector<Connection *> dead;
+        dead.swap(graveyard);
+        for (Connection *connection : dead) {
+            Match &match = *connection->match;
+            match.seats[connection->seat] = nullptr;
+            match.open--;
+            if (match.phase != Match::Phase::Over) {
+                aborted.fetch_add(1, std::memory_order_relaxed);
+                endMatch(match, -1);
+            }
+            if (match.open == 0 && match.handed == 3) {
+                matches.erase(match.id);
+            }
+            ::epoll_ctl(epollFd, EPOLL_CTL_DEL, connection->fd, nullptr);
+            ::close(connection->fd);
+            connections.erase(connection->fd);
+        }
+    }
+
+// MatchServer Implementation
+
+// Bind the endpoint and prepare the workers
+    MatchServer::MatchServer(ServerOptions options) : _options(std::move(options)) {
+        _listenFd = listenOn(_options.endpoint, _options.backlog);
+        _wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (_wakeFd < 0) {
+            ::close(_listenFd);
+            throw std::runtime_error("Error: Cannot create the event file of the match server.");
+        }
+        if (_options.endpoint.unixPath.empty()) {
+            sockaddr_in address{};
+            socklen_t length = sizeof(address);
+            ::getsockname(_listenFd, reinterpret_cast<sockaddr *>(&address), &length);
+            _port = ntohs(address.sin_port);
+        }
+
+        unsigned threads = _options.threadCount;
+        if (threads == 0) {
+            threads = std::max(1u, std::thread::hardware_concurrency());
+        }
+        try {
+            for (unsigned i = 0; i < threads; ++i) {
+                _workers.push_back(std::make_unique<Worker>(_options));
+            }
+        } catch (...) {
+            _workers.clear();
+            ::close(_wakeFd);
+            ::close(_listenFd);
+            throw;
+        }
+    }
+
+    MatchServer::~MatchServer() {
+        stop();
+        _workers.clear();
+        ::close(_wakeFd);
+        ::close(_listenFd);
+        if (!_options.endpoint.unixPath.empty()) {
+            ::unlink(_options.endpoint.unixPath.c_str());
+        }
+    }
+
+// Start the workers, pinned if asked, then the acceptor
+    void MatchServer::start() {
+        if (_running) {
+            return;
+        }
+        _running = true;
+        for (std::size_t i = 0; i < _workers.size(); ++i) {
+            _workers[i]->thread = std::thread(&Worker::run, _workers[i].get());
+            if (_options.pinThreads) {
+                pinThread(_workers[i]->thread, i);
+            }
+        }
+        _acceptor = std::thread(&MatchServer::acceptLoop, this);
+    }
+
+// Stop the acceptor first so no connection is handed to a stopped worker
+    void MatchServer::stop() {
+        if (!_running) {
+            return;
+        }
+        _running = false;
+        wakeUp(_wakeFd);
+        _acceptor.join();
+        for (auto &worker : _workers) {
+            worker->stopping.store(true, std::memory_order_release);
+            wakeUp(worker->wakeFd);
+        }
+        for (auto &worker : _workers) {
+            worker->thread.join();
+        }
+    }
+
+// Seat every three consecutive connections in a match owned by the next worker
+    void MatchServer::acceptLoop() {
+        const int epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+        if (epollFd < 0) {
+            return;
+        }
+        epoll_event event{};
+        event.events = EPOLLIN;
+        event.data.fd = _listenFd;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, _listenFd, &event);
+        event.data.fd = _wakeFd;
+        ::epoll_ctl(epollFd, EPOLL_CTL_ADD, _wakeFd, &event);
+
+        std::vector<std::vector<Handoff>> batches(_workers.size());
+        std::array<epoll_event, 2> events{};
+        bool stopping = false;
+        while (!stopping) {
+            const int ready = ::epoll_wait(epollFd, events.data(), (int) events.size(), -1);
+            for (int i = 0; i < ready; ++i) {
+                stopping |= events[i].data.fd == _wakeFd;
+            }
+            if (stopping || ready <= 0) {
+                continue;
+            }
+
+            while (true) {
+                const int fd = ::accept4(_listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+                if (fd < 0) {
+                    if (errno == EINTR || errno == ECONNABORTED) {
+                        continue;
+                    }
+                    if (errno == EMFILE || errno == ENFILE) {
+                        // Out of descriptors: let the workers close finished matches before trying again
+                        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+                    }
+                    break;
+                }
+                if (_options.endpoint.unixPath.empty()) {
+                    int on = 1;
+                    ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+                }
+                const std::size_t index = _accepted.fetch_add(1, std::memory_order_relaxed);
+                const auto match = static_cast<std::uint32_t>(index / 3);
+                batches[match % batches.size()].push_back({fd, match, static_cast<int>(index % 3)});
+            }
+            for (std::size_t w = 0; w < batches.size(); ++w) {
+                if (!batches[w].empty()) {
+                    _workers[w]->hand(batches[w]);
+                }
+            }
+        }
+        ::close(epollFd);
+    }
+
+// Get the bound TCP port
+    std::uint16_t MatchServer::port() const {
+        return _port;
+    }
+
+// Sum the counters of the workers
+    ServerStats MatchServer::stats() const {
+        ServerStats stats;
+        stats.connections = _accepted.load(std::memory_order_relaxed);
+        for (const auto &worker : _workers) {
+            stats.matchesStarted += worker->started.load(std::memory_order_relaxed);
+            stats.matchesFinished += worker->finished.load(std::memory_order_relaxed);
+            stats.matchesAborted += worker->aborted.load(std::memory_order_relaxed);
+            stats.rejected += worker->rejected.load(std::memory_order_relaxed);
+        }
+        return stats;
+    }
+
+} // namespace strategy
@@ -1,15 +1,16 @@
 #include "Node.hpp"
 #include "Terrain.hpp"
+#include <stdexcept>
 
 namespace strategy {
 
 // Default constructor for Node
-    Node::Node() : _id(0), _city(nullptr), _settlement(nullptr), _occupied(false) {}
+    Node::Node() : _id(0), _city(nullptr), _settlement(nullptr), _occupied(false), _harbor(HarborType::None) {}
 
 // Parameterized constructor for Node
     Node::Node(int id, std::vector<Pathway *> pathways, std::vector<Terrain *> terrains)
             : _id(id), _city(nullptr), _settlement(nullptr), _occupied(false), _pathways(std::move(pathways)),
-              _terrains(std::move(terrains)) {}
+              _terrains(std::move(terrains)), _harbor(HarborType::None) {}
 
 // Destructor for Node
     Node::~Node() {
@@ -24,38 +25,82 @@ namespace strategy {
 
 // Add a Pathway to the Node
     void Node::addPathway(Pathway *p) {
+        if (_graph) {
+            throw std::logic_error("Error: The board graph is already built.");
+        }
         _pathways.push_back(p);
     }
 
 // Add a Terrain to the Node
     void Node::addTerrain(Terrain *t) {
+        if (_graph) {
+            throw std::logic_error("Error: The board graph is already built.");
+        }
         _terrains.push_back(t);
     }
 
 // Get the Terrain associated with the node at the specified index
     Terrain* Node::getTerrainAt(int i) {
-        return _terrains[i];
+        GraphRange<Terrain> terrains = getTerrains();
+        if (i >= 0 && i < (int) terrains.size()) {
+            return terrains[i];
+        }
+        return nullptr;
     }
 
 // Get the Pathway associated with the node at the specified index
     Pathway* Node::getPathwayAt(int i) {
-        return _pathways[i];
+        GraphRange<Pathway> pathways = getPathways();
+        if (i >= 0 && i < (int) pathways.size()) {
+            return pathways[i];
+        }
+        return nullptr;
+    }
+
+// View a list recorded during setup as a graph range
+    template<typename T>
+    static GraphRange<T> stagedRange(const std::vector<T *> &items) {
+        const std::uint8_t *first = BoardGraph::IDENTITY.data();
+        return {IndexRange(first, first + items.size()), items.data()};
     }
 
 // Get all Pathways associated with the Node
-    std::vector<Pathway *> Node::getPathways() {
-        return _pathways;
+    GraphRange<Pathway> Node::getPathways() const {
+        return _graph ? _graph->nodePathways(_index) : stagedRange(_pathways);
+    }
+
+// Get all Terrains around the Node
+    GraphRange<Terrain> Node::getTerrains() const {
+        return _graph ? _graph->nodeTerrains(_index) : stagedRange(_terrains);
+    }
+
+// Get all neighboring Nodes
+    GraphRange<Node> Node::getNeighbors() const {
+        return _graph ? _graph->nodeNeighbors(_index) : stagedRange(_neighbors);
+    }
+
+// Switch to the board graph and release the lists recorded during setup
+    void Node::attachGraph(const BoardGraph *graph, std::uint8_t index) {
+        _graph = graph;
+        _index = index;
+        std::vector<Pathway *>().swap(_pathways);
+        std::vector<Terrain *>().swap(_terrains);
+        std::vector<Node *>().swap(_neighbors);
     }
 
 // Set a neighboring node
     void Node::setNeighborNode(Node *neighbor) {
+        if (_graph) {
+            throw std::logic_error("Error: The board graph is already built.");
+        }
         _neighbors.push_back(neighbor);
     }
 
 // Get the neighboring node at the specified index
     Node* Node::getNeighborNode(size_t index) const {
-        if (index < _neighbors.size()) {
-            return _neighbors[index];
+        GraphRange<Node> neighbors = getNeighbors();
+        if (index < neighbors.size()) {
+            return neighbors[index];
         }
         return nullptr;
     }
@@ -79,7 +124,7 @@ namespace strategy {
     }
 
 // Check if the Node is occupied
-    bool Node::isOccupied() {
+    bool Node::isOccupied() const {
         return _occupied;
     }
 
@@ -89,19 +134,29 @@ namespace strategy {
     }
 
 // Get the Settlement at the Node
-    game::Settelment* Node::getSettlement() {
+    game::Settelment* Node::getSettlement() const {
         return _settlement;
     }
 
 // Get the City at the Node
-    game::City* Node::getCity() {
+    game::City* Node::getCity() const {
         return _city;
     }
 
+// Set the harbor reachable from the Node
+    void Node::setHarbor(HarborType harbor) {
+        _harbor = harbor;
+    }
+
+// Get the harbor reachable from the Node
+    HarborType Node::getHarbor() const {
+        return _harbor;
+    }
+
 // Print information about the Node
     void Node::displayNode() {
         std::cout << "Node ID: " << getId() << " , On Terrains: " << std::endl;
-        for (auto& terrain : _terrains) {
+        for (Terrain *terrain : getTerrains()) {
             if (terrain != nullptr) {
                 terrain->displayTerrain();
             }
@@ -110,14 +165,11 @@ namespace strategy {
     }
 
 // Default constructor for Pathway
-    Pathway::Pathway() : _id(0), _path(nullptr), _occupied(false), _owner(nullptr) {}
+    Pathway::Pathway() : _id(0), _nodes{nullptr, nullptr}, _path(nullptr), _occupied(false), _owner(nullptr) {}
 
 // Parameterized constructor for Pathway
     Pathway::Pathway(int id, Node *n1, Node *n2)
-            : _id(id), _path(nullptr), _occupied(false) {
-        _nodes.push_back(n1);
-        _nodes.push_back(n2);
-    }
+            : _id(id), _nodes{n1, n2}, _path(nullptr), _occupied(false), _owner(nullptr) {}
 
 // Destructor for Pathway
     Pathway::~Pathway() {
@@ -125,12 +177,12 @@ namespace strategy {
     }
 
 // Get the first Node associated with the Pathway
-    Node* Pathway::getNode1() {
+    Node* Pathway::getNode1() const {
         return _nodes[0];
     }
 
 // Get the second Node associated with the Pathway
-    Node* Pathway::getNode2() {
+    Node* Pathway::getNode2() const {
         return _nodes[1];
     }
 
@@ -166,7 +218,7 @@ namespace strategy {
     }
 
 // Check if the Pathway is occupied
-    bool Pathway::isOccupied() {
+    bool Pathway::isOccupied() const {
         return _occupied;
     }
 
@@ -0,0 +1,180 @@
+#include "PlacementSolver.hpp"
+#include "GameBoard.hpp"
+#include "Node.hpp"
+#include <algorithm>
+#include <atomic>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace strategy {
+
+// Add the income of a node to a player's income
+    static ExpectedIncome operator+(ExpectedIncome income, const ExpectedIncome &node) {
+        for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+            income.perResource[r] += node.perResource[r];
+        }
+        return income;
+    }
+
+// Read the node incomes and the buildings of the board
+    PlacementSolver::PlacementSolver(const GameBoard &board, int players, PlacementOptions options)
+            : _board(board), _players(players), _options(options), _income(computeNodeIncome(board.getProduction())) {
+        if (players < 1 || players > (int) ProductionTable::MAX_SEATS) {
+            throw std::invalid_argument("Error: The placement solver supports 1 to 8 players.");
+        }
+        if (_options.threadCount == 0) {
+            _options.threadCount = std::max(1u, std::thread::hardware_concurrency());
+        }
+        for (std::size_t node = 0; node < BoardGraph::MAX_NODES; ++node) {
+            _start[node] = static_cast<std::int8_t>(board.getProduction().nodeSeat(node));
+        }
+    }
+
+// Get the seat making a pick in snake order
+    int PlacementSolver::seatOfPick(int pick, int players) {
+        return pick < players ? pick : 2 * players - 1 - pick;
+    }
+
+// Expected income plus a bonus for every resource received
+    double PlacementSolver::value(const ExpectedIncome &income) const {
+        double score = income.total();
+        for (double cards : income.perResource) {
+            score += cards > 0.0 ? _options.diversityWeight : 0.0;
+        }
+        return score;
+    }
+
+// A node is legal when it and its neighbors are free
+    bool PlacementSolver::isLegal(const Occupancy &occupancy, std::size_t node) const {
+        if (occupancy[node] >= 0) {
+            return false;
+        }
+        for (std::uint8_t neighbor : _board.getGraph().nodeNeighborIndices(node)) {
+            if (occupancy[neighbor] >= 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+// Take a candidate, let the later picks choose greedily, and value the candidate's player at the end
+    double PlacementSolver::playOut(std::size_t candidate, int pick) const {
+        const ProductionTable &table = _board.getProduction();
+        Occupancy occupancy = _start;
+        std::array<ExpectedIncome, ProductionTable::MAX_SEATS> incomes{};
+        for (std::size_t node = 0; node < BoardGraph::MAX_NODES; ++node) {
+            for (int yield = 0; yield < table.nodeYield(node); ++yield) {
+                incomes[occupancy[node]] = incomes[occupancy[node]] + _income[node];
+            }
+        }
+
+        const int seat = seatOfPick(pick, _players);
+        occupancy[candidate] = static_cast<std::int8_t>(seat);
+        incomes[seat] = incomes[seat] + _income[candidate];
+
+        for (int later = pick + 1; later < 2 * _players; ++later) {
+            const int other = seatOfPick(later, _players);
+            const double base = value(incomes[other]);
+            double bestGain = -std::numeric_limits<double>::infinity();
+            std::size_t best = BoardGraph::MAX_NODES;
+            for (std::size_t node = 0; node < BoardGraph::MAX_NODES; ++node) {
+                if (!isLegal(occupancy, node)) {
+                    continue;
+                }
+                double gain = value(incomes[other] + _income[node]) - base;
+                if (gain > bestGain) {
+                    bestGain = gain;
+                    best = node;
+                }
+            }
+            if (best == BoardGraph::MAX_NODES) {
+                break;
+            }
+            occupancy[best] = static_cast<std::int8_t>(other);
+            incomes[other] = incomes[other] + _income[best];
+        }
+        return value(incomes[seat]);
+    }
+
+// Point the road at the best node two steps away that is still free
+    int PlacementSolver::choosePathway(std::size_t node, int seat) const {
+        const BoardGraph &graph = _board.getGraph();
+        Occupancy occupancy = _start;
+        occupancy[node] = static_cast<std::int8_t>(seat);
+
+        int bestPathway = 0;
+        double bestValue = -1.0;
+        for (std::uint8_t pathway : graph.nodePathwayIndices(node)) {
+            if (_board.getPathways()[pathway]->isOccupied()) {
+                continue;
+            }
+            const auto &ends = graph.pathwayNodeIndices(pathway);
+            if (ends[0] != node && ends[1] != node) {
+                continue;
+            }
+            const std::size_t far = ends[0] == node ? ends[1] : ends[0];
+            double reach = 0.0;
+            for (std::uint8_t target : graph.nodeNeighborIndices(far)) {
+                if (isLegal(occupancy, target)) {
+                    reach = std::max(reach, value(_income[target]));
+                }
+            }
+            if (reach > bestValue) {
+                bestValue = reach;
+                bestPathway = pathway + 1;
+            }
+        }
+        return bestPathway;
+    }
+
+// Score every legal node on the workers, then keep the best
+    std::vector<Placement> PlacementSolver::rank(int pick) const {
+        if (pick < 0 || pick >= 2 * _players) {
+            throw std::out_of_range("Error: Pick " + std::to_string(pick) + " is not part of the setup phase.");
+        }
+        const int seat = seatOfPick(pick, _players);
+        std::vector<std::size_t> candidates;
+        for (std::size_t node = 0; node < BoardGraph::MAX_NODES; ++node) {
+            if (isLegal(_start, node)) {
+                candidates.push_back(node);
+            }
+        }
+
+        std::vector<double> scores(candidates.size());
+        std::atomic<std::size_t> next{0};
+        auto work = [&]() {
+            for (std::size_t i = next++; i < candidates.size(); i = next++) {
+                scores[i] = playOut(candidates[i], pick);
+            }
+        };
+        const unsigned workers = std::min<unsigned>(_options.threadCount, static_cast<unsigned>(candidates.size()));
+        std::vector<std::thread> threads;
+        for (unsigned worker = 1; worker < workers; ++worker) {
+            threads.emplace_back(work);
+        }
+        work();
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+
+        std::vector<std::size_t> order(candidates.size());
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        const std::size_t kept = std::min(_options.limit, order.size());
+        std::partial_sort(order.begin(), order.begin() + (std::ptrdiff_t) kept, order.end(), [&](std::size_t a, std::size_t b) {
+            return scores[a] != scores[b] ? scores[a] > scores[b] : candidates[a] < candidates[b];
+        });
+
+        std::vector<Placement> placements;
+        placements.reserve(kept);
+        for (std::size_t i = 0; i < kept; ++i) {
+            const std::size_t node = candidates[order[i]];
+            placements.push_back({seat, (int) node + 1, choosePathway(node, seat), scores[order[i]]});
+        }
+        return placements;
+    }
+
+} // namespace strategy
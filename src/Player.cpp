@@ -1,11 +1,15 @@
 #include "Player.hpp"
 #include "Terrain.hpp"
+#include "GameLog.hpp"
+#include "Instrumentation.hpp"
 
 using namespace game;
 using namespace strategy;
 
 // Constructor
-Player::Player() = default;
+Player::Player() : _rng(std::random_device{}()), _discardStrategy(std::make_unique<RandomDiscardStrategy>()) {
+    _tradeRatios.fill(Bank::BANK_TRADE_RATIO);
+}
 
 // Destructor to safely delete dynamically allocated DevelopmentCard objects
 Player::~Player() {
@@ -18,8 +22,10 @@ Player::~Player() {
 // Constructor with name initialization and default resource setup
 Player::Player(std::string name)
         : _playerName(std::move(name)),
-          _resources({{"Lumber", 0}, {"Grain", 0}, {"Wool", 0}, {"Ore", 0}, {"Brick", 0}})
+          _rng(std::random_device{}()),
+          _discardStrategy(std::make_unique<RandomDiscardStrategy>())
 {
+    _tradeRatios.fill(Bank::BANK_TRADE_RATIO);
     _devCards[new MonopolyCard()] = 0;
     _devCards[new VictoryPointCard()] = 0;
     _devCards[new PlentyCard()] = 0;
@@ -49,38 +55,79 @@ void Player::activateTurn(bool isActive) {
 
 // Acquire a development card if the player has sufficient resources
 void Player::acquireDevelopmentCard() {
-    if (_resources["Grain"] < 1 || _resources["Ore"] < 1 || _resources["Wool"] < 1) {
-        std::cout << this->getName() +" Cannot acquire a Development Card: Insufficient resources." << std::endl;
+    CATAN_PROBE_SCOPE(DevelopmentCard);
+    if (!_resources.covers(DEVELOPMENT_CARD_COST)) {
+        gameLog() << this->getName() +" Cannot acquire a Development Card: Insufficient resources." << std::endl;
         return;
     }
+    addDevelopmentCard(_gameBoard->drawRandomDevCard());
+}
 
-    // Deduct resources and draw a random development card from the game board
-    _resources["Grain"]--;
-    _resources["Ore"]--;
-    _resources["Wool"]--;
-
-    DevelopmentCard *card = _gameBoard->drawRandomDevCard();
+// Acquire a specific kind of development card, as recorded in a replayed game
+void Player::acquireDevelopmentCard(DevCardType type) {
+    CATAN_PROBE_SCOPE(DevelopmentCard);
+    if (!_resources.covers(DEVELOPMENT_CARD_COST)) {
+        gameLog() << this->getName() +" Cannot acquire a Development Card: Insufficient resources." << std::endl;
+        return;
+    }
+    addDevelopmentCard(_gameBoard->drawDevCard(type));
+}
 
+// Pay for a drawn development card and add it to the player's collection
+void Player::addDevelopmentCard(DevelopmentCard *card) {
     if (!card) {
-        std::cout << "No Development Cards are available." << std::endl;
+        gameLog() << "No Development Cards are available." << std::endl;
         return;
     }
 
-    // Add the drawn card to the player's collection
+    payToBank(DEVELOPMENT_CARD_COST);
     _devCards[card]++;
-    std::cout << _playerName << " acquired a Development Card: " << card->cardType() << std::endl;
+    gameLog() << _playerName << " acquired a Development Card: " << card->cardType() << std::endl;
+
+    GameAction action;
+    action.type = ActionType::BuyDevelopmentCard;
+    action.value = static_cast<int>(card->cardTypeId());
+    action.give = DEVELOPMENT_CARD_COST;
+    publishAction(action);
+}
+
+// Find a development card of a specific kind in the player's collection
+DevelopmentCard *Player::findDevelopmentCard(DevCardType type) {
+    for (auto &pair : _devCards) {
+        if (pair.second > 0 && pair.first->cardTypeId() == type) {
+            return pair.first;
+        }
+    }
+    return nullptr;
+}
+
+// Count the development cards of a specific kind the player holds
+int Player::countDevelopmentCards(DevCardType type) const {
+    int count = 0;
+    for (const auto &pair : _devCards) {
+        if (pair.first->cardTypeId() == type) {
+            count += pair.second;
+        }
+    }
+    return count;
 }
 
 // Activate a development card
 void Player::activateDevelopmentCard(DevelopmentCard *card) {
+    CATAN_PROBE_SCOPE(DevelopmentCard);
     if (!card) {
-        std::cout << "Error: No Development Card available to activate." << std::endl;
+        gameLog() << "Error: No Development Card available to activate." << std::endl;
         return;
     }
     if (_devCards[card] == 0) {
         throw std::invalid_argument("Error: The player doesn't possess the specified Development Card.");
     }
+
+    GameAction action;
+    action.type = ActionType::PlayDevelopmentCard;
+    action.value = static_cast<int>(card->cardTypeId());
     applyDevelopmentCardEffect(card);
+    publishAction(action);
 }
 
 // Simplify resource name for internal use
@@ -96,14 +143,10 @@ std::string Player::simplifyResourceName(const std::string &complexName) {
 // Apply the effect of a development card
 void Player::applyDevelopmentCardEffect(DevelopmentCard *card) {
     if (card->cardType() == "Monopoly") {
-        std::string resourceType;
-        int minQuantity = std::numeric_limits<int>::max();
-
-        for (const auto &entry : _resources) {
-            std::string simpleName = simplifyResourceName(entry.first);
-            if (entry.second < minQuantity) {
-                minQuantity = entry.second;
-                resourceType = simpleName;  // Now stores the simplified name
+        std::size_t resourceType = 0;
+        for (std::size_t i = 1; i < RESOURCE_TYPE_COUNT; ++i) {
+            if (_resources[i] < _resources[resourceType]) {
+                resourceType = i;
             }
         }
 
@@ -113,38 +156,38 @@ void Player::applyDevelopmentCardEffect(DevelopmentCard *card) {
             _resources[resourceType] += amount;
         }
 
-        std::cout << _playerName << " activated a Monopoly Card and acquired all " << resourceType << " from other players!" << std::endl;
+        gameLog() << _playerName << " activated a Monopoly Card and acquired all "
+                  << resourceName(static_cast<ResourceType>(resourceType)) << " from other players!" << std::endl;
     } else if (card->cardType() == "Victory Point") {
         _score++;
-        std::cout << _playerName << " gained 1 Victory Point!" << std::endl;
+        gameLog() << _playerName << " gained 1 Victory Point!" << std::endl;
     } else if (card->cardType() == "Year of Plenty") {
-        std::string resource1, resource2;
+        std::size_t resource1 = 0, resource2 = 0;
         int minValue1 = std::numeric_limits<int>::max(), minValue2 = std::numeric_limits<int>::max();
 
-        for (const auto &entry : _resources) {
-            std::string simplifiedName = simplifyResourceName(entry.first);
-
-            if (entry.second < minValue1) {
+        for (std::size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i) {
+            if (_resources[i] < minValue1) {
                 minValue2 = minValue1;
                 resource2 = resource1;
-                minValue1 = entry.second;
-                resource1 = simplifiedName;
-            } else if (entry.second < minValue2) {
-                minValue2 = entry.second;
-                resource2 = simplifiedName;
+                minValue1 = _resources[i];
+                resource1 = i;
+            } else if (_resources[i] < minValue2) {
+                minValue2 = _resources[i];
+                resource2 = i;
             }
         }
 
-        _resources[resource1]++;
-        _resources[resource2]++;
-        std::cout << _playerName << " activated Year of Plenty and gained 1 " << resource1 << " and 1 " << resource2 << std::endl;
+        takeFromBank(static_cast<ResourceType>(resource1), 1);
+        takeFromBank(static_cast<ResourceType>(resource2), 1);
+        gameLog() << _playerName << " activated Year of Plenty and gained 1 " << resourceName(static_cast<ResourceType>(resource1))
+                  << " and 1 " << resourceName(static_cast<ResourceType>(resource2)) << std::endl;
     } else if (card->cardType() == "Road Building") {
         ResourceCard* lumberCard = new LumberCard();
         ResourceCard* brickCard = new BrickCard();
 
         obtainResourceCard(lumberCard);
         obtainResourceCard(brickCard);
-        std::cout << _playerName << " activated Road Building and gained resources to build two roads!" << std::endl;
+        gameLog() << _playerName << " activated Road Building and gained resources to build two roads!" << std::endl;
 
         // Ensure these cards are deleted after use
         delete lumberCard;
@@ -152,9 +195,9 @@ void Player::applyDevelopmentCardEffect(DevelopmentCard *card) {
     } else if (card->cardType() == "Knight") {
         if (_devCards[card] == 3) {
             _score += 2;
-            std::cout << _playerName << " activated a third Knight Card and gained 2 Victory Points!" << std::endl;
+            gameLog() << _playerName << " activated a third Knight Card and gained 2 Victory Points!" << std::endl;
         } else {
-            std::cout << _playerName << " activated a Knight Card!" << std::endl;
+            gameLog() << _playerName << " activated a Knight Card!" << std::endl;
         }
     }
 
@@ -169,36 +212,90 @@ void Player::applyDevelopmentCardEffect(DevelopmentCard *card) {
 
 // Obtain a resource card and add it to the player's collection
 void Player::obtainResourceCard(ResourceCard *card) {
-    _resources[card->getType()]++;
-    std::cout << _playerName << " received 1 " << card->getType() << std::endl;
+    ResourceType type = resourceFromName(card->getType());
+    if (type == ResourceType::None) {
+        return;
+    }
+    if (takeFromBank(type, 1) == 0) {
+        gameLog() << "The bank has no " << resourceName(type) << " left for " << _playerName << std::endl;
+        return;
+    }
+    gameLog() << _playerName << " received 1 " << card->getType() << std::endl;
 }
 
 // Receive two resource cards
 void Player::receiveTwoResourceCards(ResourceCard *card) {
-    _resources[card->getType()] += 2;
-    std::cout << _playerName << " received 2 " << card->getType() << std::endl;
+    ResourceType type = resourceFromName(card->getType());
+    if (type == ResourceType::None) {
+        return;
+    }
+    // Take both cards or none, so the hand matches what is logged
+    if (_gameBoard && _gameBoard->getBank().getSupply()[type] < 2) {
+        gameLog() << "The bank has too few " << resourceName(type) << " left for " << _playerName << std::endl;
+        return;
+    }
+    takeFromBank(type, 2);
+    gameLog() << _playerName << " received 2 " << card->getType() << std::endl;
+}
+
+// Receive the cards produced by a roll
+void Player::receiveProduction(const ResourceCounts &cards) {
+    _resources += cards;
+    for (std::size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i) {
+        if (cards[i] > 0) {
+            gameLog() << _playerName << " received " << cards[i] << " " << resourceName(static_cast<ResourceType>(i)) << std::endl;
+        }
+    }
+}
+
+// Replace the hand, the development cards and the score with saved ones
+void Player::restoreCards(const ResourceCounts &resources,
+                          const std::array<std::uint8_t, DEV_CARD_TYPE_COUNT> &devCards, int score) {
+    std::array<bool, DEV_CARD_TYPE_COUNT> placed{};
+    for (auto &pair : _devCards) {
+        const auto type = static_cast<std::size_t>(pair.first->cardTypeId());
+        pair.second = placed[type] ? 0 : devCards[type];
+        placed[type] = true;
+    }
+    for (std::size_t type = 0; type < DEV_CARD_TYPE_COUNT; ++type) {
+        if (placed[type] || devCards[type] == 0) {
+            continue;
+        }
+        DevelopmentCard *card = nullptr;
+        switch (static_cast<DevCardType>(type)) {
+            case DevCardType::Monopoly: card = new MonopolyCard(); break;
+            case DevCardType::VictoryPoint: card = new VictoryPointCard(); break;
+            case DevCardType::YearOfPlenty: card = new PlentyCard(); break;
+            case DevCardType::RoadBuilding: card = new RoadBuildingCard(); break;
+            case DevCardType::Knight: card = new KnightCard(); break;
+            case DevCardType::None: continue;
+        }
+        _devCards[card] = devCards[type];
+    }
+    _resources = resources;
+    _score = score;
 }
 
 // Display all development cards owned by the player
 void Player::displayDevelopmentCards() const {
-    std::cout << _playerName << "'s Development Cards: ";
+    gameLog() << _playerName << "'s Development Cards: ";
     for (const auto &pair : _devCards) {
         if (pair.second > 0) {
-            std::cout << pair.first->cardType() << " x" << pair.second << " ";
+            gameLog() << pair.first->cardType() << " x" << pair.second << " ";
         }
     }
-    std::cout << std::endl;
+    gameLog() << std::endl;
 }
 
 // Display all resource cards owned by the player
 void Player::displayResourceCards() const {
-    std::cout << _playerName << "'s Resource Cards: ";
-    for (const auto &pair : _resources) {
-        if (pair.second > 0) {
-            std::cout << pair.first << " x" << pair.second << " ";
+    gameLog() << _playerName << "'s Resource Cards: ";
+    for (std::size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i) {
+        if (_resources[i] > 0) {
+            gameLog() << resourceName(static_cast<ResourceType>(i)) << " x" << _resources[i] << " ";
         }
     }
-    std::cout << std::endl;
+    gameLog() << std::endl;
 }
 
 // Roll dice, move, and handle resource distribution
@@ -207,34 +304,40 @@ int Player::rollDiceAndMove() {
         throw std::logic_error("Error:"+this->_playerName + ": It is not your turn.");
     }
 
-    std::random_device rd;
-    std::mt19937 gen(rd());
     std::uniform_int_distribution<> dis(1, 6);
+    int roll1 = dis(_rng);
+    int roll2 = dis(_rng);
+    return rollDiceAndMove(roll1, roll2);
+}
+
+// Move with known dice values and handle resource distribution
+int Player::rollDiceAndMove(int die1, int die2) {
+    CATAN_PROBE_SCOPE(Roll);
+    if (!_turnActive) {
+        throw std::logic_error("Error:"+this->_playerName + ": It is not your turn.");
+    }
+    if (die1 < 1 || die1 > 6 || die2 < 1 || die2 > 6) {
+        throw std::invalid_argument("Error: Dice values must be between 1 and 6.");
+    }
+
+    int rollTotal = die1 + die2;
 
-    int roll1 = dis(gen);
-    int roll2 = dis(gen);
-    int rollTotal = roll1 + roll2;
+    GameAction action;
+    action.type = ActionType::Roll;
+    action.value = die1;
+    action.extra = die2;
+    publishAction(action);
 
-    std::cout << _playerName << " rolled a " << rollTotal << std::endl;
+    gameLog() << _playerName << " rolled a " << rollTotal << std::endl;
 
     if (rollTotal == 7) {
-        std::cout << "Players with more than 7 resource cards must discard half of them." << std::endl;
+        gameLog() << "Players with more than 7 resource cards must discard half of them." << std::endl;
         discardResourceCards();
     }
 
-    for (int i = 0; i < 19; ++i) {
-        Terrain *terrain = _gameBoard->locateTerrain(i);
-        if (terrain->getTerrainNum() == rollTotal) {
-            for (Node *node : terrain->getNodes()) {
-                if (node && node->isOccupied()) {
-                    if (node->getSettlement() && node->getSettlement()->identifyOwner() == this) {
-                        obtainResourceCard(terrain->getCard());
-                    } else if (node->getCity() && node->getCity()->identifyOwner() == this) {
-                        receiveTwoResourceCards(terrain->getCard());
-                    }
-                }
-            }
-        }
+    {
+        CATAN_PROBE_SCOPE(Production);
+        _gameBoard->produce(rollTotal);
     }
 
     _turnActive = false;
@@ -245,31 +348,29 @@ int Player::rollDiceAndMove() {
 
 // Build a pathway on the game board
 void Player::buildPathway(int pathNum) {
+    CATAN_PROBE_SCOPE(Build);
     Pathway *pathway = _gameBoard->locatePathway(pathNum);
 
     if (!pathway) {
-        std::cout << "Error: Pathway " << pathNum << " not found on the game board." << std::endl;
+        gameLog() << "Error: Pathway " << pathNum << " not found on the game board." << std::endl;
         return;
     }
 
     if (pathway->isOccupied()) {
-        std::cout << this->getName() + "Cannot build a Pathway: This Pathway is already occupied." << std::endl;
+        gameLog() << this->getName() + "Cannot build a Pathway: This Pathway is already occupied." << std::endl;
         return;
     }
 
-    if (_resources["Lumber"] < 1 || _resources["Brick"] < 1) {
-        std::cout <<this->getName() + "Cannot build a Pathway: Insufficient resources." << std::endl;
+    if (!_resources.covers(ROAD_COST)) {
+        gameLog() <<this->getName() + "Cannot build a Pathway: Insufficient resources." << std::endl;
         return;
     }
 
-    _resources["Lumber"]--;
-    _resources["Brick"]--;
-
     Node *node1 = pathway->getNode1();
     Node *node2 = pathway->getNode2();
 
     if (!node1 || !node2) {
-        std::cout << "Error: One or both nodes for Pathway " << pathNum << " are not properly initialized." << std::endl;
+        gameLog() << "Error: One or both nodes for Pathway " << pathNum << " are not properly initialized." << std::endl;
         return;
     }
 
@@ -292,17 +393,25 @@ void Player::buildPathway(int pathNum) {
     }
 
     if (canBuild) {
+        payToBank(ROAD_COST);
         pathway->setOccupied(true);
         pathway->setPath(new Pathway(pathway->getId(), pathway->getNode1(), pathway->getNode2()));
         pathway->setPlayer(this);
-        std::cout << _playerName << " built a Pathway at location " << pathNum << std::endl;
+        gameLog() << _playerName << " built a Pathway at location " << pathNum << std::endl;
+
+        GameAction action;
+        action.type = ActionType::BuildPathway;
+        action.value = pathNum;
+        action.give = ROAD_COST;
+        publishAction(action);
     } else {
-        std::cout << this->getName() + " Cannot build a Pathway: No connected settlement or road." << std::endl;
+        gameLog() << this->getName() + " Cannot build a Pathway: No connected settlement or road." << std::endl;
     }
 }
 
 // Build a settlement on the game board
 void Player::buildSettlement(int NodeNum) {
+    CATAN_PROBE_SCOPE(Build);
     Node *node = _gameBoard->locateNode(NodeNum);
     if (node == nullptr) {
         std::cerr << "Error: Node " << NodeNum << " not found on the game board." << std::endl;
@@ -310,19 +419,19 @@ void Player::buildSettlement(int NodeNum) {
     }
 
     if (node->isOccupied()) {
-        std::cout << this->getName() +" Cannot build a Settlement at Node " << NodeNum << ": This Node is already occupied." << std::endl;
+        gameLog() << this->getName() +" Cannot build a Settlement at Node " << NodeNum << ": This Node is already occupied." << std::endl;
         return;
     }
 
-    if (_resources["Lumber"] < 1 || _resources["Brick"] < 1 || _resources["Grain"] < 1 || _resources["Wool"] < 1) {
-        std::cout << this->getName() +" Cannot build a Settlement: Insufficient resources." << std::endl;
+    if (!_resources.covers(SETTLEMENT_COST)) {
+        gameLog() << this->getName() +" Cannot build a Settlement: Insufficient resources." << std::endl;
         return;
     }
 
     for (size_t i = 0; i < 3; ++i) {
         Node *neighborNode = node->getNeighborNode(i);
         if (neighborNode != nullptr && neighborNode->isOccupied()) {
-            std::cout << "Cannot build a Settlement at Node " << NodeNum << ": A neighboring Node (" << neighborNode->getId() << ") is already occupied." << std::endl;
+            gameLog() << "Cannot build a Settlement at Node " << NodeNum << ": A neighboring Node (" << neighborNode->getId() << ") is already occupied." << std::endl;
             return;
         }
     }
@@ -331,13 +440,13 @@ void Player::buildSettlement(int NodeNum) {
     for (int i = 0; i < 3; ++i) {
         Pathway *pathway = node->getPathwayAt(i);
         if (pathway == nullptr) {
-            std::cout << "Pathway " << i << " is nullptr." << std::endl;
+            gameLog() << "Pathway " << i << " is nullptr." << std::endl;
         } else {
             if (!pathway->isOccupied()) {
-                std::cout << "Pathway " << i << " is not occupied." << std::endl;
+                gameLog() << "Pathway " << i << " is not occupied." << std::endl;
             } else {
                 if (pathway->getPlayer() != this) {
-                    std::cout << "Pathway " << i << " is not owned by " << _playerName << "." << std::endl;
+                    gameLog() << "Pathway " << i << " is not owned by " << _playerName << "." << std::endl;
                 } else {
                     hasConnectedPathway = true;
                     break;
@@ -347,37 +456,48 @@ void Player::buildSettlement(int NodeNum) {
     }
 
     if (!hasConnectedPathway) {
-        std::cout << this->getName() + " Cannot build a Settlement: No connected pathway to this Node." << std::endl;
+        gameLog() << this->getName() + " Cannot build a Settlement: No connected pathway to this Node." << std::endl;
         return;
     }
 
-    _resources["Lumber"]--;
-    _resources["Brick"]--;
-    _resources["Grain"]--;
-    _resources["Wool"]--;
+    payToBank(SETTLEMENT_COST);
 
     node->setSettlement(new Settelment(this));
+    claimHarbor(node->getHarbor());
     _score++;
-    std::cout << _playerName << " successfully built a Settlement at Node " << NodeNum << std::endl;
+    gameLog() << _playerName << " successfully built a Settlement at Node " << NodeNum << std::endl;
+
+    GameAction action;
+    action.type = ActionType::BuildSettlement;
+    action.value = NodeNum;
+    action.give = SETTLEMENT_COST;
+    publishAction(action);
 }
 
 // Upgrade a settlement to a city on the game board
 void Player::upgradeToCity(int nodeNum) {
-    if (_gameBoard->locateNode(nodeNum)->getCity() || !_gameBoard->locateNode(nodeNum)->getSettlement()) {
+    CATAN_PROBE_SCOPE(Build);
+    Node *node = _gameBoard->locateNode(nodeNum);
+    if (!node || node->getCity() || !node->getSettlement() || node->getSettlement()->identifyOwner() != this) {
         throw std::invalid_argument(this->getName()+" Cannot upgrade to a City here.");
     }
 
-    if (_resources["Grain"] < 2 || _resources["Ore"] < 3) {
+    if (!_resources.covers(CITY_COST)) {
         throw std::logic_error("Error " + this->getName()+": Insufficient resources to upgrade to a City.");
     }
 
-    _resources["Grain"] -= 2;
-    _resources["Ore"] -= 3;
+    payToBank(CITY_COST);
 
     City *city = new City(this);
-    _gameBoard->locateNode(nodeNum)->setCity(city);
+    node->setCity(city);
     _score++;
-    std::cout << _playerName << " upgraded a Settlement to a City at Node " << nodeNum << std::endl;
+    gameLog() << _playerName << " upgraded a Settlement to a City at Node " << nodeNum << std::endl;
+
+    GameAction action;
+    action.type = ActionType::UpgradeToCity;
+    action.value = nodeNum;
+    action.give = CITY_COST;
+    publishAction(action);
 }
 
 // Distribute resources after placing a settlement
@@ -394,16 +514,17 @@ void Player::distributeResourcesAfterSettlement(int nodeNum) {
             if (card) {
                 obtainResourceCard(card);
             } else {
-                std::cout << "Warning: Terrain " << terrain->getId() << " does not have an associated resource card." << std::endl;
+                gameLog() << "Warning: Terrain " << terrain->getId() << " does not have an associated resource card." << std::endl;
             }
         } else {
-            std::cout << "Warning: Terrain at index " << i << " for Node " << nodeNum << " is null." << std::endl;
+            gameLog() << "Warning: Terrain at index " << i << " for Node " << nodeNum << " is null." << std::endl;
         }
     }
 }
 
 // Establish initial settlement
 void Player::establishInitialSettlement(int nodeNum) {
+    CATAN_PROBE_SCOPE(Setup);
     Node *node = _gameBoard->locateNode(nodeNum);
 
     if (!node) {
@@ -418,23 +539,30 @@ void Player::establishInitialSettlement(int nodeNum) {
     node->setSettlement(settlement);
     node->setOccupied(true);
     settlement->assignOwner(this);
+    claimHarbor(node->getHarbor());
 
-    std::cout << _playerName << " placed their initial Settlement at Node " << nodeNum << std::endl;
+    gameLog() << _playerName << " placed their initial Settlement at Node " << nodeNum << std::endl;
 
     for (int i = 0; i < 3; ++i) {
         Terrain *terrain = node->getTerrainAt(i);
         if (terrain) {
-            std::cout << "Added settlement to terrain number: " << terrain->getId() << std::endl;
+            gameLog() << "Added settlement to terrain number: " << terrain->getId() << std::endl;
         }
     }
 
     distributeResourcesAfterSettlement(nodeNum);
 
     _score++;
+
+    GameAction action;
+    action.type = ActionType::InitialSettlement;
+    action.value = nodeNum;
+    publishAction(action);
 }
 
 // Establish initial pathway
 void Player::establishInitialPathway(int pathNum) {
+    CATAN_PROBE_SCOPE(Setup);
     Pathway *pathway = _gameBoard->locatePathway(pathNum);
 
     if (!pathway) {
@@ -449,7 +577,12 @@ void Player::establishInitialPathway(int pathNum) {
         pathway->setOccupied(true);
         pathway->setPath(new Pathway(pathway->getId(), node1, node2));
         pathway->setPlayer(this);
-        std::cout << _playerName << " placed their initial Road at Pathway " << pathNum << std::endl;
+        gameLog() << _playerName << " placed their initial Road at Pathway " << pathNum << std::endl;
+
+        GameAction action;
+        action.type = ActionType::InitialPathway;
+        action.value = pathNum;
+        publishAction(action);
     } else {
         throw std::logic_error("Error: Cannot place the initial road. No connected settlement found.");
     }
@@ -457,66 +590,65 @@ void Player::establishInitialPathway(int pathNum) {
 
 // Discard resource cards when required
 void Player::discardResourceCards() {
-    for (auto &pair : _resources) {
-        int count = pair.second;
-        if (count > 7) {
-            reduceResourceCards(_resources);
-            std::cout << _playerName << " discarded half of their resource cards." << std::endl;
-            break;
-        }
-    }
+    discardHalf();
     for (Player *player : _otherParticipants) {
-        for (auto &pair : player->_resources) {
-            int count = pair.second;
-            if (count > 7) {
-                reduceResourceCards(player->_resources);
-                std::cout << player->_playerName << " discarded half of their resource cards." << std::endl;
-            }
-        }
+        player->discardHalf();
     }
 }
 
-// Reduce the number of resource cards when required
-void Player::reduceResourceCards(std::map<std::string, int> &cards) {
-    int total = 0;
-    for (const auto &pair : cards) {
-        total += pair.second;
+// Discard half of the hand, rounded down, if it holds more than 7 cards
+int Player::discardHalf() {
+    CATAN_PROBE_SCOPE(Discard);
+    int total = _resources.total();
+    if (total <= 7) {
+        return 0;
     }
 
-    if (total > 7) {
-        int target = total / 2;
-        std::vector<std::string> resourceTypes;
+    int amount = total / 2;
+    ResourceCounts discard = _discardStrategy->chooseDiscard(*this, _resources, amount);
 
-        for (const auto &pair : cards) {
-            if (pair.second > 0) {
-                resourceTypes.push_back(pair.first);
-            }
-        }
+    // Fall back to a random discard if the strategy returned an illegal selection, seeded from the
+    // player's engine so seeded games stay reproducible
+    if (discard.total() != amount || !_resources.covers(discard) || !discard.covers(ResourceCounts{})) {
+        RandomDiscardStrategy fallback(static_cast<std::uint32_t>(_rng()));
+        discard = fallback.chooseDiscard(*this, _resources, amount);
+    }
 
-        std::random_device rd;
-        std::mt19937 gen(rd());
-        std::uniform_int_distribution<> dis(0, (int )resourceTypes.size() - 1);
-
-        while (total > target) {
-            int index = dis(gen);
-            std::string type = resourceTypes[index];
-            if (cards[type] > 0) {
-                cards[type]--;
-                total--;
-                if (cards[type] == 0) {
-                    resourceTypes.erase(resourceTypes.begin() + index);
-                    if (resourceTypes.empty()) {
-                        break;
-                    }
-                }
-            }
-        }
+    payToBank(discard);
+    gameLog() << _playerName << " discarded half of their resource cards." << std::endl;
+
+    GameAction action;
+    action.type = ActionType::Discard;
+    action.give = discard;
+    publishAction(action);
+    return amount;
+}
+
+// Set the policy used to choose cards when discarding
+void Player::setDiscardStrategy(std::unique_ptr<DiscardStrategy> strategy) {
+    if (!strategy) {
+        throw std::invalid_argument("Error: Discard strategy cannot be null.");
     }
+    _discardStrategy = std::move(strategy);
+}
+
+// Count all resource cards the player holds
+int Player::countResourceCards() const {
+    return _resources.total();
+}
+
+// Get the player's resource counts
+const ResourceCounts &Player::getResources() const {
+    return _resources;
 }
 
 // Count the number of a specific resource card
 int Player::countSpecificResourceCard(const std::string &type) const {
-    return _resources.at(type);
+    ResourceType resource = resourceFromName(type);
+    if (resource == ResourceType::None) {
+        throw std::out_of_range("Error: Unknown resource type " + type + ".");
+    }
+    return _resources[resource];
 }
 
 // Trade resources with another participant
@@ -525,22 +657,140 @@ void Player::conductTrade(Player *participant, const std::string &give, const st
         throw std::invalid_argument("Error: Cannot trade with oneself.");
     }
 
-    std::string simplifiedGive = simplifyResourceName(give);
-    std::string simplifiedReceive = simplifyResourceName(receive);
-
-    if (_resources[simplifiedGive] >= amountGive && participant->_resources[simplifiedReceive] >= amountReceive) {
-        _resources[simplifiedGive] -= amountGive;
-        _resources[simplifiedReceive] += amountReceive;
-        participant->_resources[simplifiedReceive] -= amountReceive;
-        participant->_resources[simplifiedGive] += amountGive;
+    ResourceType giveType = resourceFromName(give);
+    ResourceType receiveType = resourceFromName(receive);
+    if (giveType == ResourceType::None || receiveType == ResourceType::None || amountGive < 0 || amountReceive < 0) {
+        throw std::invalid_argument("Error: Trade could not be completed.");
+    }
 
-        std::cout << _playerName << " traded " << amountGive << " " << simplifiedGive << " with " << participant->getName()
-                  << " for " << amountReceive << " " << simplifiedReceive << std::endl;
-    } else {
+    ResourceCounts giveCards, receiveCards;
+    giveCards[giveType] = amountGive;
+    receiveCards[receiveType] = amountReceive;
+    if (!exchangeResources(participant, giveCards, receiveCards)) {
         throw std::invalid_argument("Error: Trade could not be completed.");
     }
 }
 
+// Exchange several resources with another player atomically
+bool Player::exchangeResources(Player *participant, const ResourceCounts &give, const ResourceCounts &receive) {
+    CATAN_PROBE_SCOPE(Trade);
+    if (!participant || participant == this || !give.covers(ResourceCounts{}) || !receive.covers(ResourceCounts{})) {
+        return false;
+    }
+    if (!_resources.covers(give) || !participant->_resources.covers(receive)) {
+        return false;
+    }
+
+    _resources -= give;
+    _resources += receive;
+    participant->_resources -= receive;
+    participant->_resources += give;
+
+    gameLog() << _playerName << " traded";
+    for (std::size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i) {
+        if (give[i] > 0) gameLog() << " " << give[i] << " " << resourceName(static_cast<ResourceType>(i));
+    }
+    gameLog() << " with " << participant->getName() << " for";
+    for (std::size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i) {
+        if (receive[i] > 0) gameLog() << " " << receive[i] << " " << resourceName(static_cast<ResourceType>(i));
+    }
+    gameLog() << std::endl;
+
+    GameAction action;
+    action.type = ActionType::PlayerTrade;
+    action.partner = static_cast<std::uint8_t>(std::max(participant->_seat, 0));
+    action.give = give;
+    action.receive = receive;
+    publishAction(action);
+    return true;
+}
+
+// Set the policy answering trade offers made to this player
+void Player::setTradePolicy(std::unique_ptr<TradePolicy> policy) {
+    _tradePolicy = std::move(policy);
+}
+
+// Get the policy answering trade offers made to this player
+TradePolicy *Player::getTradePolicy() const {
+    return _tradePolicy.get();
+}
+
+// Get the other participants in the game
+const std::vector<Player *> &Player::getOtherParticipants() const {
+    return _otherParticipants;
+}
+
+// Record the trade ratios granted by a harbor
+void Player::claimHarbor(HarborType harbor) {
+    if (harbor == HarborType::Generic) {
+        for (auto &ratio : _tradeRatios) {
+            ratio = std::min<std::uint8_t>(ratio, Bank::GENERIC_HARBOR_RATIO);
+        }
+    } else if (harbor != HarborType::None) {
+        _tradeRatios[static_cast<std::size_t>(harborResource(harbor))] = Bank::RESOURCE_HARBOR_RATIO;
+    }
+}
+
+// Get the best ratio at which the player can trade a resource with the bank
+int Player::bestTradeRatio(ResourceType type) const {
+    return _tradeRatios[static_cast<std::size_t>(type)];
+}
+
+// Get the best trade ratio of every resource
+const std::array<std::uint8_t, RESOURCE_TYPE_COUNT> &Player::getTradeRatios() const {
+    return _tradeRatios;
+}
+
+// Check whether a trade with the bank is possible
+bool Player::canTradeWithBank(ResourceType give, ResourceType receive, int amountReceive) const {
+    if (give == receive || give == ResourceType::None || receive == ResourceType::None || amountReceive < 1 || !_gameBoard) {
+        return false;
+    }
+    return _resources[give] >= bestTradeRatio(give) * amountReceive &&
+           _gameBoard->getBank().supply(receive) >= amountReceive;
+}
+
+// Trade resources with the bank at the player's best ratio
+bool Player::tradeWithBank(ResourceType give, ResourceType receive, int amountReceive) {
+    CATAN_PROBE_SCOPE(Trade);
+    if (!canTradeWithBank(give, receive, amountReceive)) {
+        gameLog() << _playerName << " Cannot trade " << resourceName(give) << " for " << resourceName(receive)
+                  << " with the bank." << std::endl;
+        return false;
+    }
+
+    int amountGive = bestTradeRatio(give) * amountReceive;
+    ResourceCounts payment;
+    payment[give] = amountGive;
+    payToBank(payment);
+    takeFromBank(receive, amountReceive);
+
+    gameLog() << _playerName << " traded " << amountGive << " " << resourceName(give) << " with the bank for "
+              << amountReceive << " " << resourceName(receive) << std::endl;
+
+    GameAction action;
+    action.type = ActionType::BankTrade;
+    action.give = payment;
+    action.receive[receive] = amountReceive;
+    publishAction(action);
+    return true;
+}
+
+// Pay cards from the hand back to the bank
+void Player::payToBank(const ResourceCounts &cards) {
+    _resources -= cards;
+    if (_gameBoard) {
+        _gameBoard->getBank().deposit(cards);
+    }
+}
+
+// Take cards from the bank into the hand, limited by the bank's supply
+int Player::takeFromBank(ResourceType type, int amount) {
+    int received = _gameBoard ? _gameBoard->getBank().withdraw(type, amount) : amount;
+    _resources[type] += received;
+    return received;
+}
+
 // Draw a development card from the player's collection
 DevelopmentCard *Player::drawDevelopmentCard() {
     for (auto &pair : _devCards) {
@@ -561,8 +811,74 @@ void Player::setOtherPlayer(Player *participant) {
     _otherParticipants.push_back(participant);
 }
 
-// Assign the game board to the player
+// Assign the game board to the player and take a seat at it
 void Player::assignGameBoard(strategy::GameBoard *board) {
     _gameBoard = board;
+    _seat = board ? board->registerPlayer(this) : -1;
+}
+
+// Get the player's seat at the game board
+int Player::getSeat() const {
+    return _seat;
+}
+
+// Seed the random engine used for dice rolls
+void Player::seedRandom(std::uint32_t seed) {
+    _rng.seed(seed);
+}
+
+// Notify the game board's observers of an action taken by this player
+void Player::publishAction(GameAction &action) {
+    if (_gameBoard) {
+        action.seat = static_cast<std::uint8_t>(std::max(_seat, 0));
+        _gameBoard->publish(action);
+    }
+}
+
+// Check whether a pathway can be built, without side effects
+bool Player::canBuildPathway(int pathNum) {
+    CATAN_PROBE_SCOPE(BuildCheck);
+    Pathway *pathway = _gameBoard ? _gameBoard->locatePathway(pathNum) : nullptr;
+    if (!pathway || pathway->isOccupied() || !_resources.covers(ROAD_COST)) {
+        return false;
+    }
+    for (Node *node : {pathway->getNode1(), pathway->getNode2()}) {
+        for (Pathway *adjacentPathway : node->getPathways()) {
+            if (adjacentPathway->isOccupied() && adjacentPathway->getPlayer() == this) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Check whether a settlement can be built, without side effects
+bool Player::canBuildSettlement(int nodeNum) {
+    CATAN_PROBE_SCOPE(BuildCheck);
+    Node *node = _gameBoard ? _gameBoard->locateNode(nodeNum) : nullptr;
+    if (!node || node->isOccupied() || !_resources.covers(SETTLEMENT_COST)) {
+        return false;
+    }
+    for (size_t i = 0; i < 3; ++i) {
+        Node *neighborNode = node->getNeighborNode(i);
+        if (neighborNode != nullptr && neighborNode->isOccupied()) {
+            return false;
+        }
+    }
+    for (int i = 0; i < 3; ++i) {
+        Pathway *pathway = node->getPathwayAt(i);
+        if (pathway != nullptr && pathway->isOccupied() && pathway->getPlayer() == this) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Check whether a settlement can be upgraded to a city, without side effects
+bool Player::canUpgradeToCity(int nodeNum) {
+    CATAN_PROBE_SCOPE(BuildCheck);
+    Node *node = _gameBoard ? _gameBoard->locateNode(nodeNum) : nullptr;
+    return node && !node->getCity() && node->getSettlement() && node->getSettlement()->identifyOwner() == this &&
+           _resources.covers(CITY_COST);
 }
 
@@ -0,0 +1,182 @@
+#include "ProductionBatch.hpp"
+#include "GameBoard.hpp"
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CATAN_HAVE_AVX2_KERNEL 1
+#endif
+
+namespace strategy {
+
+// Prepare a batch of empty boards sharing the layout of a reference board
+    ProductionBatch::ProductionBatch(const GameBoard &layout, std::size_t games, std::size_t seats)
+            : _layout(layout.getProduction()), _games(games),
+              _stride((games + LANES - 1) / LANES * LANES), _seats(seats),
+              _nodeSeats(BoardGraph::MAX_NODES * _stride, 0), _nodeYields(BoardGraph::MAX_NODES * _stride, 0),
+              _robbers(_stride, static_cast<std::uint8_t>(std::max(layout.getRobber(), 0))) {
+        if (seats > ProductionTable::MAX_SEATS) {
+            throw std::invalid_argument("Error: A production batch supports at most 8 players per game.");
+        }
+    }
+
+// Get the number of delta bytes
+    std::size_t ProductionBatch::deltaSize() const {
+        return _seats * RESOURCE_TYPE_COUNT * _stride;
+    }
+
+// Copy the buildings and robber of a board
+    void ProductionBatch::loadGame(std::size_t game, const GameBoard &board) {
+        if (game >= _games) {
+            throw std::out_of_range("Error: No such game in the production batch.");
+        }
+        const ProductionTable &table = board.getProduction();
+        for (std::size_t node = 0; node < BoardGraph::MAX_NODES; ++node) {
+            if (table.nodeSeat(node) >= (int) _seats) {
+                throw std::out_of_range("Error: The board has more players than the production batch.");
+            }
+        }
+        for (std::size_t node = 0; node < BoardGraph::MAX_NODES; ++node) {
+            _nodeSeats[node * _stride + game] = static_cast<std::uint8_t>(table.nodeSeat(node) + 1);
+            _nodeYields[node * _stride + game] = static_cast<std::uint8_t>(table.nodeYield(node));
+        }
+        _robbers[game] = static_cast<std::uint8_t>(std::max(table.getRobber(), 0));
+    }
+
+// Record the building on a node of a game
+    void ProductionBatch::setBuilding(std::size_t game, std::size_t node, int seat, int yield) {
+        if (game >= _games || node >= BoardGraph::MAX_NODES || seat < 0 || seat >= (int) _seats) {
+            throw std::out_of_range("Error: No such game, node or seat in the production batch.");
+        }
+        _nodeSeats[node * _stride + game] = static_cast<std::uint8_t>(seat + 1);
+        _nodeYields[node * _stride + game] = static_cast<std::uint8_t>(yield);
+    }
+
+// Move the robber of a game
+    void ProductionBatch::moveRobber(std::size_t game, int terrain) {
+        if (game >= _games || terrain < 0 || terrain >= (int) _layout.terrainCount()) {
+            throw std::out_of_range("Error: No such game or terrain in the production batch.");
+        }
+        _robbers[game] = static_cast<std::uint8_t>(terrain);
+    }
+
+// One game at a time, one terrain at a time
+    void ProductionBatch::produceScalar(const std::uint8_t *rolls, std::uint8_t *deltas) const {
+        std::memset(deltas, 0, deltaSize());
+        for (std::size_t game = 0; game < _games; ++game) {
+            for (std::size_t t = 0; t < _layout.terrainCount(); ++t) {
+                const ResourceType resource = _layout.resource(t);
+                if (_layout.number(t) != rolls[game] || _robbers[game] == t || resource == ResourceType::None) {
+                    continue;
+                }
+                for (std::uint8_t node : _layout.corners(t)) {
+                    if (node == BoardGraph::MAX_NODES || _nodeSeats[node * _stride + game] == 0) {
+                        continue;
+                    }
+                    const std::size_t seat = _nodeSeats[node * _stride + game] - 1;
+                    const std::size_t row = seat * RESOURCE_TYPE_COUNT + static_cast<std::size_t>(resource);
+                    deltas[row * _stride + game] += _nodeYields[node * _stride + game];
+                }
+            }
+        }
+    }
+
+#ifdef CATAN_HAVE_AVX2_KERNEL
+// 32 games per register: compare the rolls with each number, mask out the robber, add each corner's yield to its owner
+    __attribute__((target("avx2")))
+    void ProductionBatch::produceAvx2(const std::uint8_t *rolls, std::uint8_t *deltas) const {
+        alignas(LANES) std::array<std::uint8_t, LANES> tail{};
+        for (std::size_t base = 0; base < _stride; base += LANES) {
+            const std::uint8_t *blockRolls = rolls + base;
+            if (base + LANES > _games) {
+                tail.fill(0);
+                std::memcpy(tail.data(), rolls + base, _games - base);
+                blockRolls = tail.data();
+            }
+            const __m256i roll = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(blockRolls));
+            const __m256i robber = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_robbers.data() + base));
+
+            __m256i acc[ProductionTable::MAX_SEATS][RESOURCE_TYPE_COUNT];
+            for (std::size_t seat = 0; seat < _seats; ++seat) {
+                for (auto &lane : acc[seat]) {
+                    lane = _mm256_setzero_si256();
+                }
+            }
+
+            for (std::size_t t = 0; t < _layout.terrainCount(); ++t) {
+                const ResourceType resource = _layout.resource(t);
+                if (_layout.number(t) == 0 || resource == ResourceType::None) {
+                    continue;
+                }
+                const __m256i hit = _mm256_andnot_si256(
+                        _mm256_cmpeq_epi8(robber, _mm256_set1_epi8(static_cast<char>(t))),
+                        _mm256_cmpeq_epi8(roll, _mm256_set1_epi8(static_cast<char>(_layout.number(t)))));
+                if (_mm256_testz_si256(hit, hit)) {
+                    continue;
+                }
+                const auto r = static_cast<std::size_t>(resource);
+                for (std::uint8_t node : _layout.corners(t)) {
+                    if (node == BoardGraph::MAX_NODES) {
+                        continue;
+                    }
+                    const std::size_t offset = node * _stride + base;
+                    const __m256i yield = _mm256_and_si256(hit,
+                            _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_nodeYields.data() + offset)));
+                    const __m256i owner = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(_nodeSeats.data() + offset));
+                    for (std::size_t seat = 0; seat < _seats; ++seat) {
+                        const __m256i mine = _mm256_cmpeq_epi8(owner, _mm256_set1_epi8(static_cast<char>(seat + 1)));
+                        acc[seat][r] = _mm256_add_epi8(acc[seat][r], _mm256_and_si256(yield, mine));
+                    }
+                }
+            }
+
+            for (std::size_t seat = 0; seat < _seats; ++seat) {
+                for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+                    auto *out = reinterpret_cast<__m256i *>(deltas + (seat * RESOURCE_TYPE_COUNT + r) * _stride + base);
+                    _mm256_storeu_si256(out, acc[seat][r]);
+                }
+            }
+        }
+    }
+
+// Check the CPU for AVX2
+    bool ProductionBatch::avx2Supported() {
+        return __builtin_cpu_supports("avx2");
+    }
+#else
+// Without x86 intrinsics the AVX2 kernel is the scalar one
+    void ProductionBatch::produceAvx2(const std::uint8_t *rolls, std::uint8_t *deltas) const {
+        produceScalar(rolls, deltas);
+    }
+
+// Never on other architectures
+    bool ProductionBatch::avx2Supported() {
+        return false;
+    }
+#endif
+
+// Run the kernel asked for, if the CPU has it
+    void ProductionBatch::produce(std::span<const std::uint8_t> rolls, std::span<std::uint8_t> deltas, ProductionKernel kernel) const {
+        if (rolls.size() < _games || deltas.size() < deltaSize()) {
+            throw std::invalid_argument("Error: The rolls or deltas are smaller than the production batch.");
+        }
+        if (kernel != ProductionKernel::Scalar && avx2Supported()) {
+            produceAvx2(rolls.data(), deltas.data());
+        } else {
+            produceScalar(rolls.data(), deltas.data());
+        }
+    }
+
+// Read the cards of one player out of the deltas
+    ResourceCounts ProductionBatch::gainsOf(std::span<const std::uint8_t> deltas, std::size_t game, std::size_t seat) const {
+        ResourceCounts gains;
+        for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+            gains[r] = deltas[(seat * RESOURCE_TYPE_COUNT + r) * _stride + game];
+        }
+        return gains;
+    }
+
+} // namespace strategy
@@ -0,0 +1,87 @@
+#include "ProductionTable.hpp"
+#include "Terrain.hpp"
+#include <stdexcept>
+
+namespace strategy {
+
+// Copy the production data of the terrains
+    void ProductionTable::build(const BoardGraph &graph, std::span<Terrain *const> terrains) {
+        if (terrains.size() > LANES) {
+            throw std::logic_error("Error: The board has more terrains than the production table supports.");
+        }
+        _terrainCount = terrains.size();
+        _resources.fill(static_cast<std::uint8_t>(ResourceType::None));
+        _numbers.fill(0);
+        _robbed.fill(0);
+        for (auto &corners : _corners) {
+            corners.fill(NO_NODE);
+        }
+        _nodeSeats.fill(0);
+        _nodeYields.fill(0);
+        _robber = -1;
+
+        for (std::size_t t = 0; t < terrains.size(); ++t) {
+            _resources[t] = static_cast<std::uint8_t>(terrains[t]->getResourceType());
+            _numbers[t] = static_cast<std::uint8_t>(terrains[t]->getTerrainNum());
+            IndexRange corners = graph.terrainNodeIndices(t);
+            for (std::size_t c = 0; c < corners.size(); ++c) {
+                _corners[t][c] = corners[c];
+            }
+            if (_robber < 0 && terrains[t]->getResourceType() == ResourceType::None) {
+                _robber = static_cast<int>(t);
+                _robbed[t] = 1;
+            }
+        }
+    }
+
+// Record the building on a node
+    void ProductionTable::setBuilding(std::size_t node, int seat, int yield) {
+        if (node >= BoardGraph::MAX_NODES || seat < 0 || seat >= (int) MAX_SEATS) {
+            throw std::out_of_range("Error: No such node or seat in the production table.");
+        }
+        _nodeSeats[node] = static_cast<std::uint8_t>(seat + 1);
+        _nodeYields[node] = static_cast<std::uint8_t>(yield);
+    }
+
+// Move the robber to another terrain
+    void ProductionTable::moveRobber(int terrain) {
+        if (terrain < 0 || terrain >= (int) _terrainCount) {
+            throw std::out_of_range("Error: The robber can only be moved to a terrain on the board.");
+        }
+        _robbed.fill(0);
+        _robbed[terrain] = 1;
+        _robber = terrain;
+    }
+
+// Get the terrain holding the robber
+    int ProductionTable::getRobber() const {
+        return _robber;
+    }
+
+// Tally the cards of every seat for a roll, without branching on the board
+    void ProductionTable::produce(int roll, std::span<ResourceCounts> gains) const {
+        // 1 where the terrain produces on this roll; vectorizes to a compare and an and-not
+        alignas(LANES) std::array<std::uint8_t, LANES> hits;
+        const auto token = static_cast<std::uint8_t>(roll);
+        for (std::size_t t = 0; t < LANES; ++t) {
+            hits[t] = static_cast<std::uint8_t>((_numbers[t] == token) & (_robbed[t] ^ 1));
+        }
+
+        // Row 0 collects empty corners and column None collects the desert
+        std::array<std::array<int, RESOURCE_TYPE_COUNT + 1>, MAX_SEATS + 1> tally{};
+        for (std::size_t t = 0; t < _terrainCount; ++t) {
+            const std::size_t resource = _resources[t];
+            const int hit = hits[t];
+            for (std::uint8_t node : _corners[t]) {
+                tally[_nodeSeats[node]][resource] += _nodeYields[node] * hit;
+            }
+        }
+
+        for (std::size_t seat = 0; seat < gains.size() && seat < MAX_SEATS; ++seat) {
+            for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+                gains[seat][r] = tally[seat + 1][r];
+            }
+        }
+    }
+
+} // namespace strategy
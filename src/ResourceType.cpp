@@ -0,0 +1,26 @@
+#include "ResourceType.hpp"
+
+namespace strategy {
+
+// Display names, indexed by ResourceType (None last)
+    static const std::array<std::string, RESOURCE_TYPE_COUNT + 1> RESOURCE_NAMES = {
+            "Brick", "Grain", "Lumber", "Ore", "Wool", "Desert"
+    };
+
+// Get the display name of a resource type
+    const std::string &resourceName(ResourceType type) {
+        return RESOURCE_NAMES[static_cast<std::size_t>(type)];
+    }
+
+// Map a resource or card name to its type
+    ResourceType resourceFromName(const std::string &name) {
+        for (std::size_t i = 0; i < RESOURCE_TYPE_COUNT; ++i) {
+            const std::string &candidate = RESOURCE_NAMES[i];
+            if (name == candidate || name == candidate + "Card") {
+                return static_cast<ResourceType>(i);
+            }
+        }
+        return ResourceType::None;
+    }
+
+} // namespace strategy
@@ -0,0 +1,152 @@
+#include "SpectatorWall.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace strategy {
+
+    namespace {
+
+        const Rgba NOTHING = {0, 0, 0, 0};
+        const Rgba ROBBER = {40, 40, 40};
+
+        // Append a convex polygon as a fan of triangles
+        template<std::size_t N>
+        void appendFan(std::vector<Point> &out, const std::array<Point, N> &corners) {
+            for (std::size_t i = 1; i + 1 < N; ++i) {
+                out.push_back(corners[0]);
+                out.push_back(corners[i]);
+                out.push_back(corners[i + 1]);
+            }
+        }
+
+        // Paint a run of vertices
+        void paint(WallVertex *first, std::size_t count, Rgba color) {
+            for (std::size_t i = 0; i < count; ++i) {
+                first[i].color = color;
+            }
+        }
+
+    } // namespace
+
+// Lay out one tile from the shared layout, then copy it to every tile with its offset
+    SpectatorWall::SpectatorWall(const BoardGraph &graph, std::vector<BoardFeed *> feeds, WallOptions options)
+            : _options(options), _feeds(std::move(feeds)) {
+        if (options.columns == 0 || options.tileWidth <= 0.0f || options.tileHeight <= 0.0f) {
+            throw std::invalid_argument("Error: The spectator wall needs at least one column and tiles with an area.");
+        }
+        const BoardLayout layout(options.tileWidth, options.tileHeight, graph);
+        const float radius = layout.radius();
+        std::vector<Point> shape;
+        shape.reserve(VERTICES_PER_TILE);
+
+        // Unused slots of a smaller board stay degenerate triangles at the corner of the tile
+        auto pad = [&shape](std::size_t end) {
+            shape.resize(end, Point{});
+        };
+        for (std::size_t t = 0; t < std::min(graph.terrainCount(), BoardGraph::MAX_TERRAINS); ++t) {
+            const Point center = layout.hexCenter((int) t);
+            std::array<Point, 8> fan{};
+            fan[0] = center;
+            for (int c = 0; c <= 6; ++c) {
+                fan[c + 1] = BoardLayout::hexCorner(center, radius * 0.94f, c % 6);
+            }
+            for (int c = 1; c <= 6; ++c) {
+                shape.insert(shape.end(), {fan[0], fan[c], fan[c + 1]});
+            }
+        }
+        pad(TERRAIN_VERTICES);
+        for (std::size_t t = 0; t < std::min(graph.terrainCount(), BoardGraph::MAX_TERRAINS); ++t) {
+            const Point center = layout.hexCenter((int) t);
+            const float size = radius * 0.25f;
+            appendFan<4>(shape, {{{center.x, center.y - size}, {center.x + size, center.y},
+                                  {center.x, center.y + size}, {center.x - size, center.y}}});
+        }
+        pad(TERRAIN_VERTICES + ROBBER_VERTICES);
+        for (std::size_t p = 0; p < std::min(graph.pathwayCount(), BoardGraph::MAX_PATHWAYS); ++p) {
+            appendFan(shape, layout.roadShape(p));
+        }
+        pad(TERRAIN_VERTICES + ROBBER_VERTICES + ROAD_VERTICES);
+        for (std::size_t n = 0; n < std::min(graph.nodeCount(), BoardGraph::MAX_NODES); ++n) {
+            appendFan(shape, layout.buildingShape(n, false));
+            appendFan(shape, layout.buildingShape(n, true));
+        }
+        pad(VERTICES_PER_TILE);
+
+        _vertices.resize(_feeds.size() * VERTICES_PER_TILE);
+        for (std::size_t tile = 0; tile < _feeds.size(); ++tile) {
+            const float left = (float) (tile % options.columns) * options.tileWidth;
+            const float top = (float) (tile / options.columns) * options.tileHeight;
+            WallVertex *vertices = _vertices.data() + tile * VERTICES_PER_TILE;
+            for (std::size_t v = 0; v < VERTICES_PER_TILE; ++v) {
+                vertices[v] = {{shape[v].x + left, shape[v].y + top}, NOTHING};
+            }
+        }
+    }
+
+// Get the number of boards
+    std::size_t SpectatorWall::boardCount() const {
+        return _feeds.size();
+    }
+
+// Get the width of the wall
+    float SpectatorWall::width() const {
+        return (float) std::min(_options.columns, std::max<std::size_t>(_feeds.size(), 1)) * _options.tileWidth;
+    }
+
+// Get the height of the wall
+    float SpectatorWall::height() const {
+        const std::size_t rows = std::max<std::size_t>((_feeds.size() + _options.columns - 1) / _options.columns, 1);
+        return (float) rows * _options.tileHeight;
+    }
+
+// Write the colors of a board into its tile
+    void SpectatorWall::recolor(std::size_t tile, const BoardSnapshot &snapshot) {
+        WallVertex *vertices = _vertices.data() + tile * VERTICES_PER_TILE;
+        for (std::size_t t = 0; t < BoardGraph::MAX_TERRAINS; ++t) {
+            paint(vertices + t * 18, 18, resourceColor(static_cast<ResourceType>(snapshot.resources[t])));
+        }
+        vertices += TERRAIN_VERTICES;
+        for (std::size_t t = 0; t < BoardGraph::MAX_TERRAINS; ++t) {
+            paint(vertices + t * 6, 6, (int) t == snapshot.robber ? ROBBER : NOTHING);
+        }
+        vertices += ROBBER_VERTICES;
+        for (std::size_t p = 0; p < BoardGraph::MAX_PATHWAYS; ++p) {
+            const int seat = snapshot.roadSeat(p);
+            paint(vertices + p * 6, 6, seat >= 0 ? playerColor(seat) : NOTHING);
+        }
+        vertices += ROAD_VERTICES;
+        for (std::size_t n = 0; n < BoardGraph::MAX_NODES; ++n) {
+            const int seat = snapshot.buildingSeat(n);
+            const bool city = snapshot.isCity(n);
+            paint(vertices + n * 18, 9, seat >= 0 && !city ? playerColor(seat) : NOTHING);
+            paint(vertices + n * 18 + 9, 9, seat >= 0 && city ? playerColor(seat) : NOTHING);
+        }
+    }
+
+// Recolor the tiles of the boards that published a change
+    const std::vector<std::size_t> &SpectatorWall::refresh() {
+        _changed.clear();
+        for (std::size_t tile = 0; tile < _feeds.size(); ++tile) {
+            if (_feeds[tile]->poll()) {
+                recolor(tile, _feeds[tile]->latest());
+                _changed.push_back(tile);
+            }
+        }
+        return _changed;
+    }
+
+// Get all the triangles
+    std::span<const WallVertex> SpectatorWall::vertices() const {
+        return _vertices;
+    }
+
+// Get the triangles of a tile
+    std::span<const WallVertex> SpectatorWall::tile(std::size_t index) const {
+        if (index >= _feeds.size()) {
+            throw std::out_of_range("Error: Tile " + std::to_string(index) + " is not on the wall.");
+        }
+        return std::span<const WallVertex>(_vertices).subspan(index * VERTICES_PER_TILE, VERTICES_PER_TILE);
+    }
+
+} // namespace strategy
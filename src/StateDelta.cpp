@@ -0,0 +1,418 @@
+#include "StateDelta.hpp"
+#include "Player.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace strategy {
+
+    namespace {
+
+        constexpr unsigned ROBBER_BITS = std::bit_width(BoardGraph::MAX_TERRAINS);            // Robber + 1, 0 for none
+        constexpr unsigned NODE_COUNT_BITS = std::bit_width(BoardGraph::MAX_NODES);
+        constexpr unsigned NODE_BITS = std::bit_width(BoardGraph::MAX_NODES - 1);
+        constexpr unsigned PATHWAY_COUNT_BITS = std::bit_width(BoardGraph::MAX_PATHWAYS);
+        constexpr unsigned PATHWAY_BITS = std::bit_width(BoardGraph::MAX_PATHWAYS - 1);
+        constexpr unsigned OWNER_BITS = std::bit_width(GameState::MAX_SEATS);                  // Seat + 1, 0 for none
+        constexpr unsigned GROUP_BITS = 3;                                                     // Payload of a varbits group
+        constexpr unsigned MAX_GROUPS = (64 + GROUP_BITS - 1) / GROUP_BITS;
+        constexpr std::int64_t MAX_CHANGE = std::int64_t{1} << 33;                            // Beyond any change between two ints
+
+        static_assert(GameState::MAX_SEATS <= 8, "The seat mask of a record is one byte.");
+
+        // Longest record: every node, pathway and count changed, every change in its longest form
+        constexpr std::size_t MAX_RECORD_BITS = 1 + ROBBER_BITS
+                + NODE_COUNT_BITS + BoardGraph::MAX_NODES * (NODE_BITS + OWNER_BITS + 1)
+                + PATHWAY_COUNT_BITS + BoardGraph::MAX_PATHWAYS * (PATHWAY_BITS + OWNER_BITS)
+                + GameState::MAX_SEATS * (1 + RESOURCE_TYPE_COUNT + game::DEV_CARD_TYPE_COUNT
+                                          + (RESOURCE_TYPE_COUNT + game::DEV_CARD_TYPE_COUNT) * MAX_GROUPS * (GROUP_BITS + 1));
+        constexpr std::size_t MAX_RECORD_BYTES = (MAX_RECORD_BITS + 7) / 8 + 4;
+
+        // Packs fields LSB first into a record on the stack, flushing 32 bits at a time
+        class BitWriter {
+        private:
+            std::array<std::uint8_t, MAX_RECORD_BYTES> _record;
+            std::size_t _size = 0;
+            std::uint64_t _pending = 0;
+            unsigned _bits = 0;
+
+        public:
+            void put(std::uint64_t value, unsigned width) {
+                _pending |= value << _bits;
+                _bits += width;
+                if (_bits >= 32) {
+                    for (unsigned b = 0; b < 4; ++b) {
+                        _record[_size++] = static_cast<std::uint8_t>(_pending >> (8 * b));
+                    }
+                    _pending >>= 32;
+                    _bits -= 32;
+                }
+            }
+
+            // Zigzag the change, then write it 3 bits at a time, each group followed by a continuation bit
+            void putSigned(std::int64_t change) {
+                std::uint64_t value = (static_cast<std::uint64_t>(change) << 1) ^ static_cast<std::uint64_t>(change >> 63);
+                while (value >> GROUP_BITS) {
+                    put((value & ((1u << GROUP_BITS) - 1)) | (1u << GROUP_BITS), GROUP_BITS + 1);
+                    value >>= GROUP_BITS;
+                }
+                put(value, GROUP_BITS + 1);
+            }
+
+            // Pad to a whole byte and append the record
+            std::size_t finish(std::vector<std::uint8_t> &out) {
+                for (; _bits > 0; _bits = _bits > 8 ? _bits - 8 : 0) {
+                    _record[_size++] = static_cast<std::uint8_t>(_pending);
+                    _pending >>= 8;
+                }
+                out.insert(out.end(), _record.begin(), _record.begin() + (std::ptrdiff_t) _size);
+                return _size;
+            }
+        };
+
+        // Reads fields written by BitWriter, refilling a word at a time where the input allows
+        class BitReader {
+        private:
+            const std::uint8_t *_pos;
+            const std::uint8_t *_end;
+            std::uint64_t _pending = 0;
+            unsigned _bits = 0;
+
+            void refill() {
+                if (_end - _pos >= 8) {
+                    std::uint64_t word = 0;
+                    for (unsigned b = 0; b < 8; ++b) {
+                        word |= static_cast<std::uint64_t>(_pos[b]) << (8 * b);
+                    }
+                    const unsigned bytes = (63 - _bits) / 8;
+                    _pending |= word << _bits;
+                    _pending &= (std::uint64_t{1} << (_bits + 8 * bytes)) - 1;
+                    _pos += bytes;
+                    _bits += 8 * bytes;
+                } else {
+                    while (_bits <= 56 && _pos < _end) {
+                        _pending |= static_cast<std::uint64_t>(*_pos++) << _bits;
+                        _bits += 8;
+                    }
+                }
+            }
+
+        public:
+            bool ok = true;
+
+            BitReader(const std::uint8_t *pos, const std::uint8_t *end) : _pos(pos), _end(end) {}
+
+            std::uint64_t take(unsigned width) {
+                if (_bits < width) {
+                    refill();
+                    if (_bits < width) {
+                        ok = false;
+                        return 0;
+                    }
+                }
+                const std::uint64_t value = _pending & ((std::uint64_t{1} << width) - 1);
+                _pending >>= width;
+                _bits -= width;
+                return value;
+            }
+
+            std::int64_t takeSigned() {
+                std::uint64_t value = 0;
+                for (unsigned group = 0; group < MAX_GROUPS && ok; ++group) {
+                    const std::uint64_t bits = take(GROUP_BITS + 1);
+                    value |= (bits & ((1u << GROUP_BITS) - 1)) << (group * GROUP_BITS);
+                    if (!(bits >> GROUP_BITS)) {
+                        return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+                    }
+                }
+                ok = false;
+                return 0;
+            }
+
+            // Give back the whole bytes read ahead; the padding left of the last byte must be zero
+            bool finish(const std::uint8_t *&pos) {
+                if (!ok || (_pending & ((std::uint64_t{1} << (_bits % 8)) - 1)) != 0) {
+                    return false;
+                }
+                pos = _pos - _bits / 8;
+                return true;
+            }
+        };
+
+        // Old values of what a record overwrote, to put back if the record turns out bad
+        template<typename T, std::size_t N>
+        struct UndoLog {
+            struct Entry {
+                T *target;
+                T value;
+            };
+            std::array<Entry, N> entries; // Left uninitialized, only the first size entries are used
+            std::size_t size = 0;
+
+            void set(T &target, T value) {
+                entries[size++] = {&target, target};
+                target = value;
+            }
+
+            void rollBack() {
+                while (size > 0) {
+                    --size;
+                    *entries[size].target = entries[size].value;
+                }
+            }
+        };
+
+        // Add the indices of the bytes that differ between two words, first to last
+        inline void changedBytes(std::uint64_t diff, std::size_t first, std::uint8_t *changed, std::size_t &count) {
+            while (diff != 0) {
+                const unsigned byte = static_cast<unsigned>(std::countr_zero(diff)) / 8;
+                changed[count++] = static_cast<std::uint8_t>(first + byte);
+                diff &= ~(std::uint64_t{0xFF} << (byte * 8));
+            }
+        }
+
+        // Collect the indices where two byte tables differ, comparing 8 entries at a time
+        template<std::size_t N>
+        std::size_t changedEntries(const std::array<std::uint8_t, N> &before, const std::array<std::uint8_t, N> &after,
+                                   std::array<std::uint8_t, N> &changed) {
+            constexpr std::size_t WORDS = N / 8;
+            constexpr std::size_t TAIL = N % 8;
+            std::size_t count = 0;
+            for (std::size_t w = 0; w < WORDS; ++w) {
+                std::uint64_t a, b;
+                std::memcpy(&a, before.data() + 8 * w, 8);
+                std::memcpy(&b, after.data() + 8 * w, 8);
+                changedBytes(a ^ b, 8 * w, changed.data(), count);
+            }
+            if constexpr (TAIL > 0) {
+                std::uint64_t diff = 0;
+                for (std::size_t i = 0; i < TAIL; ++i) {
+                    diff |= static_cast<std::uint64_t>(before[8 * WORDS + i] ^ after[8 * WORDS + i]) << (8 * i);
+                }
+                changedBytes(diff, 8 * WORDS, changed.data(), count);
+            }
+            return count;
+        }
+
+    } // namespace
+
+// Copy the pieces of the board and the cards of every seat
+    void captureState(BoardView board, std::span<game::Player *const> players, GameState &state) {
+        captureSnapshot(board, state.board);
+        state.hands.fill(ResourceCounts{});
+        for (auto &cards : state.devCards) {
+            cards.fill(0);
+        }
+        for (std::size_t seat = 0; seat < players.size() && seat < GameState::MAX_SEATS; ++seat) {
+            if (!players[seat]) {
+                continue;
+            }
+            state.hands[seat] = players[seat]->getResources();
+            for (std::size_t type = 0; type < game::DEV_CARD_TYPE_COUNT; ++type) {
+                state.devCards[seat][type] = static_cast<std::uint8_t>(players[seat]->countDevelopmentCards(static_cast<game::DevCardType>(type)));
+            }
+        }
+    }
+
+// Write the robber, changed buildings and roads, then the card changes of each seat
+    std::size_t encodeDelta(const GameState &before, const GameState &after, std::vector<std::uint8_t> &out) {
+        BitWriter writer;
+
+        const bool robberMoved = before.board.robber != after.board.robber;
+        writer.put(robberMoved, 1);
+        if (robberMoved) {
+            writer.put(static_cast<std::uint64_t>(after.board.robber + 1), ROBBER_BITS);
+        }
+
+        std::array<std::uint8_t, BoardGraph::MAX_NODES> nodes{};
+        const std::size_t nodeCount = changedEntries(before.board.buildings, after.board.buildings, nodes);
+        writer.put(nodeCount, NODE_COUNT_BITS);
+        for (std::size_t i = 0; i < nodeCount; ++i) {
+            const std::uint8_t building = after.board.buildings[nodes[i]];
+            writer.put(nodes[i], NODE_BITS);
+            writer.put(building & ~BoardSnapshot::CITY, OWNER_BITS);
+            writer.put((building & BoardSnapshot::CITY) != 0, 1);
+        }
+
+        std::array<std::uint8_t, BoardGraph::MAX_PATHWAYS> pathways{};
+        const std::size_t pathwayCount = changedEntries(before.board.roads, after.board.roads, pathways);
+        writer.put(pathwayCount, PATHWAY_COUNT_BITS);
+        for (std::size_t i = 0; i < pathwayCount; ++i) {
+            writer.put(pathways[i], PATHWAY_BITS);
+            writer.put(after.board.roads[pathways[i]], OWNER_BITS);
+        }
+
+        // Masks of the changed counts of every seat; most actions change the cards of one seat at most
+        std::array<std::uint32_t, GameState::MAX_SEATS> resourceMasks{}, cardMasks{};
+        std::uint32_t seats = 0;
+        for (std::size_t seat = 0; seat < GameState::MAX_SEATS; ++seat) {
+            if (std::memcmp(&before.hands[seat], &after.hands[seat], sizeof(ResourceCounts)) == 0
+                && std::memcmp(&before.devCards[seat], &after.devCards[seat], game::DEV_CARD_TYPE_COUNT) == 0) {
+                continue;
+            }
+            for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+                resourceMasks[seat] |= static_cast<std::uint32_t>(before.hands[seat][r] != after.hands[seat][r]) << r;
+            }
+            for (std::size_t type = 0; type < game::DEV_CARD_TYPE_COUNT; ++type) {
+                cardMasks[seat] |= static_cast<std::uint32_t>(before.devCards[seat][type] != after.devCards[seat][type]) << type;
+            }
+            seats |= static_cast<std::uint32_t>((resourceMasks[seat] | cardMasks[seat]) != 0) << seat;
+        }
+        writer.put(seats, GameState::MAX_SEATS);
+        for (std::size_t seat = 0; seat < GameState::MAX_SEATS; ++seat) {
+            if (!(seats >> seat & 1)) {
+                continue;
+            }
+            const std::uint32_t resources = resourceMasks[seat], cards = cardMasks[seat];
+            writer.put(resources, RESOURCE_TYPE_COUNT);
+            for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+                if (resources >> r & 1) {
+                    writer.putSigned(static_cast<std::int64_t>(after.hands[seat][r]) - before.hands[seat][r]);
+                }
+            }
+            writer.put(cards, game::DEV_CARD_TYPE_COUNT);
+            for (std::size_t type = 0; type < game::DEV_CARD_TYPE_COUNT; ++type) {
+                if (cards >> type & 1) {
+                    writer.putSigned(static_cast<std::int64_t>(after.devCards[seat][type]) - before.devCards[seat][type]);
+                }
+            }
+        }
+        return writer.finish(out);
+    }
+
+// Apply in place, logging what is overwritten so that a bad record leaves the state as it was
+    bool applyDelta(const std::uint8_t *&pos, const std::uint8_t *end, GameState &state) {
+        BitReader reader(pos, end);
+        UndoLog<std::uint8_t, BoardGraph::MAX_NODES + BoardGraph::MAX_PATHWAYS + GameState::MAX_SEATS * game::DEV_CARD_TYPE_COUNT> bytes;
+        UndoLog<int, GameState::MAX_SEATS * RESOURCE_TYPE_COUNT> counts;
+        const std::int8_t robber = state.board.robber;
+        auto fail = [&]() {
+            bytes.rollBack();
+            counts.rollBack();
+            state.board.robber = robber;
+            return false;
+        };
+
+        if (reader.take(1)) {
+            const auto terrain = reader.take(ROBBER_BITS);
+            if (terrain > BoardGraph::MAX_TERRAINS) {
+                return fail();
+            }
+            state.board.robber = static_cast<std::int8_t>(static_cast<int>(terrain) - 1);
+        }
+
+        const auto nodeCount = reader.take(NODE_COUNT_BITS);
+        if (nodeCount > BoardGraph::MAX_NODES) {
+            return fail();
+        }
+        for (std::uint64_t i = 0; i < nodeCount && reader.ok; ++i) {
+            const auto node = reader.take(NODE_BITS);
+            const auto owner = reader.take(OWNER_BITS);
+            const auto city = reader.take(1);
+            if (node >= BoardGraph::MAX_NODES || owner > GameState::MAX_SEATS || (city && owner == 0)) {
+                return fail();
+            }
+            bytes.set(state.board.buildings[node], static_cast<std::uint8_t>(owner | (city ? BoardSnapshot::CITY : 0)));
+        }
+
+        const auto pathwayCount = reader.take(PATHWAY_COUNT_BITS);
+        if (pathwayCount > BoardGraph::MAX_PATHWAYS) {
+            return fail();
+        }
+        for (std::uint64_t i = 0; i < pathwayCount && reader.ok; ++i) {
+            const auto pathway = reader.take(PATHWAY_BITS);
+            const auto owner = reader.take(OWNER_BITS);
+            if (pathway >= BoardGraph::MAX_PATHWAYS || owner > GameState::MAX_SEATS) {
+                return fail();
+            }
+            bytes.set(state.board.roads[pathway], static_cast<std::uint8_t>(owner));
+        }
+
+        const auto seats = reader.take(GameState::MAX_SEATS);
+        for (std::size_t seat = 0; seat < GameState::MAX_SEATS && reader.ok; ++seat) {
+            if (!(seats >> seat & 1)) {
+                continue;
+            }
+            const auto resources = reader.take(RESOURCE_TYPE_COUNT);
+            for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT && reader.ok; ++r) {
+                if (resources >> r & 1) {
+                    const std::int64_t count = state.hands[seat][r] + std::clamp(reader.takeSigned(), -MAX_CHANGE, MAX_CHANGE);
+                    if (count < std::numeric_limits<int>::min() || count > std::numeric_limits<int>::max()) {
+                        return fail();
+                    }
+                    counts.set(state.hands[seat][r], static_cast<int>(count));
+                }
+            }
+            const auto cards = reader.take(game::DEV_CARD_TYPE_COUNT);
+            for (std::size_t type = 0; type < game::DEV_CARD_TYPE_COUNT && reader.ok; ++type) {
+                if (cards >> type & 1) {
+                    const std::int64_t count = state.devCards[seat][type] + std::clamp(reader.takeSigned(), -MAX_CHANGE, MAX_CHANGE);
+                    if (count < 0 || count > std::numeric_limits<std::uint8_t>::max()) {
+                        return fail();
+                    }
+                    bytes.set(state.devCards[seat][type], static_cast<std::uint8_t>(count));
+                }
+            }
+        }
+
+        if (!reader.finish(pos)) {
+            return fail();
+        }
+        return true;
+    }
+
+// DeltaStream Implementation
+
+// Capture the board, then follow it
+    DeltaStream::DeltaStream(GameBoard &board) : _board(board) {
+        append();
+        _bytes.clear();
+        _initial = _state;
+        board.addObserver(this);
+    }
+
+    DeltaStream::~DeltaStream() {
+        _board.removeObserver(this);
+    }
+
+// Capture the board and its registered players and encode what changed
+    std::size_t DeltaStream::append() {
+        std::array<game::Player *, GameState::MAX_SEATS> players{};
+        const auto seats = std::min<std::size_t>(static_cast<std::size_t>(_board.getPlayerCount()), players.size());
+        for (std::size_t seat = 0; seat < seats; ++seat) {
+            players[seat] = _board.getPlayer(static_cast<int>(seat));
+        }
+        captureState(BoardView(_board), players, _next);
+        const std::size_t length = encodeDelta(_state, _next, _bytes);
+        std::swap(_state, _next);
+        return length;
+    }
+
+// Every action gets its record
+    void DeltaStream::onAction(const GameAction &) {
+        append();
+    }
+
+// Get the state the stream started from
+    const GameState &DeltaStream::initial() const {
+        return _initial;
+    }
+
+// Get the state after the last record
+    const GameState &DeltaStream::state() const {
+        return _state;
+    }
+
+// Get the records appended so far
+    std::span<const std::uint8_t> DeltaStream::bytes() const {
+        return _bytes;
+    }
+
+// Drop the records appended so far
+    void DeltaStream::clear() {
+        _bytes.clear();
+    }
+
+} // namespace strategy
@@ -1,23 +1,30 @@
 #include "Terrain.hpp"
+#include <stdexcept>
 using namespace std;
 using namespace strategy;
 
 // Constructor for Terrain, initializes the terrain with a resource type and unique ID
 Terrain::Terrain(const string& r, int id, const vector<game::City>& cities, const vector<Pathway>& pathways, const vector<game::Settelment>& settlements)
-        : _resource(r), _id(id), _card(nullptr) {
+        : _resource(r), _type(resourceFromName(r)), _id(id) {
     // Initialize the resource card based on the resource type
-    if (r == "forest") {
-        this->_card = new LumberCard();
-    } else if (r == "pasture") {
-        this->_card = new WoolCard();
-    } else if (r == "hill") {
-        this->_card = new BrickCard();
-    } else if (r == "mountain") {
-        this->_card = new OreCard();
-    } else if (r == "field") {
-        this->_card = new GrainCard();
-    } else { // desert or unknown
-        this->_card = nullptr;
+    switch (this->_type) {
+        case ResourceType::Lumber:
+            this->_card = new LumberCard();
+            break;
+        case ResourceType::Wool:
+            this->_card = new WoolCard();
+            break;
+        case ResourceType::Brick:
+            this->_card = new BrickCard();
+            break;
+        case ResourceType::Ore:
+            this->_card = new OreCard();
+            break;
+        case ResourceType::Grain:
+            this->_card = new GrainCard();
+            break;
+        default: // desert or unknown
+            this->_card = nullptr;
     }
 }
 
@@ -30,10 +37,15 @@ Terrain::~Terrain() {
 }
 
 // Method to get the resource name
-string Terrain::getResourceName() {
+const string &Terrain::getResourceName() const {
     return this->_resource;
 }
 
+// Method to get the resource type
+ResourceType Terrain::getResourceType() const {
+    return this->_type;
+}
+
 // Method to display terrain information
 void Terrain::displayTerrain() {
     cout << "Terrain ID: " << this->_id << ", Terrain resource: " << this->_resource << endl;
@@ -41,12 +53,26 @@ void Terrain::displayTerrain() {
 
 // Method to set nodes associated with the terrain
 void Terrain::setNodes(vector<Node *> nodes) {
+    if (this->_graph) {
+        throw std::logic_error("Error: The board graph is already built.");
+    }
     this->_nodes = std::move(nodes);
 }
 
 // Method to get nodes associated with the terrain
-vector<Node *> Terrain::getNodes() {
-    return this->_nodes;
+GraphRange<Node> Terrain::getNodes() const {
+    if (this->_graph) {
+        return this->_graph->terrainNodes(this->_index);
+    }
+    const std::uint8_t *first = BoardGraph::IDENTITY.data();
+    return {IndexRange(first, first + this->_nodes.size()), this->_nodes.data()};
+}
+
+// Method to switch to the board graph and release the nodes set during setup
+void Terrain::attachGraph(const BoardGraph *graph, std::uint8_t index) {
+    this->_graph = graph;
+    this->_index = index;
+    vector<Node *>().swap(this->_nodes);
 }
 
 // Method to get terrain ID
@@ -54,28 +80,8 @@ int Terrain::getId() const {
     return this->_id;
 }
 
-// Method to get a resource card, creating it if necessary
-ResourceCard* Terrain::getCard() {
-    if (this->_card != nullptr) {
-        return this->_card;
-    }
-
-    string resource = this->getResourceName();
-
-    if (resource == "Lumber") {
-        this->_card = new LumberCard();
-    } else if (resource == "Wool") {
-        this->_card = new WoolCard();
-    } else if (resource == "Brick") {
-        this->_card = new BrickCard();
-    } else if (resource == "Ore") {
-        this->_card = new OreCard();
-    } else if (resource == "Grain") {
-        this->_card = new GrainCard();
-    } else { // desert or unknown
-        this->_card = nullptr;
-    }
-
+// Method to get the resource card, created with the terrain
+ResourceCard* Terrain::getCard() const {
     return this->_card;
 }
 
@@ -86,5 +92,8 @@ int Terrain::getTerrainNum() const {
 
 // Method to set the terrain number
 void Terrain::setTerrainNum(int n) {
+    if (this->_graph) {
+        throw std::logic_error("Error: The board graph is already built.");
+    }
     this->_terrainNum = n;
 }
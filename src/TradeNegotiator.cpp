@@ -0,0 +1,178 @@
+#include "TradeNegotiator.hpp"
+#include "Player.hpp"
+#include <algorithm>
+#include <limits>
+
+using namespace strategy;
+
+namespace game {
+
+// OfferBatch Implementation
+
+// Append an offer to the batch
+    void OfferBatch::add(const TradeOffer &offer) {
+        for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+            _give[r].push_back(static_cast<std::int16_t>(offer.give[r]));
+            _receive[r].push_back(static_cast<std::int16_t>(offer.receive[r]));
+        }
+        _size++;
+    }
+
+// Remove all offers, keeping the storage
+    void OfferBatch::clear() {
+        for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+            _give[r].clear();
+            _receive[r].clear();
+        }
+        _size = 0;
+    }
+
+// Get the offer at the given position
+    TradeOffer OfferBatch::at(std::size_t index) const {
+        TradeOffer offer;
+        for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+            offer.give[r] = _give[r][index];
+            offer.receive[r] = _receive[r][index];
+        }
+        return offer;
+    }
+
+// Get the number of offers
+    std::size_t OfferBatch::size() const {
+        return _size;
+    }
+
+// Score all offers in one pass per resource; the inner loops are branch-free so they vectorize
+    void OfferBatch::score(const ResourceCounts &hand, const ResourceWeights &weights, std::vector<float> &scores) const {
+        scores.assign(_size, 0.0f);
+        float *out = scores.data();
+        const float unaffordable = -std::numeric_limits<float>::infinity();
+
+        for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+            const std::int16_t *give = _give[r].data();
+            const std::int16_t *receive = _receive[r].data();
+            const float weight = weights[r];
+            for (std::size_t i = 0; i < _size; ++i) {
+                out[i] += weight * static_cast<float>(receive[i] - give[i]);
+            }
+        }
+        for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+            const std::int16_t *give = _give[r].data();
+            const int held = hand[r];
+            for (std::size_t i = 0; i < _size; ++i) {
+                out[i] = give[i] > held ? unaffordable : out[i];
+            }
+        }
+    }
+
+// TradePolicy Implementation
+
+    TradePolicy::~TradePolicy() = default;
+
+// ValueTradePolicy Implementation
+
+    TradeResponse ValueTradePolicy::respond(const Player &responder, const Player &proposer, const TradeOffer &offer) {
+        TradeResponse response;
+        const ResourceCounts &hand = responder.getResources();
+        if (!hand.covers(offer.receive)) {
+            return response;
+        }
+
+        // The responder gives what the proposer receives, and the other way around
+        ResourceWeights weights = TradeNegotiator::resourceWeights(hand);
+        float value = 0.0f;
+        float bestWeight = 0.0f;
+        std::size_t wanted = RESOURCE_TYPE_COUNT;
+        for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+            value += weights[r] * static_cast<float>(offer.give[r] - offer.receive[r]);
+            bool available = proposer.getResources()[r] > offer.give[r] && offer.receive[r] == 0;
+            if (available && weights[r] > bestWeight) {
+                bestWeight = weights[r];
+                wanted = r;
+            }
+        }
+
+        if (value > 0.0f) {
+            response.reply = TradeReply::Accept;
+        } else if (wanted != RESOURCE_TYPE_COUNT && value + bestWeight > 0.0f) {
+            response.reply = TradeReply::Counter;
+            response.counter = offer;
+            response.counter.give[wanted]++;
+        }
+        return response;
+    }
+
+// TradeNegotiator Implementation
+
+// The value of a card decreases with the number already held
+    ResourceWeights TradeNegotiator::resourceWeights(const ResourceCounts &hand) {
+        ResourceWeights weights{};
+        for (std::size_t r = 0; r < RESOURCE_TYPE_COUNT; ++r) {
+            weights[r] = 1.0f / static_cast<float>(1 + hand[r]);
+        }
+        return weights;
+    }
+
+// Post an offer to all other participants and execute the best answer
+    TradeResult TradeNegotiator::negotiate(Player &proposer, const TradeOffer &offer) {
+        TradeResult result;
+        if (!proposer.getResources().covers(offer.give)) {
+            return result;
+        }
+
+        OfferBatch counters;
+        std::vector<Player *> counterPartners;
+        for (Player *participant : proposer.getOtherParticipants()) {
+            TradePolicy *policy = participant->getTradePolicy();
+            if (!policy) {
+                continue;
+            }
+
+            TradeResponse response = policy->respond(*participant, proposer, offer);
+            if (response.reply == TradeReply::Accept && proposer.exchangeResources(participant, offer.give, offer.receive)) {
+                result.completed = true;
+                result.partner = participant;
+                result.executed = offer;
+                return result;
+            }
+            if (response.reply == TradeReply::Counter) {
+                counters.add(response.counter);
+                counterPartners.push_back(participant);
+            }
+        }
+
+        if (counters.size() == 0) {
+            return result;
+        }
+
+        // Accept the best counter-offer that is no worse than the original offer by more than one least valued card
+        ResourceWeights weights = resourceWeights(proposer.getResources());
+        OfferBatch original;
+        original.add(offer);
+        std::vector<float> scores;
+        original.score(proposer.getResources(), weights, scores);
+        float threshold = scores[0] - *std::min_element(weights.begin(), weights.end());
+
+        counters.score(proposer.getResources(), weights, scores);
+        std::vector<std::size_t> order(counters.size());
+        for (std::size_t i = 0; i < order.size(); ++i) {
+            order[i] = i;
+        }
+        std::sort(order.begin(), order.end(), [&scores](std::size_t a, std::size_t b) { return scores[a] > scores[b]; });
+
+        for (std::size_t i : order) {
+            if (scores[i] < threshold) {
+                break;
+            }
+            TradeOffer counter = counters.at(i);
+            if (proposer.exchangeResources(counterPartners[i], counter.give, counter.receive)) {
+                result.completed = true;
+                result.partner = counterPartners[i];
+                result.executed = counter;
+                return result;
+            }
+        }
+        return result;
+    }
+
+} // namespace game
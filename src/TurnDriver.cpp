@@ -0,0 +1,206 @@
+#include "TurnDriver.hpp"
+#include "Node.hpp"
+#include "Player.hpp"
+#include <stdexcept>
+#include <utility>
+
+using namespace game;
+
+namespace strategy {
+
+// Upgrade, settle, extend the road network, trade for a missing resource, then buy or play a card
+    Move greedyMove(BoardView board, Player &player) {
+        for (const Node *node : board.nodes()) {
+            if (player.canUpgradeToCity(node->getId())) {
+                return Move{MoveType::UpgradeToCity, node->getId()};
+            }
+        }
+        for (const Node *node : board.nodes()) {
+            if (player.canBuildSettlement(node->getId())) {
+                return Move{MoveType::BuildSettlement, node->getId()};
+            }
+        }
+        int roads = 0;
+        for (const Pathway *pathway : board.pathways()) {
+            roads += pathway->isOccupied() && pathway->getPlayer() == &player;
+        }
+        if (roads < GreedyAgent::MAX_PATHWAYS) {
+            for (const Pathway *pathway : board.pathways()) {
+                if (player.canBuildPathway(pathway->getId())) {
+                    return Move{MoveType::BuildPathway, pathway->getId()};
+                }
+            }
+        }
+
+        const ResourceCounts &hand = player.getResources();
+        std::size_t most = 0, least = 0;
+        for (std::size_t r = 1; r < RESOURCE_TYPE_COUNT; ++r) {
+            if (hand[r] > hand[most]) most = r;
+            if (hand[r] < hand[least]) least = r;
+        }
+        if (hand[least] == 0 &&
+            player.canTradeWithBank(static_cast<ResourceType>(most), static_cast<ResourceType>(least))) {
+            return Move{MoveType::TradeWithBank, static_cast<int>(most), static_cast<int>(least)};
+        }
+
+        if (hand.covers(Player::DEVELOPMENT_CARD_COST) && board.deckCards() > 0) {
+            return Move{MoveType::BuyDevelopmentCard};
+        }
+        for (std::size_t type = 0; type < DEV_CARD_TYPE_COUNT; ++type) {
+            if (player.findDevelopmentCard(static_cast<DevCardType>(type))) {
+                return Move{MoveType::PlayDevelopmentCard, static_cast<int>(type)};
+            }
+        }
+        return Move{MoveType::EndTurn};
+    }
+
+// Check the move against the player's hand and the board before making it
+    bool applyMove(Player &player, Move move) {
+        const auto isResource = [](int r) { return r >= 0 && r < static_cast<int>(RESOURCE_TYPE_COUNT); };
+        switch (move.type) {
+            case MoveType::BuildPathway:
+                if (!player.canBuildPathway(move.id)) return false;
+                player.buildPathway(move.id);
+                return true;
+            case MoveType::BuildSettlement:
+                if (!player.canBuildSettlement(move.id)) return false;
+                player.buildSettlement(move.id);
+                return true;
+            case MoveType::UpgradeToCity:
+                if (!player.canUpgradeToCity(move.id)) return false;
+                player.upgradeToCity(move.id);
+                return true;
+            case MoveType::BuyDevelopmentCard: {
+                const int before = player.getResources().total();
+                player.acquireDevelopmentCard();
+                return player.getResources().total() != before;
+            }
+            case MoveType::TradeWithBank:
+                return isResource(move.id) && isResource(move.target) &&
+                       player.tradeWithBank(static_cast<ResourceType>(move.id), static_cast<ResourceType>(move.target));
+            case MoveType::PlayDevelopmentCard: {
+                if (move.id < 0 || move.id >= static_cast<int>(DEV_CARD_TYPE_COUNT)) return false;
+                DevelopmentCard *card = player.findDevelopmentCard(static_cast<DevCardType>(move.id));
+                if (!card) return false;
+                player.activateDevelopmentCard(card);
+                return true;
+            }
+            default:
+                return false;
+        }
+    }
+
+// PlayerAgent Implementation
+
+    PlayerAgent::~PlayerAgent() = default;
+
+// Check whether a game waits for this agent
+    bool PlayerAgent::waiting() const {
+        return static_cast<bool>(_waiting);
+    }
+
+// Resume the waiting game with the move; it runs on this thread until it waits again or ends
+    void PlayerAgent::deliver(Move move) {
+        if (!_waiting) {
+            throw std::logic_error("Error: No game is waiting for a move from this player.");
+        }
+        _delivered = move;
+        std::exchange(_waiting, {}).resume();
+    }
+
+// MoveRequest Implementation
+
+    MoveRequest::MoveRequest(PlayerAgent &asked, Player &onTurn, int turnNumber)
+            : agent(asked), player(onTurn), turn(turnNumber) {}
+
+// Forget a game destroyed while it waited
+    MoveRequest::~MoveRequest() {
+        if (suspended && agent._waiting == suspended) {
+            agent._waiting = {};
+        }
+    }
+
+// Ask the agent; a decision made at once does not suspend the game
+    bool MoveRequest::await_ready() {
+        move = agent.decide(player, turn);
+        return move.has_value();
+    }
+
+// Park the game on the agent until deliver()
+    void MoveRequest::await_suspend(std::coroutine_handle<> game) {
+        suspended = game;
+        agent._waiting = game;
+    }
+
+// Take the move decided at once or delivered later
+    Move MoveRequest::await_resume() {
+        if (!move) {
+            move = agent._delivered;
+            agent._delivered.reset();
+            suspended = {};
+        }
+        return *move;
+    }
+
+// GreedyAgent Implementation
+
+    GreedyAgent::GreedyAgent(BoardView board) : _board(board) {}
+
+// Decide at once with the shared greedy chooser
+    std::optional<Move> GreedyAgent::decide(Player &player, int) {
+        return greedyMove(_board, player);
+    }
+
+// GameTask Implementation
+
+    GameTask GameTask::promise_type::get_return_object() {
+        return GameTask(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    void GameTask::promise_type::return_value(SimulationResult value) {
+        result = value;
+    }
+
+// Keep what the game threw for result()
+    void GameTask::promise_type::unhandled_exception() {
+        error = std::current_exception();
+    }
+
+    GameTask::GameTask(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+
+    GameTask::GameTask(GameTask &&other) noexcept : _handle(std::exchange(other._handle, {})) {}
+
+    GameTask &GameTask::operator=(GameTask &&other) noexcept {
+        if (this != &other) {
+            if (_handle) {
+                _handle.destroy();
+            }
+            _handle = std::exchange(other._handle, {});
+        }
+        return *this;
+    }
+
+// Destroy the game, also one still waiting for a move
+    GameTask::~GameTask() {
+        if (_handle) {
+            _handle.destroy();
+        }
+    }
+
+// Check whether the game reached its end
+    bool GameTask::done() const {
+        return _handle && _handle.done();
+    }
+
+// Get the outcome of a finished game
+    SimulationResult GameTask::result() const {
+        if (!done()) {
+            throw std::logic_error("Error: The game is not over yet.");
+        }
+        if (_handle.promise().error) {
+            std::rethrow_exception(_handle.promise().error);
+        }
+        return _handle.promise().result;
+    }
+
+} // namespace strategy
@@ -0,0 +1,59 @@
+#include "BotSwarm.hpp"
+#include <iostream>
+#include <string>
+
+using namespace strategy;
+
+/**
+ * @brief Load-test a match server with a swarm of bots.
+ *
+ * Usage: bot_client [--unix PATH | --port N] [--connections N] [--builds N] [--seed N]
+ *
+ * Opens the connections (three per match), plays every match to its end and prints what the
+ * bots saw along with the rate of turns the server sustained.
+ *
+ * @return int Return code of the program execution.
+ */
+int main(int argc, char *argv[]) {
+    SwarmOptions options;
+    options.endpoint.port = 7878;
+    options.connections = 3000;
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (flag == "--unix" && hasValue) {
+            options.endpoint.unixPath = argv[++i];
+        } else if (flag == "--port" && hasValue) {
+            options.endpoint.port = static_cast<std::uint16_t>(std::stoi(argv[++i]));
+        } else if (flag == "--connections" && hasValue) {
+            options.connections = std::stoul(argv[++i]);
+        } else if (flag == "--builds" && hasValue) {
+            options.buildsPerTurn = std::stoi(argv[++i]);
+        } else if (flag == "--seed" && hasValue) {
+            options.seed = std::stoull(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--unix PATH | --port N] [--connections N] [--builds N] [--seed N]" << std::endl;
+            return 1;
+        }
+    }
+
+    const std::size_t files = raiseOpenFileLimit();
+    if (options.connections + 16 > files) {
+        std::cerr << "Error: " << options.connections << " connections need more than the " << files
+                  << " open files allowed; raise the hard limit with ulimit -Hn." << std::endl;
+        return 1;
+    }
+    try {
+        const SwarmStats stats = BotSwarm(options).run();
+        std::cout << "Bots connected: " << stats.connected << ", finished: " << stats.finished
+                  << ", dropped: " << stats.dropped << ", won: " << stats.wins << std::endl;
+        std::cout << "Turns: " << stats.turns << ", actions received: " << stats.actions
+                  << ", requests rejected: " << stats.rejected << std::endl;
+        std::cout << "Bytes sent: " << stats.bytesSent << ", received: " << stats.bytesReceived << std::endl;
+        std::cout << "Elapsed: " << stats.seconds << " s, " << (double) stats.turns / stats.seconds << " turns/s" << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -2,81 +2,38 @@
 #include "GameBoard.hpp"
 #include "BoardVisualizer.hpp"
 #include "Node.hpp"
+#include "BoardSnapshot.hpp"
+#include "PlacementSolver.hpp"
 #include <iostream>
+#include <thread>
+#include <vector>
 
 using namespace strategy;
 using namespace game;
 
 /**
- * @brief This class represents a simulation of the game "Settlers of Catan".
- *
- * There are 3 participants in this game, where each player is allowed to roll a dice and make moves as they wish.
- * After every 2 rounds, statistics will be printed to the screen, showing the number of points each player has and
- * the resource cards in their hand. This game is highly random; each round will be different.
+ * @brief Play the scripted rounds of the game, printing the status of the players after each round.
  *
- * @return int Return code of the program execution.
+ * Runs on its own thread; every piece placed is published to the window through the board's feed.
  */
-int main() {
-    // Set the players of Catan
-    auto *p1 = new Player("Yael");
-    auto *p2 = new Player("Nadav");
-    auto *p3 = new Player("Shir");
-    auto *catan = new GameOperator();
-    catan->setPlayers(p1, p2, p3);
-
-    // Set the game board
-    auto board = new GameBoard();
-    p1->assignGameBoard(board);
-    p2->assignGameBoard(board);
-    p3->assignGameBoard(board);
-
-    // Start the game by having each player place 2 settlements and 2 roads
-    catan->initiateGame();
-
-    // Initialize the board visualizer
-    BoardVisualizer visualizer(800, 600);
+static void playGame(GameBoard *board, Player *p1, Player *p2, Player *p3, GameOperator *catan) {
+    board->locateNode(12)->displayNode(); // Example of printing a node
 
-    // Main render loop
-    while (visualizer.window.isOpen()) {
-        sf::Event event{};
-        while (visualizer.window.pollEvent(event)) {
-            if (event.type == sf::Event::Closed) {
-                visualizer.window.close();
-            }
+    // Establish initial settlements and pathways for each player, in snake order, as the placement solver ranks them
+    Player *seats[] = {p1, p2, p3};
+    for (int pick = 0; pick < 6; ++pick) {
+        std::vector<Placement> ranked = PlacementSolver(*board, 3).rank(pick);
+        if (ranked.empty()) {
+            std::cerr << "Error: No free node left for an initial settlement." << std::endl;
+            return;
         }
-
-        visualizer.window.clear(); // Clear the window before drawing
-
-        // Draw the board
-        try {
-            visualizer.drawBoard(*board);
-        } catch (const std::bad_alloc &e) {
-            std::cerr << "Memory allocation failed: " << e.what() << std::endl;
-            delete board;
-            return 1;
+        const Placement &best = ranked.front();
+        seats[best.seat]->establishInitialSettlement(best.nodeId);
+        if (best.pathwayId != 0) {
+            seats[best.seat]->establishInitialPathway(best.pathwayId);
         }
-
-        visualizer.window.display(); // Display the drawn content on the window
     }
 
-    // Run the visualizer window
-    visualizer.run();
-    board->locateNode(12)->displayNode(); // Example of printing a node
-
-    // Establish initial settlements and pathways for each player
-    p1->establishInitialSettlement(9);
-    p1->establishInitialPathway(10);
-    p2->establishInitialSettlement(29);
-    p2->establishInitialPathway(37);
-    p3->establishInitialSettlement(33);
-    p3->establishInitialPathway(42);
-    p3->establishInitialSettlement(41);
-    p3->establishInitialPathway(53);
-    p2->establishInitialSettlement(20);
-    p2->establishInitialPathway(25);
-    p1->establishInitialSettlement(12);
-    p1->establishInitialPathway(14);
-
     // Print the number of cards for each player
     p1->displayResourceCards();
     p2->displayResourceCards();
@@ -468,6 +425,53 @@ int main() {
 
     // Declare the winner if the game is over
     catan->declareWinner();
+}
+
+/**
+ * @brief This class represents a simulation of the game "Settlers of Catan".
+ *
+ * There are 3 participants in this game, where each player is allowed to roll a dice and make moves as they wish.
+ * After every 2 rounds, statistics will be printed to the screen, showing the number of points each player has and
+ * the resource cards in their hand. This game is highly random; each round will be different.
+ *
+ * @return int Return code of the program execution.
+ */
+int main() {
+    // Set the players of Catan
+    auto *p1 = new Player("Yael");
+    auto *p2 = new Player("Nadav");
+    auto *p3 = new Player("Shir");
+    auto *catan = new GameOperator();
+    catan->setPlayers(p1, p2, p3);
+
+    // Set the game board
+    auto board = new GameBoard();
+    p1->assignGameBoard(board);
+    p2->assignGameBoard(board);
+    p3->assignGameBoard(board);
+
+    // Start the game by having each player place 2 settlements and 2 roads
+    catan->initiateGame();
+
+    // Play the game on its own thread while the window follows it through a feed of snapshots:
+    // the game never waits for a frame and the window never waits for a turn. The feed and the
+    // visualizer are scoped so they stop following the board before it is deleted
+    int status = 0;
+    {
+        BoardFeed feed(*board);
+        std::thread game(playGame, board, p1, p2, p3, catan);
+        try {
+            BoardVisualizer visualizer(800, 600);
+            visualizer.runLive(feed);
+        } catch (const std::bad_alloc &e) {
+            std::cerr << "Memory allocation failed: " << e.what() << std::endl;
+            status = 1;
+        } catch (const std::exception &e) {
+            std::cerr << e.what() << std::endl;
+            status = 1;
+        }
+        game.join();
+    }
 
     // Clean up allocated memory
     delete catan;
@@ -476,5 +480,5 @@ int main() {
     delete p3;
     delete board;
 
-    return 0;
+    return status;
 }
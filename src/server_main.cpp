@@ -0,0 +1,77 @@
+#include "GameLog.hpp"
+#include "MatchServer.hpp"
+#include <csignal>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace strategy;
+
+/**
+ * @brief Host matches until interrupted.
+ *
+ * Usage: server [--unix PATH | --port N] [--threads N] [--no-pin] [--max-turns N] [--seed N]
+ *
+ * Listens on 127.0.0.1:7878 unless told otherwise, seats every three connections in a match and
+ * prints the counters of the server when stopped with Ctrl-C or SIGTERM.
+ *
+ * @return int Return code of the program execution.
+ */
+int main(int argc, char *argv[]) {
+    ServerOptions options;
+    options.endpoint.port = 7878;
+    for (int i = 1; i < argc; ++i) {
+        const std::string flag = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (flag == "--unix" && hasValue) {
+            options.endpoint.unixPath = argv[++i];
+        } else if (flag == "--port" && hasValue) {
+            options.endpoint.port = static_cast<std::uint16_t>(std::stoi(argv[++i]));
+        } else if (flag == "--threads" && hasValue) {
+            options.threadCount = static_cast<unsigned>(std::stoul(argv[++i]));
+        } else if (flag == "--no-pin") {
+            options.pinThreads = false;
+        } else if (flag == "--max-turns" && hasValue) {
+            options.maxTurns = std::stoi(argv[++i]);
+        } else if (flag == "--seed" && hasValue) {
+            options.seed = std::stoull(argv[++i]);
+        } else {
+            std::cerr << "Usage: " << argv[0] << " [--unix PATH | --port N] [--threads N] [--no-pin] [--max-turns N] [--seed N]" << std::endl;
+            return 1;
+        }
+    }
+
+    // Wait for the stop signals on this thread only; the server's threads inherit the mask
+    sigset_t stopSignals;
+    sigemptyset(&stopSignals);
+    sigaddset(&stopSignals, SIGINT);
+    sigaddset(&stopSignals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &stopSignals, nullptr);
+
+    game::setGameLogEnabled(false);
+    const std::size_t files = raiseOpenFileLimit();
+    try {
+        MatchServer server(options);
+        server.start();
+        if (options.endpoint.unixPath.empty()) {
+            std::cout << "Hosting matches on " << options.endpoint.host << ":" << server.port();
+        } else {
+            std::cout << "Hosting matches on " << options.endpoint.unixPath;
+        }
+        std::cout << " (up to " << files << " open files)" << std::endl;
+
+        int received = 0;
+        sigwait(&stopSignals, &received);
+        server.stop();
+
+        const ServerStats stats = server.stats();
+        std::cout << "Connections: " << stats.connections << std::endl;
+        std::cout << "Matches started: " << stats.matchesStarted << ", finished: " << stats.matchesFinished
+                  << ", aborted: " << stats.matchesAborted << std::endl;
+        std::cout << "Requests rejected: " << stats.rejected << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -5,9 +5,36 @@
 #include "doctest.h"
 #include "DevelopmentCard.hpp"
 #include "GameBoard.hpp"
+#include "BoardView.hpp"
+#include "BenchStatistics.hpp"
+#include "ProductionBatch.hpp"
+#include "IncomeAnalytics.hpp"
+#include "PlacementSolver.hpp"
+#include "BoardRasterizer.hpp"
+#include "SpectatorWall.hpp"
+#include "MatchServer.hpp"
+#include "BotSwarm.hpp"
+#include "TurnDriver.hpp"
+#include "StateDelta.hpp"
+#include "GameSnapshot.hpp"
+#include <chrono>
 #include "Player.hpp"
 #include "Node.hpp"
+#include "Terrain.hpp"
 #include "GameOperator.hpp"
+#include "GameLog.hpp"
+#include "GameSimulator.hpp"
+#include "DatasetExporter.hpp"
+#include "Instrumentation.hpp"
+#include <climits>
+#include <cstring>
+#include <cmath>
+#include <random>
+#include <cstdio>
+#include <fstream>
+#include <atomic>
+#include <thread>
+#include <unistd.h>
 
 // Testing DevelopmentCard Class
 TEST_CASE("DevelopmentCard: Basic Functionality and Edge Cases") {
@@ -398,3 +425,1498 @@ TEST_CASE("Edge Case: Maximum Roads Built") {
 }
 
 
+TEST_CASE("Discarding on a 7") {
+    using namespace game;
+    using namespace strategy;
+    GameBoard gameBoard;
+    Player player1("Amit"), player2("Omer");
+    player1.assignGameBoard(&gameBoard);
+    player2.assignGameBoard(&gameBoard);
+    player1.setOtherPlayer(&player2);
+
+    // 9 cards spread over several types: no single type exceeds 7, but the hand does
+    for (int i = 0; i < 3; ++i) {
+        player1.obtainResourceCard(new LumberCard());
+        player1.obtainResourceCard(new BrickCard());
+        player1.obtainResourceCard(new OreCard());
+    }
+    for (int i = 0; i < 7; ++i) {
+        player2.obtainResourceCard(new GrainCard());
+    }
+
+    SUBCASE("Random discard removes half of the hand, rounded down") {
+        player1.setDiscardStrategy(std::make_unique<RandomDiscardStrategy>(42));
+        player1.discardResourceCards();
+        CHECK(player1.countResourceCards() == 5);
+        CHECK(player2.countResourceCards() == 7);
+    }
+
+    SUBCASE("Random draw never exceeds the hand") {
+        std::mt19937 rng(7);
+        ResourceCounts hand;
+        hand[ResourceType::Wool] = 10;
+        hand[ResourceType::Ore] = 1;
+        for (int i = 0; i < 100; ++i) {
+            ResourceCounts drawn = drawWithoutReplacement(hand, 5, rng);
+            CHECK(drawn.total() == 5);
+            CHECK(hand.covers(drawn));
+        }
+    }
+
+    SUBCASE("Greedy discard levels the largest piles") {
+        player1.obtainResourceCard(new LumberCard());
+        player1.obtainResourceCard(new LumberCard());
+        player1.setDiscardStrategy(std::make_unique<GreedyDiscardStrategy>());
+        CHECK(player1.discardHalf() == 5);
+        CHECK(player1.countSpecificResourceCard("Lumber") == 2);
+        CHECK(player1.countSpecificResourceCard("Brick") == 2);
+        CHECK(player1.countSpecificResourceCard("Ore") == 2);
+    }
+
+    SUBCASE("Bot discard is used when legal and replaced when not") {
+        player1.setDiscardStrategy(std::make_unique<BotDiscardStrategy>(
+                [](const Player &, const ResourceCounts &, int amount) {
+                    ResourceCounts discard;
+                    discard[ResourceType::Ore] = amount;
+                    return discard;
+                }));
+        CHECK(player1.discardHalf() == 4);
+        CHECK(player1.countResourceCards() == 5);
+        CHECK(player1.countSpecificResourceCard("Lumber") + player1.countSpecificResourceCard("Brick") >= 2);
+    }
+
+    SUBCASE("The fallback discard follows the player's seed") {
+        auto discardWithSeed = [](std::uint32_t seed) {
+            GameBoard board;
+            Player player("Seeded");
+            player.assignGameBoard(&board);
+            player.seedRandom(seed);
+            for (int i = 0; i < 4; ++i) {
+                player.obtainResourceCard(new LumberCard());
+                player.obtainResourceCard(new BrickCard());
+                player.obtainResourceCard(new WoolCard());
+            }
+            player.setDiscardStrategy(std::make_unique<BotDiscardStrategy>(
+                    [](const Player &, const ResourceCounts &, int) { return ResourceCounts{}; }));
+            player.discardHalf();
+            return player.getResources();
+        };
+        for (std::uint32_t seed = 1; seed <= 5; ++seed) {
+            CHECK(discardWithSeed(seed) == discardWithSeed(seed));
+        }
+    }
+}
+
+TEST_CASE("Bank and maritime trade") {
+    using namespace game;
+    using namespace strategy;
+    GameBoard gameBoard;
+    Player player1("Amit");
+    player1.assignGameBoard(&gameBoard);
+
+    for (int i = 0; i < 4; ++i) {
+        player1.obtainResourceCard(new WoolCard());
+    }
+    CHECK(gameBoard.getBank().supply(ResourceType::Wool) == Bank::CARDS_PER_RESOURCE - 4);
+
+    SUBCASE("4:1 trade without a harbor") {
+        CHECK(player1.bestTradeRatio(ResourceType::Wool) == 4);
+        CHECK(player1.tradeWithBank(ResourceType::Wool, ResourceType::Ore));
+        CHECK(player1.countSpecificResourceCard("Wool") == 0);
+        CHECK(player1.countSpecificResourceCard("Ore") == 1);
+        CHECK(gameBoard.getBank().supply(ResourceType::Wool) == Bank::CARDS_PER_RESOURCE);
+        CHECK(gameBoard.getBank().supply(ResourceType::Ore) == Bank::CARDS_PER_RESOURCE - 1);
+    }
+
+    SUBCASE("Failed trades return false instead of throwing") {
+        CHECK_FALSE(player1.tradeWithBank(ResourceType::Wool, ResourceType::Ore, 2));
+        CHECK_FALSE(player1.tradeWithBank(ResourceType::Wool, ResourceType::Wool));
+        CHECK(player1.countSpecificResourceCard("Wool") == 4);
+    }
+
+    SUBCASE("Harbor ratios follow the settled nodes") {
+        CHECK(gameBoard.locateNode(4)->getHarbor() == HarborType::Wool);
+        player1.establishInitialSettlement(1); // Generic harbor
+        CHECK(player1.bestTradeRatio(ResourceType::Ore) == 3);
+        player1.establishInitialSettlement(4); // Wool harbor
+        CHECK(player1.bestTradeRatio(ResourceType::Wool) == 2);
+        CHECK(player1.bestTradeRatio(ResourceType::Brick) == 3);
+        int wool = player1.countSpecificResourceCard("Wool");
+        int grain = player1.countSpecificResourceCard("Grain");
+        CHECK(player1.tradeWithBank(ResourceType::Wool, ResourceType::Grain, 2));
+        CHECK(player1.countSpecificResourceCard("Wool") == wool - 4);
+        CHECK(player1.countSpecificResourceCard("Grain") == grain + 2);
+    }
+
+    SUBCASE("Production is limited by the bank's supply") {
+        CHECK(gameBoard.getBank().withdraw(ResourceType::Lumber, 100) == Bank::CARDS_PER_RESOURCE);
+        player1.obtainResourceCard(new LumberCard());
+        CHECK(player1.countSpecificResourceCard("Lumber") == 0);
+    }
+
+    SUBCASE("Two cards are taken together or not at all") {
+        Bank &bank = gameBoard.getBank();
+        bank.withdraw(ResourceType::Lumber, Bank::CARDS_PER_RESOURCE - 1);
+        LumberCard lumber;
+        player1.receiveTwoResourceCards(&lumber);
+        CHECK(player1.countSpecificResourceCard("Lumber") == 0);
+        CHECK(bank.getSupply()[ResourceType::Lumber] == 1);
+
+        bank.deposit(ResourceType::Lumber, 1);
+        player1.receiveTwoResourceCards(&lumber);
+        CHECK(player1.countSpecificResourceCard("Lumber") == 2);
+        CHECK(bank.getSupply()[ResourceType::Lumber] == 0);
+    }
+}
+
+TEST_CASE("Trade negotiation between participants") {
+    using namespace game;
+    using namespace strategy;
+    GameBoard gameBoard;
+    Player player1("Amit"), player2("Omer"), player3("Nir");
+    GameOperator gameOperator;
+    gameOperator.setPlayers(&player1, &player2, &player3);
+    player1.assignGameBoard(&gameBoard);
+    player2.assignGameBoard(&gameBoard);
+    player3.assignGameBoard(&gameBoard);
+    gameOperator.initiateGame();
+
+    for (int i = 0; i < 3; ++i) {
+        player1.obtainResourceCard(new OreCard());
+        player2.obtainResourceCard(new BrickCard());
+        player3.obtainResourceCard(new BrickCard());
+    }
+
+    TradeOffer offer;
+    offer.give[ResourceType::Ore] = 1;
+    offer.receive[ResourceType::Brick] = 1;
+
+    SUBCASE("Participants without a policy reject") {
+        TradeResult result = TradeNegotiator::negotiate(player1, offer);
+        CHECK_FALSE(result.completed);
+        CHECK(player1.countSpecificResourceCard("Ore") == 3);
+    }
+
+    SUBCASE("An accepting bot trades atomically") {
+        player3.setTradePolicy(std::make_unique<ValueTradePolicy>());
+        TradeResult result = TradeNegotiator::negotiate(player1, offer);
+        CHECK(result.completed);
+        CHECK(result.partner == &player3);
+        CHECK(player1.countSpecificResourceCard("Ore") == 2);
+        CHECK(player1.countSpecificResourceCard("Brick") == 1);
+        CHECK(player3.countSpecificResourceCard("Ore") == 1);
+        CHECK(player3.countSpecificResourceCard("Brick") == 2);
+    }
+
+    SUBCASE("The best counter-offer is executed after one round") {
+        struct CounterPolicy : TradePolicy {
+            TradeOffer counter;
+            int asked = 0;
+            TradeResponse respond(const Player &, const Player &, const TradeOffer &) override {
+                asked++;
+                return {TradeReply::Counter, counter};
+            }
+        };
+        auto fair = std::make_unique<CounterPolicy>();
+        fair->counter.give[ResourceType::Ore] = 2;
+        fair->counter.receive[ResourceType::Brick] = 2;
+        auto greedy = std::make_unique<CounterPolicy>();
+        greedy->counter.give[ResourceType::Ore] = 3;
+        greedy->counter.receive[ResourceType::Brick] = 1;
+        CounterPolicy &fairPolicy = *fair, &greedyPolicy = *greedy;
+        player2.setTradePolicy(std::move(fair));
+        player3.setTradePolicy(std::move(greedy));
+
+        TradeResult result = TradeNegotiator::negotiate(player1, offer);
+        CHECK(result.completed);
+        CHECK(result.partner == &player2);
+        CHECK(result.executed.give[ResourceType::Ore] == 2);
+        CHECK(result.executed.receive[ResourceType::Brick] == 2);
+        CHECK(fairPolicy.asked == 1);
+        CHECK(greedyPolicy.asked == 1);
+        CHECK(player1.countSpecificResourceCard("Ore") == 1);
+        CHECK(player1.countSpecificResourceCard("Brick") == 2);
+        CHECK(player2.countSpecificResourceCard("Ore") == 2);
+        CHECK(player2.countSpecificResourceCard("Brick") == 1);
+        CHECK(player3.countSpecificResourceCard("Ore") == 0);
+        CHECK(player3.countSpecificResourceCard("Brick") == 3);
+    }
+
+    SUBCASE("Unaffordable exchanges leave both hands untouched") {
+        ResourceCounts give, receive;
+        give[ResourceType::Ore] = 1;
+        receive[ResourceType::Brick] = 4;
+        CHECK_FALSE(player1.exchangeResources(&player2, give, receive));
+        CHECK(player1.countSpecificResourceCard("Ore") == 3);
+        CHECK(player2.countSpecificResourceCard("Brick") == 3);
+    }
+
+    SUBCASE("Batched scoring matches the hand") {
+        OfferBatch batch;
+        batch.add(offer);
+        TradeOffer tooExpensive;
+        tooExpensive.give[ResourceType::Ore] = 4;
+        batch.add(tooExpensive);
+        std::vector<float> scores;
+        batch.score(player1.getResources(), TradeNegotiator::resourceWeights(player1.getResources()), scores);
+        REQUIRE(scores.size() == 2);
+        CHECK(scores[0] > 0.0f);
+        CHECK(scores[1] == -std::numeric_limits<float>::infinity());
+    }
+}
+
+TEST_CASE("Recording and replaying a game") {
+    using namespace game;
+    using namespace strategy;
+    setGameLogEnabled(false);
+
+    SUBCASE("Varints round-trip") {
+        std::vector<std::uint8_t> bytes;
+        for (std::uint64_t value : {0ull, 127ull, 128ull, 300ull, 1ull << 40}) {
+            writeVarint(bytes, value);
+        }
+        CHECK(bytes.size() == 1 + 1 + 2 + 2 + 6);
+        const std::uint8_t *pos = bytes.data();
+        std::uint64_t value;
+        for (std::uint64_t expected : {0ull, 127ull, 128ull, 300ull, 1ull << 40}) {
+            REQUIRE(readVarint(pos, bytes.data() + bytes.size(), value));
+            CHECK(value == expected);
+        }
+        CHECK_FALSE(readVarint(pos, bytes.data() + bytes.size(), value));
+    }
+
+    SUBCASE("Truncated or invalid terrains are rejected") {
+        // Start tag, seed, no players, two terrains: lumber 11, then a cut or a bad resource
+        std::vector<std::uint8_t> bytes = {0xF0, 7, 0, 2, static_cast<std::uint8_t>(ResourceType::Lumber), 11};
+        GameHeader header;
+        GameRecordCursor truncated(bytes.data(), bytes.data() + bytes.size());
+        CHECK_THROWS_AS(truncated.nextGame(header), std::runtime_error);
+
+        bytes.insert(bytes.end(), {static_cast<std::uint8_t>(ResourceType::None) + 1, 6, 0});
+        GameRecordCursor invalid(bytes.data(), bytes.data() + bytes.size());
+        CHECK_THROWS_AS(invalid.nextGame(header), std::runtime_error);
+
+        bytes[6] = static_cast<std::uint8_t>(ResourceType::None);
+        GameRecordCursor valid(bytes.data(), bytes.data() + bytes.size());
+        REQUIRE(valid.nextGame(header));
+        CHECK(header.terrains.size() == 2);
+        CHECK(header.terrains[1].resource == ResourceType::None);
+    }
+
+    SUBCASE("A replay rebuilds the recorded game") {
+        std::string path = "catan_test_record.bin";
+        std::remove(path.c_str());
+        GameSimulator simulator(42);
+        {
+            GameRecordWriter writer(path);
+            simulator.setRecorder(&writer);
+            simulator.play(200);
+        }
+
+        GameRecordReader reader(path);
+        GameRecordCursor cursor = reader.games();
+        GameHeader header;
+        REQUIRE(cursor.nextGame(header));
+        CHECK(header.seed == 42);
+        CHECK(header.playerNames.size() == 3);
+        CHECK(header.terrains.size() == 19);
+
+        GameReplayer replayer(header, cursor);
+        replayer.replayUntilTurn(1 << 30);
+        CHECK(replayer.isFinished());
+        for (int seat = 0; seat < 3; ++seat) {
+            CHECK(replayer.getPlayer(seat).getResources() == simulator.getPlayer(seat).getResources());
+            CHECK(replayer.getPlayer(seat).calculateScore() == simulator.getPlayer(seat).calculateScore());
+        }
+        for (int node = 1; node <= 54; ++node) {
+            CHECK(replayer.getBoard().locateNode(node)->isOccupied() == simulator.getBoard().locateNode(node)->isOccupied());
+        }
+
+        GameRecordCursor rest = replayer.getCursor();
+        CHECK_FALSE(rest.nextGame(header));
+        std::remove(path.c_str());
+    }
+
+    setGameLogEnabled(true);
+}
+
+TEST_CASE("Exporting replayed games as tensors") {
+    using namespace game;
+    using namespace strategy;
+    setGameLogEnabled(false);
+    std::string path = "catan_test_dataset.bin";
+    std::remove(path.c_str());
+
+    std::vector<SimulationResult> results;
+    {
+        GameRecordWriter writer(path);
+        for (std::uint64_t seed : {7u, 8u, 9u}) {
+            GameSimulator simulator(seed);
+            simulator.setRecorder(&writer);
+            results.push_back(simulator.play(60));
+        }
+    }
+
+    ExportOptions options;
+    options.outputPrefix = "catan_test_shard";
+    options.threadCount = 2;
+    options.recordsPerShard = 50;
+    ExportStats stats = DatasetExporter(options).exportLog(path);
+    CHECK(stats.games == 3);
+    std::size_t expected = 0;
+    for (const SimulationResult &result : results) {
+        expected += result.turns + 1;
+    }
+    CHECK(stats.records == expected);
+
+    std::ifstream shard("catan_test_shard-0-0.tensors", std::ios::binary);
+    REQUIRE(shard);
+    std::vector<char> preamble(13), record(StateTensor::RECORD_SIZE);
+    shard.read(preamble.data(), (std::streamsize) preamble.size());
+    CHECK(std::string(preamble.data(), 8) == "CATANTSR");
+    REQUIRE(shard.read(record.data(), (std::streamsize) record.size()));
+    CHECK(static_cast<std::uint8_t>(record[0]) == 7);
+    // The desert is the 8th terrain and has no number token
+    CHECK(record[14 + StateTensor::TERRAIN_OFFSET + 2 * 7 + 1] == 0);
+    shard.close();
+
+    for (unsigned worker = 0; worker < 2; ++worker) {
+        for (std::size_t index = 0; index < stats.shards; ++index) {
+            std::remove(("catan_test_shard-" + std::to_string(worker) + "-" + std::to_string(index) + ".tensors").c_str());
+        }
+    }
+    std::remove(path.c_str());
+    setGameLogEnabled(true);
+}
+
+TEST_CASE("Hot-path instrumentation") {
+    using namespace game;
+    using namespace strategy;
+    setGameLogEnabled(false);
+    resetProbes();
+    GameSimulator simulator(3);
+    SimulationResult result = simulator.play(20);
+    ProbeReport report = collectProbes();
+
+    if (instrumentationEnabled()) {
+        CHECK(report[static_cast<std::size_t>(Probe::Roll)].calls == static_cast<std::uint64_t>(result.turns));
+        CHECK(report[static_cast<std::size_t>(Probe::Production)].calls == static_cast<std::uint64_t>(result.turns));
+        CHECK(report[static_cast<std::size_t>(Probe::Setup)].calls == 12);
+        CHECK(report[static_cast<std::size_t>(Probe::BuildCheck)].calls > 0);
+        CHECK(report[static_cast<std::size_t>(Probe::Roll)].ticks >= report[static_cast<std::size_t>(Probe::Production)].ticks);
+    } else {
+        for (const ProbeStats &stats : report) {
+            CHECK(stats.calls == 0);
+        }
+    }
+    std::ostringstream dump;
+    dumpProbes(dump);
+    CHECK_FALSE(dump.str().empty());
+    setGameLogEnabled(true);
+}
+
+TEST_CASE("Tracing a simulated game") {
+    using namespace game;
+    using namespace strategy;
+    setGameLogEnabled(false);
+    std::string path = "catan_test_trace.json";
+    SimulationResult result;
+    {
+        GameTracer tracer(path);
+        GameSimulator simulator(5);
+        simulator.setTracer(&tracer);
+        result = simulator.play(10);
+    }
+
+    std::ifstream file(path);
+    std::stringstream content;
+    content << file.rdbuf();
+    std::string trace = content.str();
+    CHECK(trace.rfind("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 0) == 0);
+    CHECK(trace.find("]}") != std::string::npos);
+    CHECK(trace.find("\"name\":\"Turn\",\"cat\":\"turn\"") != std::string::npos);
+    CHECK(trace.find("\"player\":\"Bot 1\",\"turn\":1}") != std::string::npos);
+    CHECK(trace.find("\"turn\":" + std::to_string(result.turns) + "}") != std::string::npos);
+    CHECK(trace.find("GreedySearch") != std::string::npos);
+    std::remove(path.c_str());
+    setGameLogEnabled(true);
+}
+
+TEST_CASE("Board graph") {
+    using namespace strategy;
+    GameBoard board;
+    const BoardGraph &graph = board.getGraph();
+    CHECK(graph.nodeCount() == 54);
+    CHECK(graph.pathwayCount() == 72);
+    CHECK(graph.terrainCount() == 19);
+
+    SUBCASE("Nodes read their adjacency from the graph") {
+        for (int id = 1; id <= 54; ++id) {
+            Node *node = board.locateNode(id);
+            GraphRange<Pathway> pathways = node->getPathways();
+            REQUIRE(pathways.size() == graph.nodePathwayIndices(id - 1).size());
+            for (std::size_t i = 0; i < pathways.size(); ++i) {
+                CHECK(pathways[i] == node->getPathwayAt((int) i));
+                CHECK(pathways[i]->getId() == graph.nodePathwayIndices(id - 1)[i] + 1);
+            }
+            CHECK(node->getPathwayAt((int) pathways.size()) == nullptr);
+            CHECK(node->getNeighbors().size() <= BoardGraph::NODE_DEGREE);
+        }
+    }
+
+    SUBCASE("Terrains read their corners from the graph") {
+        for (std::size_t t = 0; t < graph.terrainCount(); ++t) {
+            Terrain *terrain = board.locateTerrain((int) t);
+            REQUIRE(terrain->getNodes().size() == BoardGraph::TERRAIN_DEGREE);
+            for (std::size_t i = 0; i < BoardGraph::TERRAIN_DEGREE; ++i) {
+                CHECK(terrain->getNodes()[i]->getId() == graph.terrainNodeIndices(t)[i] + 1);
+            }
+        }
+    }
+
+    SUBCASE("Pathway ends match the graph") {
+        for (int id = 1; id <= 72; ++id) {
+            Pathway *pathway = board.locatePathway(id);
+            CHECK(pathway->getNode1()->getId() == graph.pathwayNodeIndices(id - 1)[0] + 1);
+            CHECK(pathway->getNode2()->getId() == graph.pathwayNodeIndices(id - 1)[1] + 1);
+        }
+    }
+
+    SUBCASE("The graph is fixed once built") {
+        CHECK_THROWS_AS(board.locateNode(1)->addPathway(board.locatePathway(5)), std::logic_error);
+    }
+}
+
+TEST_CASE("Production table") {
+    using namespace game;
+    using namespace strategy;
+    GameBoard board;
+    Player player1("Amit"), player2("Omer");
+    player1.assignGameBoard(&board);
+    player2.assignGameBoard(&board);
+    player1.setNextPlayer(&player2);
+
+    // Terrain 0 is the only lumber terrain numbered 11
+    const ProductionTable &table = board.getProduction();
+    IndexRange corners = board.getGraph().terrainNodeIndices(0);
+    REQUIRE(corners.size() == BoardGraph::TERRAIN_DEGREE);
+    player1.establishInitialSettlement(corners[0] + 1);
+    player2.establishInitialSettlement(corners[3] + 1);
+    int lumber1 = player1.countSpecificResourceCard("Lumber");
+    int lumber2 = player2.countSpecificResourceCard("Lumber");
+    player1.activateTurn(true);
+
+    SUBCASE("Terrains are copied in board order and the robber starts on the desert") {
+        CHECK(table.terrainCount() == 19);
+        CHECK(table.resource(0) == ResourceType::Lumber);
+        CHECK(table.number(0) == 11);
+        CHECK(table.resource(7) == ResourceType::None);
+        CHECK(board.getRobber() == 7);
+        CHECK(table.robbed(7));
+        CHECK_THROWS_AS(board.locateTerrain(0)->setTerrainNum(6), std::logic_error);
+    }
+
+    SUBCASE("A roll pays every player, not only the roller") {
+        player1.rollDiceAndMove(5, 6);
+        CHECK(player1.countSpecificResourceCard("Lumber") == lumber1 + 1);
+        CHECK(player2.countSpecificResourceCard("Lumber") == lumber2 + 1);
+    }
+
+    SUBCASE("Cities collect two cards") {
+        std::array<ResourceCounts, 2> gains{};
+        ProductionTable copy = table;
+        copy.setBuilding(corners[0], 0, 2);
+        copy.produce(11, gains);
+        CHECK(gains[0][ResourceType::Lumber] == 2);
+        CHECK(gains[1][ResourceType::Lumber] == 1);
+        copy.produce(12, gains);
+        CHECK(gains[0][ResourceType::Lumber] == 0);
+    }
+
+    SUBCASE("The robber blocks its terrain") {
+        board.moveRobber(0);
+        CHECK(board.getRobber() == 0);
+        CHECK_FALSE(table.robbed(7));
+        player1.rollDiceAndMove(5, 6);
+        CHECK(player1.countSpecificResourceCard("Lumber") == lumber1);
+        CHECK(player2.countSpecificResourceCard("Lumber") == lumber2);
+        CHECK_THROWS_AS(board.moveRobber(19), std::out_of_range);
+    }
+
+    SUBCASE("Nobody is paid a resource the bank cannot pay everyone") {
+        Bank &bank = board.getBank();
+        bank.withdraw(ResourceType::Lumber, bank.getSupply()[ResourceType::Lumber] - 1);
+        player1.rollDiceAndMove(5, 6);
+        CHECK(player1.countSpecificResourceCard("Lumber") == lumber1);
+        CHECK(player2.countSpecificResourceCard("Lumber") == lumber2);
+        CHECK(bank.getSupply()[ResourceType::Lumber] == 1);
+    }
+}
+
+TEST_CASE("Batched production") {
+    using namespace game;
+    using namespace strategy;
+    GameBoard board;
+    const std::size_t games = 70; // two full blocks of 32 and a partial one
+    ProductionBatch batch(board, games, 4);
+    CHECK(batch.stride() == 96);
+
+    // Random buildings and robbers, mirrored into one production table per game
+    std::mt19937 rng(38);
+    std::vector<ProductionTable> tables(games, board.getProduction());
+    std::vector<std::uint8_t> rolls(games);
+    for (std::size_t g = 0; g < games; ++g) {
+        for (int i = 0; i < 12; ++i) {
+            std::size_t node = rng() % BoardGraph::MAX_NODES;
+            int seat = (int) (rng() % 4), yield = (int) (rng() % 2) + 1;
+            batch.setBuilding(g, node, seat, yield);
+            tables[g].setBuilding(node, seat, yield);
+        }
+        int robber = (int) (rng() % 19);
+        batch.moveRobber(g, robber);
+        tables[g].moveRobber(robber);
+        rolls[g] = static_cast<std::uint8_t>(rng() % 6 + rng() % 6 + 2);
+    }
+
+    SUBCASE("Every kernel agrees with the per-game production") {
+        for (ProductionKernel kernel : {ProductionKernel::Scalar, ProductionKernel::Avx2, ProductionKernel::Auto}) {
+            std::vector<std::uint8_t> deltas(batch.deltaSize(), 0xAA);
+            batch.produce(rolls, deltas, kernel);
+            for (std::size_t g = 0; g < games; ++g) {
+                std::array<ResourceCounts, 4> gains{};
+                tables[g].produce(rolls[g], gains);
+                for (std::size_t seat = 0; seat < 4; ++seat) {
+                    CHECK(batch.gainsOf(deltas, g, seat) == gains[seat]);
+                }
+            }
+        }
+    }
+
+    SUBCASE("A game can be loaded from a board") {
+        Player player1("Amit"), player2("Omer");
+        player1.assignGameBoard(&board);
+        player2.assignGameBoard(&board);
+        IndexRange corners = board.getGraph().terrainNodeIndices(0);
+        player1.establishInitialSettlement(corners[0] + 1);
+        player2.establishInitialSettlement(corners[3] + 1);
+        batch.loadGame(5, board);
+        rolls[5] = 11;
+        std::vector<std::uint8_t> deltas(batch.deltaSize());
+        batch.produce(rolls, deltas);
+        CHECK(batch.gainsOf(deltas, 5, 0)[ResourceType::Lumber] == 1);
+        CHECK(batch.gainsOf(deltas, 5, 1)[ResourceType::Lumber] == 1);
+    }
+
+    SUBCASE("A board with more players than seats is not loaded") {
+        Player player1("Amit"), player2("Omer"), player3("Nir"), player4("Tal");
+        for (Player *player : {&player1, &player2, &player3, &player4}) {
+            player->assignGameBoard(&board);
+        }
+        IndexRange corners = board.getGraph().terrainNodeIndices(0);
+        player4.establishInitialSettlement(corners[0] + 1);
+        ProductionBatch small(board, 2, 3);
+        CHECK_THROWS_AS(small.loadGame(0, board), std::out_of_range);
+
+        std::vector<std::uint8_t> deltas(small.deltaSize());
+        std::vector<std::uint8_t> rolls(small.stride(), 11);
+        small.produce(rolls, deltas);
+        CHECK(std::all_of(deltas.begin(), deltas.end(), [](std::uint8_t d) { return d == 0; }));
+    }
+
+    SUBCASE("Invalid input is rejected") {
+        std::vector<std::uint8_t> deltas(batch.deltaSize() - 1);
+        CHECK_THROWS_AS(batch.produce(rolls, deltas), std::invalid_argument);
+        CHECK_THROWS_AS(batch.setBuilding(games, 0, 0, 1), std::out_of_range);
+        CHECK_THROWS_AS(batch.moveRobber(0, 19), std::out_of_range);
+        CHECK_THROWS_AS(ProductionBatch(board, 1, 9), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Expected income") {
+    using namespace game;
+    using namespace strategy;
+    GameBoard board;
+    Player player1("Amit"), player2("Omer");
+    player1.assignGameBoard(&board);
+    player2.assignGameBoard(&board);
+    IncomeAnalytics income(board);
+
+    // Terrain 0 is lumber numbered 11: two pips out of 36
+    IndexRange corners = board.getGraph().terrainNodeIndices(0);
+    const int nodeId = corners[0] + 1;
+
+    SUBCASE("Pips follow the dice") {
+        CHECK(pips(2) == 1);
+        CHECK(pips(6) == 5);
+        CHECK(pips(7) == 0);
+        CHECK(pips(0) == 0);
+    }
+
+    SUBCASE("Node income sums the pips of the bordering terrains") {
+        CHECK(income.nodeIncome(nodeId)[ResourceType::Lumber] >= doctest::Approx(2.0 / 36));
+        double total = 0.0;
+        for (int id = 1; id <= 54; ++id) {
+            total += income.nodeIncome(id).total();
+        }
+        // Every corner of the 18 producing terrains counts its pips once
+        double expected = 0.0;
+        for (std::size_t t = 0; t < 19; ++t) {
+            expected += BoardGraph::TERRAIN_DEGREE * pips(board.getProduction().number(t)) / 36.0;
+        }
+        CHECK(total == doctest::Approx(expected));
+        CHECK_THROWS_AS((void) income.nodeIncome(55), std::out_of_range);
+    }
+
+    SUBCASE("Player income follows every build") {
+        CHECK(income.playerIncome(0).total() == 0.0);
+        player1.establishInitialSettlement(nodeId);
+        ExpectedIncome settlement = income.playerIncome(0);
+        CHECK(settlement.total() == doctest::Approx(income.nodeIncome(nodeId).total()));
+        CHECK(income.playerIncome(1).total() == 0.0);
+
+        CHECK(board.getBank().withdraw(Player::CITY_COST));
+        player1.receiveProduction(Player::CITY_COST);
+        player1.upgradeToCity(nodeId);
+        CHECK(income.playerIncome(0).total() == doctest::Approx(2 * settlement.total()));
+    }
+
+    SUBCASE("The robber is noticed on the next query") {
+        player1.establishInitialSettlement(nodeId);
+        double before = income.playerIncome(0)[ResourceType::Lumber];
+        board.moveRobber(0);
+        CHECK(income.playerIncome(0)[ResourceType::Lumber] == doctest::Approx(before - 2.0 / 36));
+        CHECK(income.nodeIncome(nodeId)[ResourceType::Lumber] == doctest::Approx(before - 2.0 / 36));
+    }
+
+    SUBCASE("Moving the robber is published to the observers") {
+        struct RobberWatcher : GameObserver {
+            std::vector<GameAction> moves;
+            void onAction(const GameAction &action) override {
+                if (action.type == ActionType::MoveRobber) {
+                    moves.push_back(action);
+                }
+            }
+        } watcher;
+        board.addObserver(&watcher);
+        board.moveRobber(4, 1);
+        board.removeObserver(&watcher);
+        REQUIRE(watcher.moves.size() == 1);
+        CHECK(watcher.moves[0].value == 4);
+        CHECK(watcher.moves[0].seat == 1);
+        CHECK(board.getRobber() == 4);
+    }
+}
+
+TEST_CASE("Opening placement solver") {
+    using namespace game;
+    using namespace strategy;
+    GameBoard board;
+
+    SUBCASE("Picks follow the snake order") {
+        const int seats[] = {0, 1, 2, 2, 1, 0};
+        for (int pick = 0; pick < 6; ++pick) {
+            CHECK(PlacementSolver::seatOfPick(pick, 3) == seats[pick]);
+        }
+    }
+
+    SUBCASE("Placements are ranked, legal and agree across thread counts") {
+        PlacementOptions options;
+        options.threadCount = 1;
+        std::vector<Placement> serial = PlacementSolver(board, 3, options).rank(0);
+        options.threadCount = 4;
+        std::vector<Placement> parallel = PlacementSolver(board, 3, options).rank(0);
+
+        REQUIRE(serial.size() == options.limit);
+        REQUIRE(parallel.size() == serial.size());
+        for (std::size_t i = 0; i < serial.size(); ++i) {
+            CHECK(parallel[i].nodeId == serial[i].nodeId);
+            CHECK(parallel[i].score == serial[i].score);
+            CHECK(serial[i].seat == 0);
+            if (i > 0) {
+                CHECK(serial[i].score <= serial[i - 1].score);
+            }
+            Pathway *pathway = board.locatePathway(serial[i].pathwayId);
+            REQUIRE(pathway != nullptr);
+            CHECK((pathway->getNode1()->getId() == serial[i].nodeId || pathway->getNode2()->getId() == serial[i].nodeId));
+        }
+    }
+
+    SUBCASE("A whole setup phase can be played from the rankings") {
+        Player player1("Amit"), player2("Omer"), player3("Yael");
+        Player *players[] = {&player1, &player2, &player3};
+        for (Player *player : players) {
+            player->assignGameBoard(&board);
+        }
+        for (int pick = 0; pick < 6; ++pick) {
+            std::vector<Placement> ranked = PlacementSolver(board, 3).rank(pick);
+            REQUIRE_FALSE(ranked.empty());
+            Player *player = players[ranked.front().seat];
+            CHECK_NOTHROW(player->establishInitialSettlement(ranked.front().nodeId));
+            CHECK_NOTHROW(player->establishInitialPathway(ranked.front().pathwayId));
+            // The distance rule holds for every settlement placed so far
+            for (Node *neighbor : board.locateNode(ranked.front().nodeId)->getNeighbors()) {
+                CHECK(board.getProduction().nodeSeat(neighbor->getId() - 1) < 0);
+            }
+        }
+        IncomeAnalytics income(board);
+        for (int seat = 0; seat < 3; ++seat) {
+            CHECK(income.playerIncome(seat).total() > 0.0);
+        }
+        CHECK_THROWS_AS((void) PlacementSolver(board, 3).rank(6), std::out_of_range);
+    }
+}
+
+TEST_CASE("Board view") {
+    using namespace strategy;
+    GameBoard board;
+    game::Player alice("Alice");
+    alice.assignGameBoard(&board);
+    BoardView view(board);
+
+    SUBCASE("Collections are views of the board's own tables") {
+        CHECK(view.nodes().size() == 54);
+        CHECK(view.pathways().size() == 72);
+        CHECK(view.terrains().size() == 19);
+        CHECK(view.nodes().data() == board.getNodes().data());
+        CHECK(view.terrains().data() == board.getTerrains().data());
+        CHECK(view.node(1) == board.locateNode(1));
+        CHECK(view.pathway(72) == board.locatePathway(72));
+        CHECK(view.terrain(18) == board.locateTerrain(18));
+        CHECK(&view.graph() == &board.getGraph());
+    }
+
+    SUBCASE("Lookups off the board give nullptr") {
+        CHECK(view.node(0) == nullptr);
+        CHECK(view.node(55) == nullptr);
+        CHECK(view.pathway(73) == nullptr);
+        CHECK(view.terrain(-1) == nullptr);
+        CHECK(view.terrain(19) == nullptr);
+        CHECK(view.player(1) == nullptr);
+    }
+
+    SUBCASE("The view follows the board") {
+        CHECK(view.playerCount() == 1);
+        CHECK(view.player(0) == &alice);
+        alice.establishInitialSettlement(9);
+        CHECK(view.node(9)->isOccupied());
+        CHECK(view.node(9)->getSettlement()->identifyOwner() == &alice);
+        CHECK(view.terrain(0)->getResourceName() == board.locateTerrain(0)->getResourceName());
+    }
+}
+
+TEST_CASE("Headless board rendering") {
+    using namespace strategy;
+    GameBoard board;
+    BoardRasterizer rasterizer({200, 150, 2});
+    BoardLayout layout(200, 150);
+
+    SUBCASE("Terrains are painted in their resource colors") {
+        RasterImage image = rasterizer.render(BoardView(board));
+        CHECK(image.width() == 200);
+        CHECK(image.height() == 150);
+        CHECK(image.pixel(0, 0) == Rgba{255, 255, 255});
+        // Halfway between the center and a corner lies outside the number token
+        Point center = layout.hexCenter(0);
+        Point corner = BoardLayout::hexCorner(center, layout.radius() * 0.7f, 1);
+        CHECK(image.pixel((int) corner.x, (int) corner.y) == resourceColor(board.locateTerrain(0)->getResourceType()));
+        CHECK_THROWS_AS((void) image.pixel(200, 0), std::out_of_range);
+        CHECK_THROWS_AS((void) layout.hexCenter(19), std::out_of_range);
+
+        RasterImage wrongSize(10, 10);
+        CHECK_THROWS_AS(rasterizer.render(BoardView(board), wrongSize), std::invalid_argument);
+    }
+
+    SUBCASE("Images are written as PNG files") {
+        std::vector<std::uint8_t> png = rasterizer.render(BoardView(board)).encodePng();
+        REQUIRE(png.size() > 33);
+        const std::uint8_t signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+        CHECK(std::equal(signature, signature + 8, png.begin()));
+        CHECK(std::string(png.begin() + 12, png.begin() + 16) == "IHDR");
+        CHECK(png[19] == 200);
+        CHECK(png[23] == 150);
+        // Flat colors compress well below the raw 120 kB
+        CHECK(png.size() < 200 * 150);
+    }
+
+    SUBCASE("Boards render in parallel to the same files as one at a time") {
+        GameBoard robbed;
+        robbed.moveRobber(0);
+        std::vector<const GameBoard *> boards = {&board, &robbed, &board, &robbed};
+        std::vector<std::string> paths;
+        for (std::size_t i = 0; i < boards.size(); ++i) {
+            paths.push_back("catan_test_board_" + std::to_string(i) + ".png");
+        }
+        rasterizer.renderToFiles(boards, paths);
+        for (std::size_t i = 0; i < boards.size(); ++i) {
+            std::ifstream file(paths[i], std::ios::binary);
+            std::vector<std::uint8_t> written((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+            CHECK(written == rasterizer.render(BoardView(*boards[i])).encodePng());
+            std::remove(paths[i].c_str());
+        }
+        CHECK(rasterizer.render(BoardView(board)).encodePng() != rasterizer.render(BoardView(robbed)).encodePng());
+        CHECK_THROWS_AS(rasterizer.renderToFiles(boards, std::span<const std::string>(paths).first(2)), std::invalid_argument);
+    }
+
+    SUBCASE("Nodes sit on distinct corners, one edge apart from their neighbors") {
+        BoardLayout placed(200, 150, board.getGraph());
+        REQUIRE(placed.nodeCount() == 54);
+        int edges = 0;
+        for (std::size_t p = 0; p < 72; ++p) {
+            const auto &ends = placed.pathwayEnds(p);
+            edges += std::abs(std::hypot(ends[0].x - ends[1].x, ends[0].y - ends[1].y) - placed.radius()) < 0.5f;
+        }
+        // Pathway 18 joins node 16 to itself
+        CHECK(edges == 71);
+        int overlaps = 0;
+        for (std::size_t a = 0; a < 54; ++a) {
+            for (std::size_t b = 0; b < a; ++b) {
+                overlaps += std::hypot(placed.nodePosition(a).x - placed.nodePosition(b).x,
+                                       placed.nodePosition(a).y - placed.nodePosition(b).y) < 1.0f;
+            }
+        }
+        CHECK(overlaps == 0);
+        CHECK(layout.nodeCount() == 0);
+        CHECK_THROWS_AS((void) placed.nodePosition(54), std::out_of_range);
+    }
+
+    SUBCASE("Pieces are drawn in their owner's color") {
+        game::Player alice("Alice"), bob("Bob");
+        alice.assignGameBoard(&board);
+        bob.assignGameBoard(&board);
+        alice.establishInitialSettlement(1);
+        alice.establishInitialPathway(2);
+        bob.establishInitialSettlement(20);
+
+        BoardLayout placed(200, 150, board.getGraph());
+        RasterImage image = rasterizer.render(BoardView(board));
+        Point settlement = placed.nodePosition(0);
+        CHECK(image.pixel((int) settlement.x, (int) settlement.y) == playerColor(0));
+        Point other = placed.nodePosition(19);
+        CHECK(image.pixel((int) other.x, (int) other.y) == playerColor(1));
+        const auto &road = placed.pathwayEnds(1);
+        CHECK(image.pixel((int) ((road[0].x + road[1].x) / 2), (int) ((road[0].y + road[1].y) / 2)) == playerColor(0));
+    }
+}
+
+TEST_CASE("Spectator wall") {
+    using namespace strategy;
+
+    SUBCASE("A triple buffer hands over the latest value") {
+        TripleBuffer<int> buffer;
+        CHECK_FALSE(buffer.update());
+        buffer.back() = 1;
+        buffer.publish();
+        buffer.back() = 2;
+        buffer.publish();
+        REQUIRE(buffer.update());
+        CHECK(buffer.front() == 2);
+        CHECK_FALSE(buffer.update());
+        CHECK(buffer.front() == 2);
+    }
+
+    SUBCASE("A feed follows the pieces and the robber") {
+        GameBoard board;
+        game::Player alice("Alice"), bob("Bob");
+        alice.assignGameBoard(&board);
+        bob.assignGameBoard(&board);
+        BoardFeed feed(board);
+        REQUIRE(feed.poll());
+        CHECK(feed.latest().robber == board.getRobber());
+        CHECK(feed.latest().numbers[0] == 11);
+        CHECK(feed.latest().buildingSeat(0) == -1);
+
+        bob.establishInitialSettlement(1);
+        bob.establishInitialPathway(2);
+        board.moveRobber(3);
+        REQUIRE(feed.poll());
+        CHECK(feed.latest().buildingSeat(0) == 1);
+        CHECK_FALSE(feed.latest().isCity(0));
+        CHECK(feed.latest().roadSeat(1) == 1);
+        CHECK(feed.latest().robber == 3);
+        CHECK(feed.latest().version == 3);
+        CHECK_FALSE(feed.poll());
+
+        BoardSnapshot captured;
+        captureSnapshot(BoardView(board), captured);
+        CHECK(captured.buildings == feed.latest().buildings);
+        CHECK(captured.roads == feed.latest().roads);
+    }
+
+    SUBCASE("Only the boards that changed are recolored") {
+        GameBoard first, second;
+        game::Player alice("Alice");
+        alice.assignGameBoard(&second);
+        BoardFeed firstFeed(first), secondFeed(second);
+        SpectatorWall wall(first.getGraph(), {&firstFeed, &secondFeed}, {1, 100.0f, 80.0f});
+        CHECK(wall.vertices().size() == 2 * SpectatorWall::VERTICES_PER_TILE);
+        CHECK(wall.width() == 100.0f);
+        CHECK(wall.height() == 160.0f);
+        CHECK(wall.refresh() == std::vector<std::size_t>{0, 1});
+        CHECK(wall.refresh().empty());
+
+        alice.establishInitialSettlement(5);
+        CHECK(wall.refresh() == std::vector<std::size_t>{1});
+        const std::size_t settlement = SpectatorWall::TERRAIN_VERTICES + SpectatorWall::ROBBER_VERTICES
+                                       + SpectatorWall::ROAD_VERTICES + 4 * 18;
+        CHECK(wall.tile(1)[settlement].color == playerColor(0));
+        CHECK(wall.tile(0)[settlement].color.a == 0);
+        CHECK(wall.tile(1)[settlement].position.y >= 80.0f);
+        CHECK(wall.tile(0)[0].color == resourceColor(first.locateTerrain(0)->getResourceType()));
+        CHECK_THROWS_AS((void) wall.tile(2), std::out_of_range);
+    }
+
+    SUBCASE("Live games are watched without locks") {
+        game::setGameLogEnabled(false);
+        constexpr std::size_t GAMES = 4;
+        std::vector<std::unique_ptr<GameSimulator>> games;
+        std::vector<std::unique_ptr<BoardFeed>> feeds;
+        std::vector<BoardFeed *> wallFeeds;
+        for (std::size_t g = 0; g < GAMES; ++g) {
+            games.push_back(std::make_unique<GameSimulator>(100 + g));
+            feeds.push_back(std::make_unique<BoardFeed>(games[g]->getBoard()));
+            wallFeeds.push_back(feeds[g].get());
+        }
+        SpectatorWall wall(games[0]->getBoard().getGraph(), wallFeeds);
+
+        std::atomic<std::size_t> finished{0};
+        std::vector<std::thread> threads;
+        for (std::size_t g = 0; g < GAMES; ++g) {
+            threads.emplace_back([&, g]() {
+                games[g]->play(200);
+                finished++;
+            });
+        }
+        std::size_t frames = 0;
+        while (finished < GAMES) {
+            wall.refresh();
+            frames++;
+        }
+        for (std::thread &thread : threads) {
+            thread.join();
+        }
+        wall.refresh();
+        CHECK(frames > 0);
+        for (std::size_t g = 0; g < GAMES; ++g) {
+            BoardSnapshot captured;
+            captureSnapshot(BoardView(games[g]->getBoard()), captured);
+            CHECK(feeds[g]->latest().buildings == captured.buildings);
+            CHECK(feeds[g]->latest().roads == captured.roads);
+            CHECK(feeds[g]->latest().robber == captured.robber);
+        }
+        game::setGameLogEnabled(true);
+    }
+}
+
+TEST_CASE("Match server") {
+    using namespace strategy;
+
+    SUBCASE("Messages survive a round trip") {
+        std::vector<Message> sent(5);
+        sent[0].type = MessageType::Build;
+        sent[0].build = BuildKind::City;
+        sent[0].id = 41;
+        sent[1].type = MessageType::Seated;
+        sent[1].match = 70000;
+        sent[1].seat = 2;
+        sent[2].type = MessageType::Diff;
+        sent[2].actions.resize(2);
+        sent[2].actions[0].type = ActionType::Roll;
+        sent[2].actions[0].seat = 1;
+        sent[2].actions[0].value = 6;
+        sent[2].actions[0].extra = 1;
+        sent[2].actions[1].type = ActionType::BuildSettlement;
+        sent[2].actions[1].seat = 1;
+        sent[2].actions[1].value = 23;
+        sent[3].type = MessageType::Rejected;
+        sent[3].reason = RejectReason::NotYourTurn;
+        sent[4].type = MessageType::GameOver;
+        sent[4].turn = 57;
+
+        std::vector<std::uint8_t> bytes;
+        for (const Message &message : sent) {
+            encodeMessage(bytes, message);
+        }
+        std::span<const std::uint8_t> rest(bytes);
+        Message received;
+        CHECK(decodeMessage(rest.first(3), received) == 0);
+        for (const Message &message : sent) {
+            const std::size_t length = decodeMessage(rest, received);
+            REQUIRE(length > 0);
+            rest = rest.subspan(length);
+            CHECK(received.type == message.type);
+        }
+        CHECK(rest.empty());
+        CHECK(decodeMessage(bytes, received) > 0);
+        CHECK(received.build == BuildKind::City);
+        CHECK(received.id == 41);
+
+        std::vector<std::uint8_t> diff;
+        encodeMessage(diff, sent[2]);
+        REQUIRE(decodeMessage(diff, received) == diff.size());
+        REQUIRE(received.actions.size() == 2);
+        CHECK(received.actions[0].value == 6);
+        CHECK(received.actions[0].extra == 1);
+        CHECK(received.actions[1].value == 23);
+        CHECK(received.actions[1].give == game::Player::SETTLEMENT_COST);
+
+        std::vector<std::uint8_t> over;
+        encodeMessage(over, sent[4]);
+        decodeMessage(over, received);
+        CHECK(received.winner == -1);
+        CHECK(received.turn == 57);
+
+        const std::vector<std::uint8_t> oversized = {0xFF, 0xFF, 1};
+        CHECK_THROWS_AS(decodeMessage(oversized, received), ProtocolError);
+        const std::vector<std::uint8_t> unknown = {1, 0, 42};
+        CHECK_THROWS_AS(decodeMessage(unknown, received), ProtocolError);
+        const std::vector<std::uint8_t> trailing = {2, 0, static_cast<std::uint8_t>(MessageType::Roll), 0};
+        CHECK_THROWS_AS(decodeMessage(trailing, received), ProtocolError);
+        CHECK_THROWS_AS(encodeDiff(diff, std::vector<GameAction>(Message::MAX_DIFF_ACTIONS + 1)), std::invalid_argument);
+    }
+
+    SUBCASE("Bots play every match to its end") {
+        game::setGameLogEnabled(false);
+        ServerOptions options;
+        options.threadCount = 2;
+        options.maxTurns = 30;
+        SwarmOptions swarmOptions;
+        swarmOptions.connections = 12;
+
+        SUBCASE("over a Unix socket") {
+            options.endpoint.unixPath = "/tmp/catan-test-" + std::to_string(::getpid()) + ".sock";
+        }
+        SUBCASE("over TCP") {
+            options.pinThreads = false;
+        }
+        MatchServer server(options);
+        server.start();
+        swarmOptions.endpoint = options.endpoint;
+        swarmOptions.endpoint.port = server.port();
+        CHECK((server.port() != 0) == options.endpoint.unixPath.empty());
+
+        const SwarmStats stats = BotSwarm(swarmOptions).run();
+        CHECK(stats.connected == 12);
+        CHECK(stats.finished == 12);
+        CHECK(stats.dropped == 0);
+        CHECK(stats.turns > 0);
+        CHECK(stats.turns <= 4 * (std::size_t) options.maxTurns);
+        CHECK(stats.actions > 0);
+        CHECK(stats.rejected > 0);
+
+        server.stop();
+        const ServerStats served = server.stats();
+        CHECK(served.connections == 12);
+        CHECK(served.matchesStarted == 4);
+        CHECK(served.matchesFinished == 4);
+        CHECK(served.matchesAborted == 0);
+        CHECK(served.rejected == stats.rejected);
+        game::setGameLogEnabled(true);
+    }
+}
+
+namespace {
+
+    // Stands in for a client over the network: every decision waits for deliver()
+    struct WaitingAgent : strategy::PlayerAgent {
+        game::Player *player = nullptr;
+        int turn = 0;
+        int asked = 0;
+
+        std::optional<strategy::Move> decide(game::Player &onTurn, int turnNumber) override {
+            player = &onTurn;
+            turn = turnNumber;
+            asked++;
+            return std::nullopt;
+        }
+    };
+
+} // namespace
+
+TEST_CASE("Coroutine turn driver") {
+    using namespace strategy;
+    game::setGameLogEnabled(false);
+    constexpr int maxTurns = 120;
+
+    SUBCASE("Bots deciding at once never suspend the game") {
+        GameSimulator simulator(5);
+        simulator.playSetup();
+        GreedyAgent bot(BoardView(simulator.getBoard()));
+        GameTask task = simulator.getOperator().playTurns({&bot, &bot, &bot}, maxTurns);
+        REQUIRE(task.done());
+        const SimulationResult result = task.result();
+        CHECK(result.turns > 0);
+        CHECK(result.turns <= maxTurns);
+        if (result.winnerSeat >= 0) {
+            CHECK(simulator.getPlayer(result.winnerSeat).calculateScore() >= GameOperator::WINNING_SCORE);
+        }
+    }
+
+    SUBCASE("One thread multiplexes games waiting on slow players") {
+        constexpr int games = 50;
+        std::vector<std::unique_ptr<GameSimulator>> simulators;
+        std::vector<std::unique_ptr<GreedyAgent>> bots;
+        std::vector<WaitingAgent> remotes(games);
+        std::vector<GameTask> tasks;
+        for (int g = 0; g < games; ++g) {
+            simulators.push_back(std::make_unique<GameSimulator>(100 + g));
+            simulators.back()->playSetup();
+            bots.push_back(std::make_unique<GreedyAgent>(BoardView(simulators.back()->getBoard())));
+            GreedyAgent *bot = bots.back().get();
+            tasks.push_back(simulators.back()->getOperator().playTurns({&remotes[g], bot, bot}, maxTurns));
+        }
+
+        // The slow player of each game answers in turn, as its moves arrive
+        for (bool waiting = true; waiting;) {
+            waiting = false;
+            for (int g = 0; g < games; ++g) {
+                if (remotes[g].waiting()) {
+                    waiting = true;
+                    CHECK(!tasks[g].done());
+                    remotes[g].deliver(*bots[g]->decide(*remotes[g].player, remotes[g].turn));
+                }
+            }
+        }
+
+        int suspensions = 0;
+        for (int g = 0; g < games; ++g) {
+            REQUIRE(tasks[g].done());
+            suspensions += remotes[g].asked;
+
+            GameSimulator alone(100 + g);
+            alone.playSetup();
+            GreedyAgent bot(BoardView(alone.getBoard()));
+            GameTask same = alone.getOperator().playTurns({&bot, &bot, &bot}, maxTurns);
+            CHECK(tasks[g].result().winnerSeat == same.result().winnerSeat);
+            CHECK(tasks[g].result().turns == same.result().turns);
+        }
+        CHECK(suspensions > games);
+    }
+
+    SUBCASE("Bots and the simulator share the greedy rule") {
+        GameSimulator simulator(9);
+        simulator.playSetup();
+        GreedyAgent bot(BoardView(simulator.getBoard()));
+        game::Player &player = simulator.getPlayer(0);
+        player.restoreCards(ResourceCounts{{5, 0, 5, 0, 0}}, {}, 2);
+        const Move expected = greedyMove(BoardView(simulator.getBoard()), player);
+        const Move decided = *bot.decide(player, 1);
+        CHECK(decided.type == expected.type);
+        CHECK(decided.id == expected.id);
+        CHECK(decided.target == expected.target);
+
+        // A score past the target still wins
+        CHECK(simulator.getOperator().declareWinner() == 0);
+        player.restoreCards(ResourceCounts{}, {}, GameOperator::WINNING_SCORE + 1);
+        CHECK(simulator.getOperator().declareWinner() == 1);
+    }
+
+    SUBCASE("Misuse is reported") {
+        GameSimulator simulator(7);
+        simulator.playSetup();
+        GreedyAgent bot(BoardView(simulator.getBoard()));
+        WaitingAgent remote;
+        CHECK_THROWS_AS(remote.deliver(Move{}), std::logic_error);
+        CHECK_THROWS_AS(simulator.getOperator().playTurns({&bot, &bot}, maxTurns), std::invalid_argument);
+        CHECK_THROWS_AS(simulator.getOperator().playTurns({&bot, nullptr, &bot}, maxTurns), std::invalid_argument);
+
+        {
+            GameTask task = simulator.getOperator().playTurns({&remote, &bot, &bot}, maxTurns);
+            REQUIRE(remote.waiting());
+            CHECK_THROWS_AS(static_cast<void>(task.result()), std::logic_error);
+        }
+        CHECK(!remote.waiting());
+        CHECK_THROWS_AS(remote.deliver(Move{}), std::logic_error);
+    }
+    game::setGameLogEnabled(true);
+}
+
+TEST_CASE("State deltas") {
+    using namespace strategy;
+
+    SUBCASE("Random changes survive a round trip") {
+        std::mt19937 rng(2024);
+        auto pick = [&rng](int low, int high) { return std::uniform_int_distribution<int>(low, high)(rng); };
+        auto changeOne = [&](GameState &state) {
+            const auto seat = static_cast<std::size_t>(pick(0, GameState::MAX_SEATS - 1));
+            switch (pick(0, 4)) {
+                case 0: {
+                    const int owner = pick(0, GameState::MAX_SEATS);
+                    const bool city = owner > 0 && pick(0, 1);
+                    state.board.buildings[pick(0, BoardGraph::MAX_NODES - 1)] = static_cast<std::uint8_t>(owner | (city ? BoardSnapshot::CITY : 0));
+                    break;
+                }
+                case 1:
+                    state.board.roads[pick(0, BoardGraph::MAX_PATHWAYS - 1)] = static_cast<std::uint8_t>(pick(0, GameState::MAX_SEATS));
+                    break;
+                case 2:
+                    state.board.robber = static_cast<std::int8_t>(pick(-1, BoardGraph::MAX_TERRAINS - 1));
+                    break;
+                case 3:
+                    state.hands[seat][pick(0, RESOURCE_TYPE_COUNT - 1)] = pick(0, 3) ? pick(0, 20) : pick(INT_MIN, INT_MAX);
+                    break;
+                default:
+                    state.devCards[seat][pick(0, game::DEV_CARD_TYPE_COUNT - 1)] = static_cast<std::uint8_t>(pick(0, 255));
+                    break;
+            }
+        };
+
+        GameState initial;
+        for (int i = 0; i < 200; ++i) {
+            changeOne(initial);
+        }
+        std::vector<GameState> expected{initial};
+        std::vector<std::uint8_t> stream;
+        for (int step = 0; step < 3000; ++step) {
+            GameState next = expected.back();
+            const int changes = pick(0, 9) ? pick(0, 4) : pick(0, 400);
+            for (int c = 0; c < changes; ++c) {
+                changeOne(next);
+            }
+            encodeDelta(expected.back(), next, stream);
+            expected.push_back(next);
+        }
+
+        GameState state = initial;
+        const std::uint8_t *pos = stream.data();
+        const std::uint8_t *end = stream.data() + stream.size();
+        for (std::size_t step = 1; step < expected.size(); ++step) {
+            const std::uint8_t *record = pos;
+            REQUIRE(applyDelta(pos, end, state));
+            REQUIRE(state == expected[step]);
+
+            // Every cut of the record is refused without touching the state
+            if (step % 50 == 0) {
+                for (const std::uint8_t *cut = record; cut < pos; ++cut) {
+                    const std::uint8_t *at = record;
+                    GameState untouched = expected[step - 1];
+                    CHECK_FALSE(applyDelta(at, cut, untouched));
+                    CHECK(at == record);
+                    CHECK(untouched == expected[step - 1]);
+                }
+            }
+        }
+        CHECK(pos == end);
+    }
+
+    SUBCASE("Records are small and checked") {
+        GameState before;
+        GameState after = before;
+        std::vector<std::uint8_t> bytes;
+        CHECK(encodeDelta(before, after, bytes) == 3);
+        after.board.buildings[7] = 2;
+        after.hands[1][ResourceType::Brick] -= 1;
+        after.hands[1][ResourceType::Lumber] -= 1;
+        bytes.clear();
+        CHECK(encodeDelta(before, after, bytes) == 7);
+
+        const std::uint8_t *pos = bytes.data();
+        GameState state = before;
+        REQUIRE(applyDelta(pos, bytes.data() + bytes.size(), state));
+        CHECK(state == after);
+
+        const std::vector<std::uint8_t> robberOffBoard = {0xFF, 0, 0};
+        pos = robberOffBoard.data();
+        CHECK_FALSE(applyDelta(pos, pos + robberOffBoard.size(), state));
+        const std::vector<std::uint8_t> dirtyPadding = {0, 0, 0xC0};
+        pos = dirtyPadding.data();
+        CHECK_FALSE(applyDelta(pos, pos + dirtyPadding.size(), state));
+        CHECK(state == after);
+    }
+
+    SUBCASE("A client following the deltas of a game sees the final state") {
+        game::setGameLogEnabled(false);
+        GameSimulator simulator(11);
+        std::size_t records = 0;
+        GameState initial, final;
+        std::vector<std::uint8_t> bytes;
+        {
+            DeltaStream stream(simulator.getBoard());
+            simulator.play(200);
+            stream.append();
+            bytes.assign(stream.bytes().begin(), stream.bytes().end());
+            initial = stream.initial();
+            final = stream.state();
+        }
+        game::setGameLogEnabled(true);
+
+        GameState state = initial;
+        const std::uint8_t *pos = bytes.data();
+        while (pos < bytes.data() + bytes.size()) {
+            REQUIRE(applyDelta(pos, bytes.data() + bytes.size(), state));
+            records++;
+        }
+        CHECK(records > 100);
+        CHECK(state == final);
+
+        std::vector<game::Player *> players;
+        for (int seat = 0; seat < 3; ++seat) {
+            players.push_back(&simulator.getPlayer(seat));
+        }
+        GameState captured;
+        captureState(BoardView(simulator.getBoard()), players, captured);
+        CHECK(state == captured);
+        CHECK(bytes.size() < records * 8);
+    }
+}
+
+TEST_CASE("Game snapshots") {
+    using namespace strategy;
+    // Turn logging back on even if a subcase throws, so later test cases still log
+    struct QuietLog {
+        QuietLog() { game::setGameLogEnabled(false); }
+        ~QuietLog() { game::setGameLogEnabled(true); }
+    } quiet;
+
+    GameSimulator original(11);
+    original.playSetup();
+    for (int turn = 0; turn < 30; ++turn) {
+        original.playTurn();
+    }
+    GameSnapshot saved;
+    original.checkpoint(saved);
+    CHECK(saved.seed == 11);
+    CHECK(saved.turn == 30);
+    CHECK(saved.seatCount == 3);
+    CHECK(std::string(saved.names[1].data()) == "Bot 2");
+
+    SUBCASE("A restored game captures the same snapshot and plays on") {
+        const std::string path = "catan_test_snapshot.bin";
+        writeSnapshot(path, saved);
+        {
+            GameSnapshotReader reader(path);
+            GameSimulator restored(11);
+            restored.restore(reader.snapshot());
+
+            GameSnapshot again;
+            restored.checkpoint(again);
+            CHECK(std::memcmp(&again, &saved, sizeof(GameSnapshot)) == 0);
+            for (int seat = 0; seat < 3; ++seat) {
+                CHECK(restored.getPlayer(seat).getResources() == original.getPlayer(seat).getResources());
+                CHECK(restored.getPlayer(seat).isTurnActive() == original.getPlayer(seat).isTurnActive());
+            }
+            CHECK(restored.getBoard().getRobber() == original.getBoard().getRobber());
+            CHECK_THROWS_AS(restored.restore(reader.snapshot()), std::invalid_argument);
+
+            SimulationResult result = restored.play(400);
+            CHECK(result.turns > 30);
+        }
+        std::remove(path.c_str());
+    }
+
+    SUBCASE("Damaged images are rejected") {
+        std::vector<GameSnapshot> buffer(2);
+        auto *bytes = reinterpret_cast<std::uint8_t *>(buffer.data());
+        std::memcpy(bytes, &saved, sizeof(GameSnapshot));
+        CHECK(&viewSnapshot({bytes, sizeof(GameSnapshot)}) == buffer.data());
+        CHECK_THROWS_AS(viewSnapshot({bytes, sizeof(GameSnapshot) - 1}), std::runtime_error);
+        CHECK_THROWS_AS(viewSnapshot({bytes, sizeof(GameSnapshot) + 1}), std::runtime_error);
+
+        bytes[sizeof(GameSnapshot) / 2] ^= 0x10;
+        CHECK_THROWS_AS(viewSnapshot({bytes, sizeof(GameSnapshot)}), std::runtime_error);
+        bytes[sizeof(GameSnapshot) / 2] ^= 0x10;
+
+        buffer[0].version = GameSnapshot::FORMAT_VERSION + 1;
+        CHECK_THROWS_AS(viewSnapshot({bytes, sizeof(GameSnapshot)}), std::runtime_error);
+        buffer[0].version = GameSnapshot::FORMAT_VERSION;
+
+        std::memmove(bytes + 4, bytes, sizeof(GameSnapshot));
+        CHECK_THROWS_AS(viewSnapshot({bytes + 4, sizeof(GameSnapshot)}), std::runtime_error);
+    }
+
+    SUBCASE("Only a fresh board with the same seats takes a snapshot") {
+        GameSimulator playing(11);
+        playing.playSetup();
+        CHECK_THROWS_AS(restoreGame(saved, playing.getBoard()), std::invalid_argument);
+
+        GameBoard empty;
+        CHECK_THROWS_AS(restoreGame(saved, empty), std::invalid_argument);
+    }
+
+    SUBCASE("Development cards beyond a new deck are rejected") {
+        GameSimulator extra(11);
+        std::array<std::uint8_t, game::DEV_CARD_TYPE_COUNT> deck = game::DEV_CARD_DECK;
+        deck[static_cast<std::size_t>(game::DevCardType::Knight)]++;
+        extra.getBoard().restoreDeck(deck);
+        GameSnapshot tampered;
+        extra.checkpoint(tampered);
+        CHECK_THROWS_AS(viewSnapshot({reinterpret_cast<const std::uint8_t *>(&tampered), sizeof(GameSnapshot)}),
+                        std::runtime_error);
+    }
+
+    SUBCASE("A snapshot is restored only with its own seed") {
+        GameSimulator other(12);
+        CHECK_THROWS_AS(other.restore(saved), std::invalid_argument);
+    }
+
+    SUBCASE("A snapshot taken before the setup leaves the setup to play") {
+        GameSimulator fresh(11);
+        GameSnapshot empty;
+        fresh.checkpoint(empty);
+
+        GameSimulator restored(11);
+        restored.restore(empty);
+        SimulationResult result = restored.play(5);
+        CHECK(result.turns == 5);
+        int settlements = 0;
+        for (const Node *node : BoardView(restored.getBoard()).nodes()) {
+            settlements += node->isOccupied();
+        }
+        CHECK(settlements >= 6);
+    }
+
+    SUBCASE("A game resumed past its setup is not recorded") {
+        const std::string path = "catan_test_snapshot_record.bin";
+        std::remove(path.c_str());
+        {
+            GameRecordWriter writer(path);
+            GameSimulator restored(11);
+            restored.restore(saved);
+            restored.setRecorder(&writer);
+            CHECK_THROWS_AS(restored.play(40), std::logic_error);
+
+            GameSimulator setUp(11);
+            setUp.playSetup();
+            setUp.setRecorder(&writer);
+            CHECK_THROWS_AS(setUp.play(40), std::logic_error);
+        }
+        std::remove(path.c_str());
+    }
+}
+
+TEST_CASE("Benchmark comparison") {
+    using namespace strategy;
+
+    SUBCASE("Critical values follow alpha") {
+        CHECK(criticalValue(0.05, 1e6) == doctest::Approx(1.960).epsilon(0.001));
+        CHECK(criticalValue(0.01, 1e6) == doctest::Approx(2.576).epsilon(0.001));
+        CHECK(criticalValue(0.05, 10) == doctest::Approx(2.228).epsilon(0.001));
+        CHECK(twoSidedPValue(2.228, 10) == doctest::Approx(0.05).epsilon(0.01));
+    }
+
+    const std::vector<double> baseline = {100, 101, 99, 100, 102, 98};
+
+    SUBCASE("Verdicts") {
+        CHECK(compareBenchmarks(baseline, {110, 111, 109, 110, 112, 108}, 0.05, 0.05).verdict == BenchVerdict::Slower);
+        CHECK(compareBenchmarks(baseline, {90, 91, 89, 90, 92, 88}, 0.05, 0.05).verdict == BenchVerdict::Faster);
+        CHECK(compareBenchmarks(baseline, {101, 100, 99, 102, 98, 100}, 0.05, 0.05).verdict == BenchVerdict::Same);
+        // Significant but below the threshold
+        CHECK(compareBenchmarks(baseline, {103, 104, 102, 103, 105, 101}, 0.05, 0.05).verdict == BenchVerdict::Same);
+        CHECK(compareBenchmarks(baseline, {110}, 0.05, 0.05).verdict == BenchVerdict::NeedRepetitions);
+
+        BenchComparison slower = compareBenchmarks(baseline, {110, 111, 109, 110, 112, 108}, 0.05, 0.05);
+        CHECK(slower.change == doctest::Approx(0.10));
+        CHECK(slower.low < slower.change);
+        CHECK(slower.high > slower.change);
+        CHECK(slower.p < 0.001);
+    }
+
+    SUBCASE("A smaller alpha widens the interval and can drop the verdict") {
+        const std::vector<double> candidate = {108, 104, 112, 103, 110, 106};
+        BenchComparison loose = compareBenchmarks(baseline, candidate, 0.05, 0.05);
+        BenchComparison strict = compareBenchmarks(baseline, candidate, 0.05, 0.0001);
+        CHECK(loose.p == doctest::Approx(strict.p));
+        CHECK(loose.verdict == BenchVerdict::Slower);
+        CHECK(strict.verdict == BenchVerdict::Same);
+        CHECK(strict.high - strict.low > loose.high - loose.low);
+    }
+}